@@ -29,11 +29,19 @@
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+
+#include <boost/functional/hash.hpp>
+
 #include <fstream>
 #include <json/json.h>
+#include <optional>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -70,6 +78,139 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 namespace
 {
 
+/// Adds @a _assembly and all assemblies reachable through its sub-assemblies to @a _assemblies.
+void collectAssemblies(Assembly const& _assembly, set<Assembly const*>& _assemblies)
+{
+	if (_assemblies.insert(&_assembly).second)
+		for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+			collectAssemblies(_assembly.sub(subId), _assemblies);
+}
+
+/// Runs the common subexpression eliminator on the chunk [_begin, _end) of items, starting from an
+/// empty state. The chunk has to end after the first item that breaks the analysis block, if any.
+/// @returns the optimised chunk or nullopt if it is not shorter than the original one.
+optional<AssemblyItems> eliminateCommonSubexpressions(
+	AssemblyItems::const_iterator _begin,
+	AssemblyItems::const_iterator _end,
+	bool _usesMSize
+)
+{
+	KnownState emptyState;
+	CommonSubexpressionEliminator eliminator{emptyState};
+	auto iter = eliminator.feedItems(_begin, _end, _usesMSize);
+	assertThrow(iter == _end, OptimizerException, "Invalid CSE chunk.");
+	try
+	{
+		AssemblyItems optimisedChunk = eliminator.getOptimizedItems();
+		if (optimisedChunk.size() < static_cast<size_t>(_end - _begin))
+			return optimisedChunk;
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	return nullopt;
+}
+
+/**
+ * Results of eliminateCommonSubexpressions() by the items of the chunk, so that chunks that did
+ * not change are not analysed again in later iterations of the optimiser loop. Results not used
+ * in an iteration are dropped by dropUnused() at its end.
+ * Items are only considered the same if they also agree in the properties that are copied to
+ * the optimised items, like the source location.
+ */
+class CSEChunkCache
+{
+public:
+	using Result = optional<AssemblyItems>;
+
+	/// @returns the stored result for the chunk [_begin, _end) or nullptr.
+	Result const* find(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end, bool _usesMSize)
+	{
+		auto [first, last] = m_entries.equal_range(hash(_begin, _end, _usesMSize));
+		for (auto it = first; it != last; ++it)
+			if (
+				it->second.usesMSize == _usesMSize &&
+				equal(_begin, _end, it->second.items.begin(), it->second.items.end(), identical)
+			)
+			{
+				it->second.used = true;
+				return &it->second.result;
+			}
+		return nullptr;
+	}
+
+	/// Stores @a _result for the chunk [_begin, _end).
+	/// @returns a reference to the stored result, which stays valid until the cache is destroyed.
+	Result const& insert(
+		AssemblyItems::const_iterator _begin,
+		AssemblyItems::const_iterator _end,
+		bool _usesMSize,
+		Result _result
+	)
+	{
+		return m_entries.emplace(
+			hash(_begin, _end, _usesMSize),
+			Entry{_usesMSize, AssemblyItems(_begin, _end), move(_result), true}
+		)->second.result;
+	}
+
+	/// Removes the results that were neither found nor inserted since the last call.
+	void dropUnused()
+	{
+		for (auto it = m_entries.begin(); it != m_entries.end();)
+			if (it->second.used)
+			{
+				it->second.used = false;
+				++it;
+			}
+			else
+				it = m_entries.erase(it);
+	}
+
+private:
+	struct Entry
+	{
+		bool usesMSize;
+		AssemblyItems items;
+		Result result;
+		bool used;
+	};
+
+	static size_t hash(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end, bool _usesMSize)
+	{
+		size_t seed = _usesMSize;
+		for (auto it = _begin; it != _end; ++it)
+		{
+			boost::hash_combine(seed, static_cast<unsigned>(it->type()));
+			if (it->type() == Operation)
+				boost::hash_combine(seed, static_cast<unsigned>(it->instruction()));
+			else
+				boost::hash_combine(seed, static_cast<uint64_t>(it->data() & u256(numeric_limits<uint64_t>::max())));
+			boost::hash_combine(seed, it->location().start);
+			boost::hash_combine(seed, it->location().end);
+		}
+		return seed;
+	}
+
+	static bool identical(AssemblyItem const& _a, AssemblyItem const& _b)
+	{
+		return
+			_a == _b &&
+			_a.location() == _b.location() &&
+			_a.getJumpType() == _b.getJumpType() &&
+			_a.m_modifierDepth == _b.m_modifierDepth;
+	}
+
+	unordered_multimap<size_t, Entry> m_entries;
+};
+
 string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
 {
 	if (!_location.hasText() || _sourceCodes.empty())
@@ -80,15 +221,16 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 		return "";
 
 	string const& source = it->second;
-	if (static_cast<size_t>(_location.start) >= source.size())
+	size_t start = static_cast<size_t>(_location.start);
+	if (start >= source.size())
 		return "";
 
-	string cut = source.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
-	auto newLinePos = cut.find_first_of("\n");
-	if (newLinePos != string::npos)
-		cut = cut.substr(0, newLinePos) + "...";
-
-	return cut;
+	// Only the first line is printed, so do not copy the rest of locations spanning whole functions or contracts.
+	size_t end = min(static_cast<size_t>(_location.end), source.size());
+	auto const begin = source.begin() + static_cast<ptrdiff_t>(start);
+	auto const stop = source.begin() + static_cast<ptrdiff_t>(end);
+	auto const newLine = find(begin, stop, '\n');
+	return string(begin, newLine) + (newLine != stop ? "..." : "");
 }
 
 class Functionalizer
@@ -392,30 +534,78 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
-	optimiseInternal(_settings, {});
+	util::Profiler::Phase phase{"evmAssemblyOptimizer"};
+	map<string, size_t> appliedPeepholeRules;
+	optimiseInternal(_settings, {}, appliedPeepholeRules);
+	for (auto const& [rule, count]: appliedPeepholeRules)
+		util::Profiler::count("evmAssemblyOptimizer/peephole/", rule, count);
 	return *this;
 }
 
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+	std::set<size_t> _tagsReferencedFromOutside,
+	map<string, size_t>& _appliedPeepholeRules
 )
 {
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	vector<map<string, size_t>> subAppliedPeepholeRules(m_subs.size());
+	auto optimiseSub = [&](size_t _subId) {
+		subTagReplacements[_subId] = m_subs[_subId]->optimiseInternal(
+			subSettings,
+			JumpdestRemover::referencedTags(m_items, _subId),
+			subAppliedPeepholeRules[_subId]
+		);
+	};
+	// Sub-assemblies that share an assembly with another one (a contract created by both the
+	// creation and the runtime code, for example) are optimised in order after the others,
+	// which are independent and thus can be optimised concurrently.
+	vector<size_t> independentSubs;
+	vector<size_t> dependentSubs;
+	if (_settings.threads > 1 && m_subs.size() > 1)
+	{
+		vector<set<Assembly const*>> reachable(m_subs.size());
+		map<Assembly const*, size_t> reachingSubs;
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		{
+			collectAssemblies(*m_subs[subId], reachable[subId]);
+			for (Assembly const* assembly: reachable[subId])
+				reachingSubs[assembly]++;
+		}
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			if (all_of(
+				reachable[subId].begin(),
+				reachable[subId].end(),
+				[&](Assembly const* _assembly) { return reachingSubs[_assembly] == 1; }
+			))
+				independentSubs.push_back(subId);
+			else
+				dependentSubs.push_back(subId);
+	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			dependentSubs.push_back(subId);
+
+	util::parallelFor(independentSubs.size(), _settings.threads, [&](size_t _index) {
+		optimiseSub(independentSubs[_index]);
+	});
+	for (size_t subId: dependentSubs)
+		optimiseSub(subId);
+	// Apply the replacements (can be empty). They only affect tags of the respective sub-assembly,
+	// so the tags referenced from here are the same as if they had been applied one by one.
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
+		for (auto const& [rule, count]: subAppliedPeepholeRules[subId])
+			_appliedPeepholeRules[rule] += count;
 	}
 
 	map<u256, u256> tagReplacements;
+	CSEChunkCache cseCache;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
@@ -436,6 +626,8 @@ map<u256, u256> Assembly::optimiseInternal(
 				count++;
 				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
 			}
+			for (auto const& [rule, ruleCount]: peepOpt.appliedRules())
+				_appliedPeepholeRules[rule] += ruleCount;
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
@@ -469,48 +661,52 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
+			// The chunks are analysed independently of each other, so the ones not seen before
+			// can be analysed concurrently.
+			vector<pair<AssemblyItems::const_iterator, AssemblyItems::const_iterator>> chunks;
+			for (auto iter = m_items.cbegin(); iter != m_items.cend();)
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
-				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
-				}
+				auto chunkBegin = iter;
+				while (iter != m_items.cend() && !SemanticInformation::breaksCSEAnalysisBlock(*iter, usesMSize))
+					++iter;
+				if (iter != m_items.cend())
+					++iter;
+				chunks.emplace_back(chunkBegin, iter);
+			}
+
+			vector<CSEChunkCache::Result const*> results(chunks.size(), nullptr);
+			vector<size_t> newChunks;
+			for (size_t i = 0; i < chunks.size(); ++i)
+				if (!(results[i] = cseCache.find(chunks[i].first, chunks[i].second, usesMSize)))
+					newChunks.push_back(i);
+			vector<CSEChunkCache::Result> newResults(newChunks.size());
+			util::parallelFor(newChunks.size(), _settings.threads, [&](size_t _index) {
+				auto const& [begin, end] = chunks[newChunks[_index]];
+				newResults[_index] = eliminateCommonSubexpressions(begin, end, usesMSize);
+			});
+			for (size_t i = 0; i < newChunks.size(); ++i)
+			{
+				auto const& [begin, end] = chunks[newChunks[i]];
+				results[newChunks[i]] = &cseCache.insert(begin, end, usesMSize, move(newResults[i]));
+			}
 
-				if (shouldReplace)
+			AssemblyItems optimisedItems;
+			for (size_t i = 0; i < chunks.size(); ++i)
+				if (*results[i])
 				{
 					count++;
-					optimisedItems += optimisedChunk;
+					optimisedItems += **results[i];
 				}
 				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
+					copy(chunks[i].first, chunks[i].second, back_inserter(optimisedItems));
 			if (optimisedItems.size() < m_items.size())
 			{
 				m_items = move(optimisedItems);
 				count++;
 			}
+			cseCache.dropUnused();
 		}
 	}
 
@@ -115,6 +115,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximal number of threads used to optimise independent sub-assemblies concurrently.
+		/// Does not influence the result.
+		size_t threads = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -152,8 +155,13 @@ public:
 protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
-	/// that are referenced in a super-assembly.
-	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// that are referenced in a super-assembly. Adds the number of times each peephole rule was
+	/// applied in this assembly and its subs to @a _appliedPeepholeRules.
+	std::map<u256, u256> optimiseInternal(
+		OptimiserSettings const& _settings,
+		std::set<size_t> _tagsReferencedFromOutside,
+		std::map<std::string, size_t>& _appliedPeepholeRules
+	);
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
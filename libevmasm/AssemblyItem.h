@@ -28,6 +28,8 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <sstream>
 
 namespace solidity::evmasm
@@ -57,7 +59,7 @@ using AssemblyItems = std::vector<AssemblyItem>;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -73,7 +75,7 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setDataValue(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -92,8 +94,12 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); setDataValue(_data); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -105,6 +111,8 @@ public:
 			return false;
 		if (type() == Operation)
 			return instruction() == _other.instruction();
+		else if (!m_largeData && !_other.m_largeData)
+			return m_smallData == _other.m_smallData;
 		else
 			return data() == _other.data();
 	}
@@ -116,6 +124,8 @@ public:
 			return type() < _other.type();
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
+		else if (!m_largeData && !_other.m_largeData)
+			return m_smallData < _other.m_smallData;
 		else
 			return data() < _other.data();
 	}
@@ -159,11 +169,26 @@ public:
 	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = std::make_shared<size_t>(_n); }
 
 private:
+	void setDataValue(u256 const& _data)
+	{
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+			m_largeData = std::make_shared<u256 const>(_data);
+	}
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	/// Data of items other than operations. Tags and most pushed values fit into m_smallData,
+	/// so that creating and copying these items does not allocate or update reference counts.
+	/// Larger values are stored in (and shared via) m_largeData.
+	uint64_t m_smallData = 0;
+	std::shared_ptr<u256 const> m_largeData;
+	langutil::SourceLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
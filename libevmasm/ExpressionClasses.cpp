@@ -27,6 +27,8 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
 #include <tuple>
 #include <utility>
@@ -50,9 +52,10 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 		return std::tie(instr, arguments, sequenceNumber) <
 			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
 	}
+	else if (*item != *_other.item)
+		return *item < *_other.item;
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+		return std::tie(arguments, sequenceNumber) < std::tie(_other.arguments, _other.sequenceNumber);
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -71,11 +74,12 @@ ExpressionClasses::Id ExpressionClasses::find(
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
 
+	size_t const expHash = hash(exp);
 	if (SemanticInformation::isDeterministic(_item))
 	{
-		auto it = m_expressions.find(exp);
-		if (it != m_expressions.end())
-			return it->id;
+		Id id = findIndexed(exp, expHash);
+		if (id != Id(-1))
+			return id;
 	}
 
 	if (_copyItem)
@@ -89,7 +93,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 		exp.id = m_representatives.size();
 		m_representatives.push_back(exp);
 	}
-	m_expressions.insert(exp);
+	index(exp, expHash);
 	return exp.id;
 }
 
@@ -111,7 +115,7 @@ void ExpressionClasses::forceEqual(
 	if (_copyItem)
 		exp.item = storeItem(_item);
 
-	m_expressions.insert(exp);
+	index(exp, hash(exp));
 }
 
 ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _location)
@@ -120,7 +124,7 @@ ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _locatio
 	exp.id = m_representatives.size();
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
 	m_representatives.push_back(exp);
-	m_expressions.insert(exp);
+	index(exp, hash(exp));
 	return exp.id;
 }
 
@@ -133,7 +137,7 @@ bool ExpressionClasses::knownToBeDifferent(ExpressionClasses::Id _a, ExpressionC
 bool ExpressionClasses::knownToBeDifferentBy32(ExpressionClasses::Id _a, ExpressionClasses::Id _b)
 {
 	// Try to simplify "_a - _b" and return true iff the value is at least 32 away from zero.
-	u256 const* v = knownConstant(find(Instruction::SUB, {_a, _b}));
+	optional<u256> v = knownConstant(find(Instruction::SUB, {_a, _b}));
 	// forbidden interval is ["-31", 31]
 	return v && *v + 31 > u256(62);
 }
@@ -148,14 +152,14 @@ bool ExpressionClasses::knownNonZero(Id _c)
 	return Pattern(u256(0)).matches(representative(find(Instruction::ISZERO, {_c})), *this);
 }
 
-u256 const* ExpressionClasses::knownConstant(Id _c)
+optional<u256> ExpressionClasses::knownConstant(Id _c)
 {
 	map<unsigned, Expression const*> matchGroups;
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
-		return nullptr;
-	return &constant.d();
+		return nullopt;
+	return constant.d();
 }
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
@@ -164,6 +168,75 @@ AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 	return m_spareAssemblyItems.back().get();
 }
 
+size_t ExpressionClasses::hash(Expression const& _expr)
+{
+	assertThrow(!!_expr.item, OptimizerException, "");
+	size_t seed = static_cast<size_t>(_expr.item->type());
+	if (_expr.item->type() == Operation)
+		boost::hash_combine(seed, static_cast<unsigned>(_expr.item->instruction()));
+	else
+		boost::hash_combine(seed, static_cast<uint64_t>(_expr.item->data() & u256(numeric_limits<uint64_t>::max())));
+	boost::hash_range(seed, _expr.arguments.begin(), _expr.arguments.end());
+	boost::hash_combine(seed, _expr.sequenceNumber);
+	return seed;
+}
+
+ExpressionClasses::Id ExpressionClasses::findIndexed(Expression const& _expr, size_t _hash) const
+{
+	if (m_indexSlots.empty())
+		return Id(-1);
+	size_t const mask = m_indexSlots.size() - 1;
+	for (size_t slot = _hash & mask; m_indexSlots[slot].entry; slot = (slot + 1) & mask)
+	{
+		if (m_indexSlots[slot].hash != _hash)
+			continue;
+		IndexedExpression const& indexed = m_indexedExpressions[m_indexSlots[slot].entry - 1];
+		bool matches =
+			*indexed.item == *_expr.item &&
+			indexed.sequenceNumber == _expr.sequenceNumber &&
+			equal(
+				m_indexedArguments.begin() + static_cast<ptrdiff_t>(indexed.argumentsBegin),
+				m_indexedArguments.begin() + static_cast<ptrdiff_t>(indexed.argumentsEnd),
+				_expr.arguments.begin(),
+				_expr.arguments.end()
+			);
+		if (matches)
+			return indexed.id;
+	}
+	return Id(-1);
+}
+
+void ExpressionClasses::index(Expression const& _expr, size_t _hash)
+{
+	if (findIndexed(_expr, _hash) != Id(-1))
+		return;
+
+	if (2 * (m_indexedExpressions.size() + 1) > m_indexSlots.size())
+	{
+		vector<IndexSlot> slots(max<size_t>(16, 2 * m_indexSlots.size()));
+		size_t const mask = slots.size() - 1;
+		for (IndexSlot const& oldSlot: m_indexSlots)
+			if (oldSlot.entry)
+			{
+				size_t slot = oldSlot.hash & mask;
+				while (slots[slot].entry)
+					slot = (slot + 1) & mask;
+				slots[slot] = oldSlot;
+			}
+		m_indexSlots = move(slots);
+	}
+
+	size_t const argumentsBegin = m_indexedArguments.size();
+	m_indexedArguments += _expr.arguments;
+	m_indexedExpressions.push_back({_expr.item, _expr.sequenceNumber, _expr.id, argumentsBegin, m_indexedArguments.size()});
+
+	size_t const mask = m_indexSlots.size() - 1;
+	size_t slot = _hash & mask;
+	while (m_indexSlots[slot].entry)
+		slot = (slot + 1) & mask;
+	m_indexSlots[slot] = IndexSlot{_hash, m_indexedExpressions.size()};
+}
+
 string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 {
 	Expression const& expr = representative(_id);
@@ -183,7 +256,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rule list is only built once, the state of the current match is stored per thread.
+	static Rules const rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -30,6 +30,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 namespace solidity::langutil
@@ -99,9 +100,8 @@ public:
 	/// @returns true if the value of the given class is known to be nonzero.
 	/// @note that this is not the negation of knownZero
 	bool knownNonZero(Id _c);
-	/// @returns a pointer to the value if the given class is known to be a constant,
-	/// and a nullptr otherwise.
-	u256 const* knownConstant(Id _c);
+	/// @returns the value if the given class is known to be a constant, and nullopt otherwise.
+	std::optional<u256> knownConstant(Id _c);
 
 	/// Stores a copy of the given AssemblyItem and returns a pointer to the copy that is valid for
 	/// the lifetime of the ExpressionClasses object.
@@ -119,10 +119,41 @@ private:
 
 	std::vector<std::pair<Pattern, std::function<Pattern()>>> createRules() const;
 
+	/// Expression in the index of all expressions, its arguments are
+	/// m_indexedArguments[argumentsBegin..argumentsEnd).
+	struct IndexedExpression
+	{
+		AssemblyItem const* item;
+		unsigned sequenceNumber;
+		Id id;
+		size_t argumentsBegin;
+		size_t argumentsEnd;
+	};
+	/// Slot of the open addressing hash table of indexed expressions. Refers to
+	/// m_indexedExpressions[entry - 1] or is empty if entry is zero.
+	struct IndexSlot
+	{
+		size_t hash = 0;
+		size_t entry = 0;
+	};
+
+	/// @returns a hash of the values compared by Expression::operator<.
+	static size_t hash(Expression const& _expr);
+	/// @returns the class of an indexed expression that is equal to @a _expr (in the sense of
+	/// Expression::operator<) or Id(-1) if there is none.
+	Id findIndexed(Expression const& _expr, size_t _hash) const;
+	/// Adds @a _expr to the index unless an equal expression has been indexed before.
+	void index(Expression const& _expr, size_t _hash);
+
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
-	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	/// All expressions ever encountered, in the order they were indexed.
+	std::vector<IndexedExpression> m_indexedExpressions;
+	/// Arguments of all indexed expressions.
+	Ids m_indexedArguments;
+	/// Open addressing hash table of the indexed expressions with linear probing.
+	/// Its size is zero or a power of two and it is kept at most half full.
+	std::vector<IndexSlot> m_indexSlots;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
@@ -59,6 +59,39 @@ namespace solidity::evmasm
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 
+/**
+ * Value that is shared by copies of its owner until one of them modifies it.
+ * Copies must not be modified concurrently.
+ */
+template <class T>
+class CopyOnWrite
+{
+public:
+	T const& operator*() const
+	{
+		static T const empty{};
+		return m_value ? *m_value : empty;
+	}
+	T const* operator->() const { return &**this; }
+
+	/// @returns the value for modification, copying it first if it is shared.
+	T& modify()
+	{
+		if (!m_value)
+			m_value = std::make_shared<T>();
+		else if (m_value.use_count() > 1)
+			m_value = std::make_shared<T>(*m_value);
+		return *m_value;
+	}
+	void clear() { m_value.reset(); }
+
+	bool operator==(CopyOnWrite const& _other) const { return m_value == _other.m_value || **this == *_other; }
+	bool operator!=(CopyOnWrite const& _other) const { return !(*this == _other); }
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
 /**
  * Class to infer and store knowledge about the state of the virtual machine at a specific
  * instruction.
@@ -66,6 +99,9 @@ using AssemblyItems = std::vector<AssemblyItem>;
  * The general workings are that for each assembly item that is fed, an equivalence class is
  * derived from the operation and the equivalence class of its arguments. DUPi, SWAPi and some
  * arithmetic instructions are used to infer equivalences while these classes are determined.
+ *
+ * Copies of a state share the knowledge about the stack, storage and memory until they modify it,
+ * so that copying is cheap.
  */
 class KnownState
 {
@@ -133,10 +169,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	std::map<int, Id> const& stackElements() const { return *m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& storageContent() const { return *m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -165,20 +201,20 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	CopyOnWrite<std::map<int, Id>> m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	CopyOnWrite<std::map<Id, Id>> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	CopyOnWrite<std::map<Id, Id>> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	CopyOnWrite<std::map<std::vector<Id>, Id>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	CopyOnWrite<boost::bimap<Id, std::set<u256>>> m_tagUnions;
 };
 
 }
@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -34,13 +36,6 @@ using namespace solidity::evmasm;
 namespace
 {
 
-struct OptimiserState
-{
-	AssemblyItems const& items;
-	size_t i;
-	std::back_insert_iterator<AssemblyItems> out;
-};
-
 template <class Method, size_t Arguments>
 struct ApplyRule
 {
@@ -69,57 +64,53 @@ struct ApplyRule<Method, 2>
 		return Method::applySimple(_in[0], _in[1], _out);
 	}
 };
-template <class Method>
-struct ApplyRule<Method, 1>
-{
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		return Method::applySimple(_in[0], _out);
-	}
-};
 
+/// A rule matches a window of items at the end of the items optimised so far. Besides applySimple(),
+/// which receives the items of the window, every rule defines its name and the predicate endsWith(),
+/// which only depends on the type and instruction of the last item of the window.
 template <class Method, size_t WindowSize>
 struct SimplePeepholeOptimizerMethod
 {
-	static bool apply(OptimiserState& _state)
+	/// @returns the number of items at the end of @a _items that are replaced by the items written
+	/// to @a _out or zero if the rule does not apply.
+	static size_t apply(AssemblyItems const& _items, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out)
+			_items.size() >= WindowSize &&
+			ApplyRule<Method, WindowSize>::applyRule(_items.end() - static_cast<ptrdiff_t>(WindowSize), _out)
 		)
-		{
-			_state.i += WindowSize;
-			return true;
-		}
+			return WindowSize;
 		else
-			return false;
+			return 0;
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
+/// @returns true if the item only pushes a value that is known at compile, link or deploy time.
+bool pushesValue(AssemblyItem const& _item)
 {
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
+	auto t = _item.type();
+	return
+		t == Push || t == PushString || t == PushTag || t == PushSub ||
+		t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+}
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
+	static constexpr char const* name = "PushPop";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::POP; }
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
 	{
-		auto t = _push.type();
 		return _pop == Instruction::POP && (
 			SemanticInformation::isDupInstruction(_push) ||
-			t == Push || t == PushString || t == PushTag || t == PushSub ||
-			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress
+			pushesValue(_push)
 		);
 	}
 };
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 {
+	static constexpr char const* name = "OpPop";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::POP; }
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -142,6 +133,8 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 {
+	static constexpr char const* name = "DoubleSwap";
+	static bool endsWith(AssemblyItem const& _item) { return SemanticInformation::isSwapInstruction(_item); }
 	static size_t applySimple(AssemblyItem const& _s1, AssemblyItem const& _s2, std::back_insert_iterator<AssemblyItems>)
 	{
 		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
@@ -150,6 +143,8 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 {
+	static constexpr char const* name = "DoublePush";
+	static bool endsWith(AssemblyItem const& _item) { return _item.type() == Push; }
 	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		if (_push1.type() == Push && _push2.type() == Push && _push1.data() == _push2.data())
@@ -165,6 +160,8 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 {
+	static constexpr char const* name = "CommutativeSwap";
+	static bool endsWith(AssemblyItem const& _item) { return SemanticInformation::isCommutativeOperation(_item); }
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		// Remove SWAP1 if following instruction is commutative
@@ -183,15 +180,19 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 {
+	static constexpr char const* name = "SwapComparison";
+	static inline map<Instruction, Instruction> const swappableOps{
+		{ Instruction::LT, Instruction::GT },
+		{ Instruction::GT, Instruction::LT },
+		{ Instruction::SLT, Instruction::SGT },
+		{ Instruction::SGT, Instruction::SLT }
+	};
+	static bool endsWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Operation && swappableOps.count(_item.instruction());
+	}
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
-		static map<Instruction, Instruction> const swappableOps{
-			{ Instruction::LT, Instruction::GT },
-			{ Instruction::GT, Instruction::LT },
-			{ Instruction::SLT, Instruction::SGT },
-			{ Instruction::SGT, Instruction::SLT }
-		};
-
 		if (
 			_swap == Instruction::SWAP1 &&
 			_op.type() == Operation &&
@@ -209,6 +210,8 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
 {
+	static constexpr char const* name = "DupSwap";
+	static bool endsWith(AssemblyItem const& _item) { return SemanticInformation::isSwapInstruction(_item); }
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -229,9 +232,87 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
 	}
 };
 
+/// Moves a POP in front of a value that is pushed and swapped with the element removed by the POP:
+/// PUSH x SWAP1 POP -> POP PUSH x
+struct PushSwapPop: SimplePeepholeOptimizerMethod<PushSwapPop, 3>
+{
+	static constexpr char const* name = "PushSwapPop";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::POP; }
+	static bool applySimple(
+		AssemblyItem const& _push,
+		AssemblyItem const& _swap,
+		AssemblyItem const& _pop,
+		std::back_insert_iterator<AssemblyItems> _out
+	)
+	{
+		if (pushesValue(_push) && _swap == Instruction::SWAP1 && _pop == Instruction::POP)
+		{
+			*_out = _pop;
+			*_out = _push;
+			return true;
+		}
+		else
+			return false;
+	}
+};
+
+/// Same as PushSwapPop for a duplicated stack element, which is one element closer to the top
+/// after the POP: DUPn SWAP1 POP -> POP DUP(n-1), where DUP1 SWAP1 POP does nothing at all.
+struct DupSwapPop: SimplePeepholeOptimizerMethod<DupSwapPop, 3>
+{
+	static constexpr char const* name = "DupSwapPop";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::POP; }
+	static bool applySimple(
+		AssemblyItem const& _dupN,
+		AssemblyItem const& _swap,
+		AssemblyItem const& _pop,
+		std::back_insert_iterator<AssemblyItems> _out
+	)
+	{
+		if (
+			SemanticInformation::isDupInstruction(_dupN) &&
+			_swap == Instruction::SWAP1 &&
+			_pop == Instruction::POP
+		)
+		{
+			unsigned dupNumber = getDupNumber(_dupN.instruction());
+			if (dupNumber > 1)
+			{
+				*_out = _pop;
+				*_out = {dupInstruction(dupNumber - 1), _dupN.location()};
+			}
+			return true;
+		}
+		else
+			return false;
+	}
+};
+
+/// Removes a SWAPn in front of n + 1 POPs, which remove the same stack elements without it.
+struct SwapPops
+{
+	static constexpr char const* name = "SwapPops";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::POP; }
+	static size_t apply(AssemblyItems const& _items, std::back_insert_iterator<AssemblyItems> _out)
+	{
+		// Every POP is matched as soon as it is appended, so the window ends with exactly n + 1 POPs.
+		size_t pops = 0;
+		while (pops < _items.size() && pops <= 16 && _items[_items.size() - 1 - pops] == Instruction::POP)
+			pops++;
+		if (pops == _items.size())
+			return 0;
+		AssemblyItem const& swap = _items[_items.size() - 1 - pops];
+		if (!SemanticInformation::isSwapInstruction(swap) || getSwapNumber(swap.instruction()) + 1 != pops)
+			return 0;
+		copy(_items.end() - static_cast<ptrdiff_t>(pops), _items.end(), _out);
+		return pops + 1;
+	}
+};
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 {
+	static constexpr char const* name = "IsZeroIsZeroJumpI";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::JUMPI; }
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -258,6 +339,8 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 {
+	static constexpr char const* name = "JumpToNext";
+	static bool endsWith(AssemblyItem const& _item) { return _item.type() == Tag; }
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -284,6 +367,8 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 {
+	static constexpr char const* name = "TagConjunctions";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::AND; }
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -319,6 +404,8 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 {
+	static constexpr char const* name = "TruthyAnd";
+	static bool endsWith(AssemblyItem const& _item) { return _item == Instruction::AND; }
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -335,31 +422,28 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 };
 
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
-struct UnreachableCode
+struct UnreachableCode: SimplePeepholeOptimizerMethod<UnreachableCode, 2>
 {
-	static bool apply(OptimiserState& _state)
+	static constexpr char const* name = "UnreachableCode";
+	static bool endsWith(AssemblyItem const& _item) { return _item.type() != Tag; }
+	static bool applySimple(
+		AssemblyItem const& _terminator,
+		AssemblyItem const& _unreachable,
+		std::back_insert_iterator<AssemblyItems> _out
+	)
 	{
-		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
-		auto end = _state.items.end();
-		if (it == end)
-			return false;
 		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
+			_unreachable.type() != Tag && (
+				_terminator == Instruction::JUMP ||
+				_terminator == Instruction::RETURN ||
+				_terminator == Instruction::STOP ||
+				_terminator == Instruction::INVALID ||
+				_terminator == Instruction::SELFDESTRUCT ||
+				_terminator == Instruction::REVERT
+			)
 		)
-			return false;
-
-		ptrdiff_t i = 1;
-		while (it + i != end && it[i].type() != Tag)
-			i++;
-		if (i > 1)
 		{
-			*_state.out = it[0];
-			_state.i += static_cast<size_t>(i);
+			*_out = _terminator;
 			return true;
 		}
 		else
@@ -367,17 +451,55 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+struct PeepholeRule
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+	char const* name;
+	size_t (*apply)(AssemblyItems const& _items, std::back_insert_iterator<AssemblyItems> _out);
+};
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+/// The rules indexed by the kind of item (the instruction of operations and the type of other items)
+/// their windows end with, in the order in which they are tried.
+class PeepholeRules
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
-}
+public:
+	static PeepholeRules const& get()
+	{
+		static PeepholeRules const rules{
+			PushPop(), OpPop(), SwapPops(), PushSwapPop(), DupSwapPop(), DoublePush(), DoubleSwap(),
+			CommutativeSwap(), SwapComparison(), DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(),
+			UnreachableCode(), TagConjunctions(), TruthyAnd()
+		};
+		return rules;
+	}
+
+	vector<PeepholeRule> const& endingWith(AssemblyItem const& _item) const
+	{
+		if (_item.type() == Operation)
+			return m_byInstruction[static_cast<uint8_t>(_item.instruction())];
+		else
+			return m_byType[static_cast<size_t>(_item.type())];
+	}
+
+private:
+	template <class... Methods>
+	explicit PeepholeRules(Methods...)
+	{
+		for (size_t instruction = 0; instruction < m_byInstruction.size(); ++instruction)
+			add<Methods...>(m_byInstruction[instruction], AssemblyItem(Instruction(instruction)));
+		for (size_t type = 0; type < m_byType.size(); ++type)
+			if (AssemblyItemType(type) != Operation)
+				add<Methods...>(m_byType[type], AssemblyItem(AssemblyItemType(type)));
+	}
+
+	template <class... Methods>
+	static void add(vector<PeepholeRule>& _rules, AssemblyItem const& _lastItem)
+	{
+		((Methods::endsWith(_lastItem) ? _rules.push_back({Methods::name, &Methods::apply}) : void()), ...);
+	}
+
+	array<vector<PeepholeRule>, 256> m_byInstruction;
+	array<vector<PeepholeRule>, AssignImmutable + 1> m_byType;
+};
 
 size_t numberOfPops(AssemblyItems const& _items)
 {
@@ -388,14 +510,38 @@ size_t numberOfPops(AssemblyItems const& _items)
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+	PeepholeRules const& rules = PeepholeRules::get();
+	map<string, size_t> appliedRules;
+	// The items are appended to the output one by one. Whenever the window of a rule matches
+	// the end of the output, it is removed and the replacement is appended again item by item,
+	// so that the rules it enables, also together with preceding items, are applied in the same pass.
+	// Every rule reduces the number of items other than POP or, keeping it, the code size,
+	// which guarantees termination.
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
+	AssemblyItems pending;
+	AssemblyItems replacement;
+	for (size_t i = 0; i < m_items.size() || !pending.empty();)
+	{
+		if (pending.empty())
+			m_optimisedItems.push_back(m_items[i++]);
+		else
+		{
+			m_optimisedItems.push_back(std::move(pending.back()));
+			pending.pop_back();
+		}
+		for (PeepholeRule const& rule: rules.endingWith(m_optimisedItems.back()))
+		{
+			replacement.clear();
+			if (size_t windowSize = rule.apply(m_optimisedItems, back_inserter(replacement)))
+			{
+				appliedRules[rule.name]++;
+				m_optimisedItems.erase(m_optimisedItems.end() - static_cast<ptrdiff_t>(windowSize), m_optimisedItems.end());
+				pending.insert(pending.end(), make_move_iterator(replacement.rbegin()), make_move_iterator(replacement.rend()));
+				break;
+			}
+		}
+	}
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
@@ -404,6 +550,8 @@ bool PeepholeOptimiser::optimise()
 	))
 	{
 		m_items = std::move(m_optimisedItems);
+		for (auto const& [name, count]: appliedRules)
+			m_appliedRules[name] += count;
 		return true;
 	}
 	else
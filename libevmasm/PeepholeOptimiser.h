@@ -24,6 +24,8 @@
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <map>
+#include <string>
 
 namespace solidity::evmasm
 {
@@ -44,11 +46,19 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Applies the peephole rules to the items in a single pass. The replacement of a rule is
+	/// examined again together with the items in front of it, so that further rules it enables
+	/// are applied in the same pass.
+	/// @returns true if the items were improved and thus replaced.
 	bool optimise();
 
+	/// @returns the number of times each rule was applied by the calls to optimise() that replaced the items.
+	std::map<std::string, size_t> const& appliedRules() const { return m_appliedRules; }
+
 private:
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	std::map<std::string, size_t> m_appliedRules;
 };
 
 }
@@ -41,7 +41,7 @@ using namespace solidity::langutil;
 SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
-)
+) const
 {
 	resetMatchGroups();
 
@@ -57,6 +57,12 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	return nullptr;
 }
 
+map<unsigned, Rules::Expression const*>& Rules::matchGroups()
+{
+	static thread_local map<unsigned, Expression const*> groups;
+	return groups;
+}
+
 bool Rules::isInitialized() const
 {
 	return !m_rules[uint8_t(Instruction::ADD)].empty();
@@ -85,13 +91,13 @@ Rules::Rules()
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(nullopt, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
@@ -110,15 +116,22 @@ void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _
 	m_matchGroups = &_matchGroups;
 }
 
+void Pattern::setMatchGroup(unsigned _group)
+{
+	m_matchGroup = _group;
+	m_matchGroups = nullptr;
+}
+
 bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes) const
 {
 	if (!matchesBaseItem(_expr.item))
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		auto& groups = matchGroups();
+		if (!groups.count(m_matchGroup))
+			groups[m_matchGroup] = &_expr;
+		else if (groups[m_matchGroup]->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
@@ -189,9 +202,14 @@ bool Pattern::matchesBaseItem(AssemblyItem const* _item) const
 Pattern::Expression const& Pattern::matchGroupValue() const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	auto& groups = matchGroups();
+	assertThrow(groups[m_matchGroup], OptimizerException, "");
+	return *groups[m_matchGroup];
+}
+
+map<unsigned, Pattern::Expression const*>& Pattern::matchGroups() const
+{
+	return m_matchGroups ? *m_matchGroups : Rules::matchGroups();
 }
 
 u256 const& Pattern::data() const
@@ -56,22 +56,25 @@ public:
 
 	/// @returns a pointer to the first matching pattern and sets the match
 	/// groups accordingly.
+	/// The rules themselves are not modified, so one instance can be shared by several threads.
 	SimplificationRule<Pattern> const* findFirstMatch(
 		Expression const& _expr,
 		ExpressionClasses const& _classes
-	);
+	) const;
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
 	/// by the constructor, but we had some issues with static initialization.
 	bool isInitialized() const;
 
+	/// @returns the match groups of the current match on this thread.
+	static std::map<unsigned, Expression const*>& matchGroups();
+
 private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	static void resetMatchGroups() { matchGroups().clear(); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
@@ -106,6 +109,9 @@ public:
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
 	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	/// Sets this pattern to be part of the match group with the identifier @a _group, using the
+	/// match groups of the rule list, which are stored per thread.
+	void setMatchGroup(unsigned _group);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
@@ -115,7 +121,7 @@ public:
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 const& d() const { return matchGroupValue().item->data(); }
+	u256 d() const { return matchGroupValue().item->data(); }
 
 	std::string toString() const;
 
@@ -129,6 +135,7 @@ public:
 private:
 	bool matchesBaseItem(AssemblyItem const* _item) const;
 	Expression const& matchGroupValue() const;
+	std::map<unsigned, Expression const*>& matchGroups() const;
 	u256 const& data() const;
 
 	AssemblyItemType m_type;
@@ -137,6 +144,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
+	/// Match groups to use if not the ones of the rule list.
 	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
@@ -53,10 +53,36 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// @returns @a _position limited to the size of @a _source. Negative positions are treated as
+/// past the end of the source.
+size_t clampPosition(string const& _source, int _position)
+{
+	return min<size_t>(_source.size(), static_cast<size_t>(_position));
+}
+
+/// @returns the index of the line @a _position belongs to. A newline belongs to the line it ends.
+size_t lineIndex(vector<size_t> const& _lineStarts, size_t _position)
+{
+	return static_cast<size_t>(upper_bound(_lineStarts.begin(), _lineStarts.end(), _position) - _lineStarts.begin()) - 1;
+}
+
+tuple<int, int> lineColumn(vector<size_t> const& _lineStarts, size_t _position)
+{
+	size_t line = lineIndex(_lineStarts, _position);
+	return tuple<int, int>(static_cast<int>(line), static_cast<int>(_position - _lineStarts[line]));
+}
+
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -84,19 +110,11 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	shared_ptr<vector<size_t> const> starts = lineStarts();
+	size_t lineNumber = lineIndex(*starts, clampPosition(m_source, _position));
+	size_t lineStart = (*starts)[lineNumber];
+	size_t lineEnd = lineNumber + 1 < starts->size() ? (*starts)[lineNumber + 1] - 1 : m_source.size();
+	string line = m_source.substr(lineStart, lineEnd - lineStart);
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -104,17 +122,34 @@ string CharStream::lineAtPosition(int _position) const
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	return lineColumn(*lineStarts(), clampPosition(m_source, _position));
+}
+
+vector<tuple<int, int>> CharStream::translatePositionsToLineColumns(vector<int> const& _positions) const
+{
+	shared_ptr<vector<size_t> const> starts = lineStarts();
+	vector<tuple<int, int>> result;
+	result.reserve(_positions.size());
+	for (int position: _positions)
+		result.emplace_back(lineColumn(*starts, clampPosition(m_source, position)));
+	return result;
+}
+
+shared_ptr<vector<size_t> const> CharStream::lineStarts() const
+{
+	shared_ptr<vector<size_t> const> starts = atomic_load(&m_lineStarts);
+	if (!starts)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		auto newStarts = make_shared<vector<size_t>>(1, 0);
+		for (
+			size_t newLine = m_source.find('\n');
+			newLine != string::npos;
+			newLine = m_source.find('\n', newLine + 1)
+		)
+			newStarts->push_back(newLine + 1);
+		starts = move(newStarts);
+		// Concurrent callers may build the index more than once, but all copies are equal.
+		atomic_store(&m_lineStarts, starts);
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return starts;
 }
@@ -53,9 +53,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -92,16 +94,25 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of the line starts, further calls take logarithmic time.
 	std::string lineAtPosition(int _position) const;
+	/// @returns the zero-based line and column of @a _position.
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
+	/// @returns the zero-based lines and columns of all @a _positions, in the same order.
+	std::vector<std::tuple<int, int>> translatePositionsToLineColumns(std::vector<int> const& _positions) const;
 	///@}
 
 private:
+	/// @returns the offsets at which the lines of the source start, building them on first use.
+	std::shared_ptr<std::vector<size_t> const> lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Line start offsets, see lineStarts(). Only accessed atomically, because diagnostics
+	/// referring to the same source can be formatted from several threads.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
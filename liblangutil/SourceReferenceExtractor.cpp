@@ -60,9 +60,10 @@ SourceReference SourceReferenceExtractor::extract(SourceLocation const* _locatio
 
 	shared_ptr<CharStream> const& source = _location->source;
 
-	LineColumn const interest = source->translatePositionToLineColumn(_location->start);
+	auto const positions = source->translatePositionsToLineColumns({_location->start, _location->end});
+	LineColumn const interest = positions[0];
 	LineColumn start = interest;
-	LineColumn end = source->translatePositionToLineColumn(_location->end);
+	LineColumn end = positions[1];
 	bool const isMultiline = start.line != end.line;
 
 	string line = source->lineAtPosition(_location->start);
@@ -224,10 +224,17 @@ void NameAndTypeResolver::warnVariablesNamedLikeInstructions() const
 	}
 }
 
-void NameAndTypeResolver::warnHomonymDeclarations() const
+void NameAndTypeResolver::warnHomonymDeclarations(set<SourceUnit const*> const& _sourceUnits) const
 {
+	set<DeclarationContainer const*> containers;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		containers.insert(m_scopes.at(sourceUnit).get());
+
+	// The containers of the source units are visited in the order of their creation.
 	DeclarationContainer::Homonyms homonyms;
-	m_scopes.at(nullptr)->populateHomonyms(back_inserter(homonyms));
+	for (DeclarationContainer const* container: m_scopes.at(nullptr)->innerContainers())
+		if (containers.count(container))
+			container->populateHomonyms(back_inserter(homonyms));
 
 	for (auto [innerLocation, outerDeclarations]: homonyms)
 	{
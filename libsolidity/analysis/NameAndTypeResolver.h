@@ -35,6 +35,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 
 namespace solidity::langutil
 {
@@ -95,8 +96,8 @@ public:
 	/// Generate and store warnings about variables that are named like instructions.
 	void warnVariablesNamedLikeInstructions() const;
 
-	/// Generate and store warnings about declarations with the same name.
-	void warnHomonymDeclarations() const;
+	/// Generate and store warnings about declarations with the same name inside @a _sourceUnits.
+	void warnHomonymDeclarations(std::set<SourceUnit const*> const& _sourceUnits) const;
 
 	/// @returns a list of similar identifiers in the current and enclosing scopes. May return empty string if no suggestions.
 	std::string similarNameSuggestions(ASTString const& _name) const;
@@ -126,7 +126,10 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	friend class Parser;
+
+	/// Only changed by the parser, before the ID is used anywhere.
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
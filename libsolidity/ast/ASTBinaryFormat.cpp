@@ -0,0 +1,1812 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of the ASTs of a set of source units.
+ */
+
+#include <libsolidity/ast/ASTBinaryFormat.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace
+{
+
+string const magic{"\0solAST", 7};
+
+enum class NodeKind: uint8_t
+{
+	SourceUnit,
+	PragmaDirective,
+	ImportDirective,
+	StructuredDocumentation,
+	ContractDefinition,
+	InheritanceSpecifier,
+	UsingForDirective,
+	StructDefinition,
+	EnumDefinition,
+	EnumValue,
+	ParameterList,
+	OverrideSpecifier,
+	FunctionDefinition,
+	VariableDeclaration,
+	ModifierDefinition,
+	ModifierInvocation,
+	EventDefinition,
+	ElementaryTypeName,
+	UserDefinedTypeName,
+	FunctionTypeName,
+	Mapping,
+	ArrayTypeName,
+	InlineAssembly,
+	Block,
+	PlaceholderStatement,
+	IfStatement,
+	TryCatchClause,
+	TryStatement,
+	WhileStatement,
+	ForStatement,
+	Continue,
+	Break,
+	Return,
+	Throw,
+	EmitStatement,
+	VariableDeclarationStatement,
+	ExpressionStatement,
+	Conditional,
+	Assignment,
+	TupleExpression,
+	UnaryOperation,
+	BinaryOperation,
+	FunctionCall,
+	FunctionCallOptions,
+	NewExpression,
+	MemberAccess,
+	IndexAccess,
+	IndexRangeAccess,
+	Identifier,
+	ElementaryTypeNameExpression,
+	Literal
+};
+
+enum class YulKind: uint8_t
+{
+	Literal,
+	Identifier,
+	FunctionCall,
+	ExpressionStatement,
+	Assignment,
+	VariableDeclaration,
+	FunctionDefinition,
+	If,
+	Switch,
+	ForLoop,
+	Break,
+	Continue,
+	Leave,
+	Block
+};
+
+uint64_t zigzag(int64_t _value)
+{
+	return (static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63);
+}
+
+int64_t unzigzag(uint64_t _value)
+{
+	return static_cast<int64_t>(_value >> 1) ^ -static_cast<int64_t>(_value & 1);
+}
+
+/// Buffer for the encoding of a node or of a whole binary AST.
+struct Writer
+{
+	void byte(uint8_t _value) { data.push_back(static_cast<char>(_value)); }
+	void flag(bool _value) { byte(_value ? 1 : 0); }
+	void varint(uint64_t _value)
+	{
+		while (_value >= 0x80)
+		{
+			byte(static_cast<uint8_t>((_value & 0x7f) | 0x80));
+			_value >>= 7;
+		}
+		byte(static_cast<uint8_t>(_value));
+	}
+	void signedVarint(int64_t _value) { varint(zigzag(_value)); }
+	template <class E>
+	void enumValue(E _value) { varint(static_cast<uint64_t>(_value)); }
+	/// Source locations are stored as start and length, since the source is that of the source unit.
+	void location(SourceLocation const& _location)
+	{
+		signedVarint(_location.start);
+		signedVarint(static_cast<int64_t>(_location.end) - _location.start);
+	}
+
+	string data;
+};
+
+/// Strings of a binary AST in order of their indices.
+class StringTable
+{
+public:
+	size_t index(string const& _value)
+	{
+		auto [it, inserted] = m_indices.emplace(_value, m_strings.size());
+		if (inserted)
+			m_strings.push_back(&it->first);
+		return it->second;
+	}
+
+	void write(Writer& _out) const
+	{
+		_out.varint(m_strings.size());
+		for (string const* str: m_strings)
+		{
+			_out.varint(str->size());
+			_out.data += *str;
+		}
+	}
+
+private:
+	unordered_map<string, size_t> m_indices;
+	/// Points into the keys of m_indices.
+	vector<string const*> m_strings;
+};
+
+/// Writes the nodes of an inline assembly block. Each operator() writes the children of a node
+/// before the node itself and @returns the reference to the node, i.e. its index plus one.
+class YulEncoder
+{
+public:
+	explicit YulEncoder(StringTable& _strings): m_strings(_strings) {}
+
+	/// @returns the number of nodes followed by the nodes, the last of which is @a _block.
+	string encode(yul::Block const& _block)
+	{
+		(*this)(_block);
+		Writer out;
+		out.varint(m_count);
+		return out.data + m_nodes;
+	}
+
+	size_t operator()(yul::Literal const& _literal)
+	{
+		Writer record = header(YulKind::Literal, _literal.location);
+		record.enumValue(_literal.kind);
+		record.varint(m_strings.index(_literal.value.str()));
+		record.varint(m_strings.index(_literal.type.str()));
+		return add(record);
+	}
+
+	size_t operator()(yul::Identifier const& _identifier)
+	{
+		Writer record = header(YulKind::Identifier, _identifier.location);
+		record.varint(m_strings.index(_identifier.name.str()));
+		return add(record);
+	}
+
+	size_t operator()(yul::FunctionCall const& _call)
+	{
+		vector<size_t> arguments = indices(_call.arguments);
+		Writer record = header(YulKind::FunctionCall, _call.location);
+		identifier(record, _call.functionName);
+		references(record, arguments);
+		return add(record);
+	}
+
+	size_t operator()(yul::ExpressionStatement const& _statement)
+	{
+		size_t expression = std::visit(*this, _statement.expression);
+		Writer record = header(YulKind::ExpressionStatement, _statement.location);
+		record.varint(expression);
+		return add(record);
+	}
+
+	size_t operator()(yul::Assignment const& _assignment)
+	{
+		size_t value = std::visit(*this, *_assignment.value);
+		Writer record = header(YulKind::Assignment, _assignment.location);
+		record.varint(_assignment.variableNames.size());
+		for (yul::Identifier const& variableName: _assignment.variableNames)
+			identifier(record, variableName);
+		record.varint(value);
+		return add(record);
+	}
+
+	size_t operator()(yul::VariableDeclaration const& _declaration)
+	{
+		optional<size_t> value;
+		if (_declaration.value)
+			value = std::visit(*this, *_declaration.value);
+		Writer record = header(YulKind::VariableDeclaration, _declaration.location);
+		typedNames(record, _declaration.variables);
+		record.flag(value.has_value());
+		if (value)
+			record.varint(*value);
+		return add(record);
+	}
+
+	size_t operator()(yul::FunctionDefinition const& _function)
+	{
+		size_t body = (*this)(_function.body);
+		Writer record = header(YulKind::FunctionDefinition, _function.location);
+		record.varint(m_strings.index(_function.name.str()));
+		typedNames(record, _function.parameters);
+		typedNames(record, _function.returnVariables);
+		record.varint(body);
+		return add(record);
+	}
+
+	size_t operator()(yul::If const& _if)
+	{
+		size_t condition = std::visit(*this, *_if.condition);
+		size_t body = (*this)(_if.body);
+		Writer record = header(YulKind::If, _if.location);
+		record.varint(condition);
+		record.varint(body);
+		return add(record);
+	}
+
+	size_t operator()(yul::Switch const& _switch)
+	{
+		size_t expression = std::visit(*this, *_switch.expression);
+		vector<pair<optional<size_t>, size_t>> cases;
+		for (yul::Case const& switchCase: _switch.cases)
+		{
+			optional<size_t> value;
+			if (switchCase.value)
+				value = (*this)(*switchCase.value);
+			cases.emplace_back(value, (*this)(switchCase.body));
+		}
+		Writer record = header(YulKind::Switch, _switch.location);
+		record.varint(expression);
+		record.varint(cases.size());
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			record.location(_switch.cases[i].location);
+			record.flag(cases[i].first.has_value());
+			if (cases[i].first)
+				record.varint(*cases[i].first);
+			record.varint(cases[i].second);
+		}
+		return add(record);
+	}
+
+	size_t operator()(yul::ForLoop const& _loop)
+	{
+		size_t pre = (*this)(_loop.pre);
+		size_t condition = std::visit(*this, *_loop.condition);
+		size_t post = (*this)(_loop.post);
+		size_t body = (*this)(_loop.body);
+		Writer record = header(YulKind::ForLoop, _loop.location);
+		record.varint(pre);
+		record.varint(condition);
+		record.varint(post);
+		record.varint(body);
+		return add(record);
+	}
+
+	size_t operator()(yul::Break const& _break) { return add(header(YulKind::Break, _break.location)); }
+	size_t operator()(yul::Continue const& _continue) { return add(header(YulKind::Continue, _continue.location)); }
+	size_t operator()(yul::Leave const& _leave) { return add(header(YulKind::Leave, _leave.location)); }
+
+	size_t operator()(yul::Block const& _block)
+	{
+		vector<size_t> statements = indices(_block.statements);
+		Writer record = header(YulKind::Block, _block.location);
+		references(record, statements);
+		return add(record);
+	}
+
+private:
+	template <class T>
+	vector<size_t> indices(vector<T> const& _nodes)
+	{
+		vector<size_t> result;
+		for (T const& node: _nodes)
+			result.push_back(std::visit(*this, node));
+		return result;
+	}
+
+	static Writer header(YulKind _kind, SourceLocation const& _location)
+	{
+		Writer record;
+		record.byte(static_cast<uint8_t>(_kind));
+		record.location(_location);
+		return record;
+	}
+
+	static void references(Writer& _record, vector<size_t> const& _indices)
+	{
+		_record.varint(_indices.size());
+		for (size_t index: _indices)
+			_record.varint(index);
+	}
+
+	void identifier(Writer& _record, yul::Identifier const& _identifier)
+	{
+		_record.location(_identifier.location);
+		_record.varint(m_strings.index(_identifier.name.str()));
+	}
+
+	void typedNames(Writer& _record, yul::TypedNameList const& _names)
+	{
+		_record.varint(_names.size());
+		for (yul::TypedName const& name: _names)
+		{
+			_record.location(name.location);
+			_record.varint(m_strings.index(name.name.str()));
+			_record.varint(m_strings.index(name.type.str()));
+		}
+	}
+
+	size_t add(Writer const& _record)
+	{
+		m_nodes += _record.data;
+		return ++m_count;
+	}
+
+	StringTable& m_strings;
+	string m_nodes;
+	size_t m_count = 0;
+};
+
+/// Writes the nodes of a source unit. The children of each node are written on demand before the
+/// node itself, in the order in which the node refers to them.
+/// References to nodes are stored as their index plus one, zero stands for an absent node.
+class Encoder: private ASTConstVisitor
+{
+public:
+	explicit Encoder(StringTable& _strings): m_strings(_strings) {}
+
+	/// @returns the number of nodes followed by the nodes, the last of which is @a _sourceUnit.
+	string encode(SourceUnit const& _sourceUnit)
+	{
+		_sourceUnit.accept(*this);
+		Writer out;
+		out.varint(m_indices.size());
+		return out.data + m_nodes;
+	}
+
+private:
+	bool visitNode(ASTNode const&) override { return false; }
+	void endVisitNode(ASTNode const&) override
+	{
+		solAssert(false, "AST node not supported by the binary AST format.");
+	}
+
+	void endVisit(SourceUnit const& _node) override
+	{
+		Writer record;
+		record.flag(_node.licenseString().has_value());
+		if (_node.licenseString())
+			writeString(record, *_node.licenseString());
+		children(record, _node.nodes());
+		add(NodeKind::SourceUnit, _node, record);
+	}
+
+	void endVisit(PragmaDirective const& _node) override
+	{
+		Writer record;
+		record.varint(_node.tokens().size());
+		for (size_t i = 0; i < _node.tokens().size(); ++i)
+		{
+			record.enumValue(_node.tokens()[i]);
+			writeString(record, _node.literals()[i]);
+		}
+		add(NodeKind::PragmaDirective, _node, record);
+	}
+
+	void endVisit(ImportDirective const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.path());
+		writeString(record, _node.name());
+		record.varint(_node.symbolAliases().size());
+		for (auto const& alias: _node.symbolAliases())
+		{
+			child(record, alias.symbol.get());
+			writeOptionalString(record, alias.alias);
+			record.location(alias.location);
+		}
+		record.flag(_node.annotation().absolutePath.set());
+		if (_node.annotation().absolutePath.set())
+			writeString(record, *_node.annotation().absolutePath);
+		add(NodeKind::ImportDirective, _node, record);
+	}
+
+	void endVisit(StructuredDocumentation const& _node) override
+	{
+		Writer record;
+		writeString(record, *_node.text());
+		add(NodeKind::StructuredDocumentation, _node, record);
+	}
+
+	void endVisit(ContractDefinition const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		child(record, _node.documentation().get());
+		children(record, _node.baseContracts());
+		children(record, _node.subNodes());
+		record.enumValue(_node.contractKind());
+		record.flag(_node.abstract());
+		add(NodeKind::ContractDefinition, _node, record);
+	}
+
+	void endVisit(InheritanceSpecifier const& _node) override
+	{
+		Writer record;
+		child(record, &_node.name());
+		optionalChildren(record, _node.arguments());
+		add(NodeKind::InheritanceSpecifier, _node, record);
+	}
+
+	void endVisit(UsingForDirective const& _node) override
+	{
+		Writer record;
+		child(record, &_node.libraryName());
+		child(record, _node.typeName());
+		add(NodeKind::UsingForDirective, _node, record);
+	}
+
+	void endVisit(StructDefinition const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		children(record, _node.members());
+		add(NodeKind::StructDefinition, _node, record);
+	}
+
+	void endVisit(EnumDefinition const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		children(record, _node.members());
+		add(NodeKind::EnumDefinition, _node, record);
+	}
+
+	void endVisit(EnumValue const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		add(NodeKind::EnumValue, _node, record);
+	}
+
+	void endVisit(ParameterList const& _node) override
+	{
+		Writer record;
+		children(record, _node.parameters());
+		add(NodeKind::ParameterList, _node, record);
+	}
+
+	void endVisit(OverrideSpecifier const& _node) override
+	{
+		Writer record;
+		children(record, _node.overrides());
+		add(NodeKind::OverrideSpecifier, _node, record);
+	}
+
+	void endVisit(FunctionDefinition const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		record.enumValue(visibility(_node));
+		record.enumValue(_node.stateMutability());
+		record.flag(_node.isFree());
+		record.enumValue(_node.kind());
+		record.flag(_node.markedVirtual());
+		child(record, _node.overrides().get());
+		child(record, _node.documentation().get());
+		child(record, &_node.parameterList());
+		children(record, _node.modifiers());
+		child(record, _node.returnParameterList().get());
+		child(record, _node.isImplemented() ? &_node.body() : nullptr);
+		add(NodeKind::FunctionDefinition, _node, record);
+	}
+
+	void endVisit(VariableDeclaration const& _node) override
+	{
+		Writer record;
+		child(record, &_node.typeName());
+		writeString(record, _node.name());
+		child(record, _node.value().get());
+		record.enumValue(visibility(_node));
+		child(record, _node.documentation().get());
+		record.flag(_node.isIndexed());
+		record.enumValue(_node.mutability());
+		child(record, _node.overrides().get());
+		record.enumValue(_node.referenceLocation());
+		add(NodeKind::VariableDeclaration, _node, record);
+	}
+
+	void endVisit(ModifierDefinition const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		child(record, _node.documentation().get());
+		child(record, &_node.parameterList());
+		record.flag(_node.markedVirtual());
+		child(record, _node.overrides().get());
+		child(record, _node.isImplemented() ? &_node.body() : nullptr);
+		add(NodeKind::ModifierDefinition, _node, record);
+	}
+
+	void endVisit(ModifierInvocation const& _node) override
+	{
+		Writer record;
+		child(record, _node.name().get());
+		optionalChildren(record, _node.arguments());
+		add(NodeKind::ModifierInvocation, _node, record);
+	}
+
+	void endVisit(EventDefinition const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		child(record, _node.documentation().get());
+		child(record, &_node.parameterList());
+		record.flag(_node.isAnonymous());
+		add(NodeKind::EventDefinition, _node, record);
+	}
+
+	void endVisit(ElementaryTypeName const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.typeName().toString());
+		record.flag(_node.stateMutability().has_value());
+		if (_node.stateMutability())
+			record.enumValue(*_node.stateMutability());
+		add(NodeKind::ElementaryTypeName, _node, record);
+	}
+
+	void endVisit(UserDefinedTypeName const& _node) override
+	{
+		Writer record;
+		record.varint(_node.namePath().size());
+		for (ASTString const& name: _node.namePath())
+			writeString(record, name);
+		add(NodeKind::UserDefinedTypeName, _node, record);
+	}
+
+	void endVisit(FunctionTypeName const& _node) override
+	{
+		Writer record;
+		child(record, _node.parameterTypeList().get());
+		child(record, _node.returnParameterTypeList().get());
+		record.enumValue(_node.visibility());
+		record.enumValue(_node.stateMutability());
+		add(NodeKind::FunctionTypeName, _node, record);
+	}
+
+	void endVisit(Mapping const& _node) override
+	{
+		Writer record;
+		child(record, &_node.keyType());
+		child(record, &_node.valueType());
+		add(NodeKind::Mapping, _node, record);
+	}
+
+	void endVisit(ArrayTypeName const& _node) override
+	{
+		Writer record;
+		child(record, &_node.baseType());
+		child(record, _node.length());
+		add(NodeKind::ArrayTypeName, _node, record);
+	}
+
+	void endVisit(InlineAssembly const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		record.data += YulEncoder(m_strings).encode(_node.operations());
+		add(NodeKind::InlineAssembly, _node, record);
+	}
+
+	void endVisit(Block const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		children(record, _node.statements());
+		add(NodeKind::Block, _node, record);
+	}
+
+	void endVisit(PlaceholderStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		add(NodeKind::PlaceholderStatement, _node, record);
+	}
+
+	void endVisit(IfStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, &_node.condition());
+		child(record, &_node.trueStatement());
+		child(record, _node.falseStatement());
+		add(NodeKind::IfStatement, _node, record);
+	}
+
+	void endVisit(TryCatchClause const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.errorName());
+		child(record, _node.parameters());
+		child(record, &_node.block());
+		add(NodeKind::TryCatchClause, _node, record);
+	}
+
+	void endVisit(TryStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, &_node.externalCall());
+		children(record, _node.clauses());
+		add(NodeKind::TryStatement, _node, record);
+	}
+
+	void endVisit(WhileStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, &_node.condition());
+		child(record, &_node.body());
+		record.flag(_node.isDoWhile());
+		add(NodeKind::WhileStatement, _node, record);
+	}
+
+	void endVisit(ForStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, _node.initializationExpression());
+		child(record, _node.condition());
+		child(record, _node.loopExpression());
+		child(record, &_node.body());
+		add(NodeKind::ForStatement, _node, record);
+	}
+
+	void endVisit(Continue const& _node) override { statement(NodeKind::Continue, _node); }
+	void endVisit(Break const& _node) override { statement(NodeKind::Break, _node); }
+	void endVisit(Throw const& _node) override { statement(NodeKind::Throw, _node); }
+
+	void endVisit(Return const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, _node.expression());
+		add(NodeKind::Return, _node, record);
+	}
+
+	void endVisit(EmitStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, &_node.eventCall());
+		add(NodeKind::EmitStatement, _node, record);
+	}
+
+	void endVisit(VariableDeclarationStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		// Unnamed components of a tuple are null.
+		children(record, _node.declarations());
+		child(record, _node.initialValue());
+		add(NodeKind::VariableDeclarationStatement, _node, record);
+	}
+
+	void endVisit(ExpressionStatement const& _node) override
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		child(record, &_node.expression());
+		add(NodeKind::ExpressionStatement, _node, record);
+	}
+
+	void endVisit(Conditional const& _node) override
+	{
+		Writer record;
+		child(record, &_node.condition());
+		child(record, &_node.trueExpression());
+		child(record, &_node.falseExpression());
+		add(NodeKind::Conditional, _node, record);
+	}
+
+	void endVisit(Assignment const& _node) override
+	{
+		Writer record;
+		child(record, &_node.leftHandSide());
+		record.enumValue(_node.assignmentOperator());
+		child(record, &_node.rightHandSide());
+		add(NodeKind::Assignment, _node, record);
+	}
+
+	void endVisit(TupleExpression const& _node) override
+	{
+		Writer record;
+		// Empty components are null.
+		children(record, _node.components());
+		record.flag(_node.isInlineArray());
+		add(NodeKind::TupleExpression, _node, record);
+	}
+
+	void endVisit(UnaryOperation const& _node) override
+	{
+		Writer record;
+		record.enumValue(_node.getOperator());
+		child(record, &_node.subExpression());
+		record.flag(_node.isPrefixOperation());
+		add(NodeKind::UnaryOperation, _node, record);
+	}
+
+	void endVisit(BinaryOperation const& _node) override
+	{
+		Writer record;
+		child(record, &_node.leftExpression());
+		record.enumValue(_node.getOperator());
+		child(record, &_node.rightExpression());
+		add(NodeKind::BinaryOperation, _node, record);
+	}
+
+	void endVisit(FunctionCall const& _node) override
+	{
+		Writer record;
+		child(record, &_node.expression());
+		children(record, _node.arguments());
+		writeStrings(record, _node.names());
+		add(NodeKind::FunctionCall, _node, record);
+	}
+
+	void endVisit(FunctionCallOptions const& _node) override
+	{
+		Writer record;
+		child(record, &_node.expression());
+		children(record, _node.options());
+		writeStrings(record, _node.names());
+		add(NodeKind::FunctionCallOptions, _node, record);
+	}
+
+	void endVisit(NewExpression const& _node) override
+	{
+		Writer record;
+		child(record, &_node.typeName());
+		add(NodeKind::NewExpression, _node, record);
+	}
+
+	void endVisit(MemberAccess const& _node) override
+	{
+		Writer record;
+		child(record, &_node.expression());
+		writeString(record, _node.memberName());
+		add(NodeKind::MemberAccess, _node, record);
+	}
+
+	void endVisit(IndexAccess const& _node) override
+	{
+		Writer record;
+		child(record, &_node.baseExpression());
+		child(record, _node.indexExpression());
+		add(NodeKind::IndexAccess, _node, record);
+	}
+
+	void endVisit(IndexRangeAccess const& _node) override
+	{
+		Writer record;
+		child(record, &_node.baseExpression());
+		child(record, _node.startExpression());
+		child(record, _node.endExpression());
+		add(NodeKind::IndexRangeAccess, _node, record);
+	}
+
+	void endVisit(Identifier const& _node) override
+	{
+		Writer record;
+		writeString(record, _node.name());
+		add(NodeKind::Identifier, _node, record);
+	}
+
+	void endVisit(ElementaryTypeNameExpression const& _node) override
+	{
+		Writer record;
+		child(record, &_node.type());
+		add(NodeKind::ElementaryTypeNameExpression, _node, record);
+	}
+
+	void endVisit(Literal const& _node) override
+	{
+		Writer record;
+		record.enumValue(_node.token());
+		writeString(record, _node.value());
+		record.enumValue(_node.subDenomination());
+		add(NodeKind::Literal, _node, record);
+	}
+
+	/// @returns the visibility as it was specified, which is Default if it was omitted.
+	static Visibility visibility(Declaration const& _declaration)
+	{
+		return _declaration.noVisibilitySpecified() ? Visibility::Default : _declaration.visibility();
+	}
+
+	void statement(NodeKind _kind, Statement const& _node)
+	{
+		Writer record;
+		writeOptionalString(record, _node.documentation());
+		add(_kind, _node, record);
+	}
+
+	/// Writes @a _node unless it was written already and refers to it from @a _record.
+	void child(Writer& _record, ASTNode const* _node)
+	{
+		if (!_node)
+		{
+			_record.varint(0);
+			return;
+		}
+		auto it = m_indices.find(_node);
+		if (it == m_indices.end())
+		{
+			_node->accept(*this);
+			it = m_indices.find(_node);
+			solAssert(it != m_indices.end(), "");
+		}
+		_record.varint(it->second + 1);
+	}
+
+	template <class T>
+	void children(Writer& _record, vector<ASTPointer<T>> const& _nodes)
+	{
+		_record.varint(_nodes.size());
+		for (auto const& node: _nodes)
+			child(_record, node.get());
+	}
+
+	template <class T>
+	void optionalChildren(Writer& _record, vector<ASTPointer<T>> const* _nodes)
+	{
+		_record.flag(_nodes);
+		if (_nodes)
+			children(_record, *_nodes);
+	}
+
+	void writeString(Writer& _record, std::string const& _value)
+	{
+		_record.varint(m_strings.index(_value));
+	}
+
+	void writeOptionalString(Writer& _record, ASTPointer<ASTString> const& _value)
+	{
+		_record.varint(_value ? m_strings.index(*_value) + 1 : 0);
+	}
+
+	void writeStrings(Writer& _record, vector<ASTPointer<ASTString>> const& _values)
+	{
+		_record.varint(_values.size());
+		for (auto const& value: _values)
+			writeString(_record, *value);
+	}
+
+	void add(NodeKind _kind, ASTNode const& _node, Writer const& _record)
+	{
+		Writer header;
+		header.byte(static_cast<uint8_t>(_kind));
+		header.signedVarint(_node.id());
+		header.location(_node.location());
+		m_nodes += header.data;
+		m_nodes += _record.data;
+		solAssert(m_indices.emplace(&_node, m_indices.size()).second, "AST node is referenced twice.");
+	}
+
+	StringTable& m_strings;
+	std::string m_nodes;
+	unordered_map<ASTNode const*, size_t> m_indices;
+};
+
+/// Reads the primitive encodings of the format.
+class Reader
+{
+public:
+	explicit Reader(std::string const& _data): m_data(_data) {}
+
+	bool atEnd() const { return m_pos == m_data.size(); }
+
+	uint8_t byte()
+	{
+		astAssert(m_pos < m_data.size(), "Unexpected end of binary AST.");
+		return static_cast<uint8_t>(m_data[m_pos++]);
+	}
+
+	bool flag()
+	{
+		uint8_t value = byte();
+		astAssert(value <= 1, "Invalid flag in binary AST.");
+		return value == 1;
+	}
+
+	uint64_t varint()
+	{
+		uint64_t result = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			uint8_t value = byte();
+			result |= static_cast<uint64_t>(value & 0x7f) << shift;
+			if (!(value & 0x80))
+				return result;
+		}
+		astAssert(false, "Invalid varint in binary AST.");
+		return 0;
+	}
+
+	int64_t signedVarint() { return unzigzag(varint()); }
+
+	/// Reads a number of elements or bytes that follow. Every element takes at least one byte,
+	/// which bounds the allocations malformed input can cause.
+	size_t count()
+	{
+		uint64_t value = varint();
+		astAssert(value <= m_data.size() - m_pos, "Unexpected end of binary AST.");
+		return static_cast<size_t>(value);
+	}
+
+	std::string bytes(size_t _length)
+	{
+		std::string result = m_data.substr(m_pos, _length);
+		m_pos += _length;
+		return result;
+	}
+
+	/// Reads an enum value that is at most @a _max.
+	template <class E>
+	E enumValue(E _max)
+	{
+		uint64_t value = varint();
+		astAssert(value <= static_cast<uint64_t>(_max), "Invalid enum value in binary AST.");
+		return static_cast<E>(value);
+	}
+
+	/// Reads a location in @a _source.
+	SourceLocation location(shared_ptr<CharStream> const& _source)
+	{
+		int64_t start = signedVarint();
+		int64_t length = signedVarint();
+		int64_t constexpr maxPosition = numeric_limits<int>::max();
+		astAssert(
+			-1 <= start && start <= maxPosition && -maxPosition <= length && length <= maxPosition &&
+			-1 <= start + length && start + length <= maxPosition,
+			"Invalid source location in binary AST."
+		);
+		return SourceLocation{static_cast<int>(start), static_cast<int>(start + length), _source};
+	}
+
+private:
+	std::string const& m_data;
+	size_t m_pos = 0;
+};
+
+/// Creates the nodes of an inline assembly block.
+class YulDecoder
+{
+public:
+	YulDecoder(Reader& _in, vector<ASTPointer<ASTString>> const& _strings, shared_ptr<CharStream> _source):
+		m_in(_in), m_strings(_strings), m_source(move(_source))
+	{}
+
+	yul::Block decode()
+	{
+		size_t count = m_in.count();
+		astAssert(count > 0, "Empty inline assembly block in binary AST.");
+		for (size_t i = 0; i < count; ++i)
+			readNode();
+		yul::Block block = take<yul::Statement, yul::Block>(count);
+		for (auto const& node: m_nodes)
+			astAssert(!node, "Unreferenced inline assembly node in binary AST.");
+		return block;
+	}
+
+private:
+	using Node = variant<yul::Statement, yul::Expression>;
+
+	void readNode()
+	{
+		auto kind = YulKind(m_in.byte());
+		SourceLocation location = m_in.location(m_source);
+		switch (kind)
+		{
+		case YulKind::Literal:
+		{
+			auto literalKind = m_in.enumValue(yul::LiteralKind::String);
+			yul::YulString value = readString();
+			yul::YulString type = readString();
+			return add(yul::Expression{yul::Literal{location, literalKind, value, type}});
+		}
+		case YulKind::Identifier:
+			return add(yul::Expression{yul::Identifier{location, readString()}});
+		case YulKind::FunctionCall:
+		{
+			yul::Identifier functionName = identifier();
+			vector<yul::Expression> arguments = list<yul::Expression, yul::Expression>();
+			return add(yul::Expression{yul::FunctionCall{location, move(functionName), move(arguments)}});
+		}
+		case YulKind::ExpressionStatement:
+		{
+			yul::Expression expression = take<yul::Expression, yul::Expression>();
+			return add(yul::Statement{yul::ExpressionStatement{location, move(expression)}});
+		}
+		case YulKind::Assignment:
+		{
+			vector<yul::Identifier> variableNames(m_in.count());
+			for (auto& variableName: variableNames)
+				variableName = identifier();
+			auto value = yul::makeNode<yul::Expression>(take<yul::Expression, yul::Expression>());
+			return add(yul::Statement{yul::Assignment{location, move(variableNames), move(value)}});
+		}
+		case YulKind::VariableDeclaration:
+		{
+			yul::TypedNameList variables = typedNames();
+			yul::NodePointer<yul::Expression> value;
+			if (m_in.flag())
+				value = yul::makeNode<yul::Expression>(take<yul::Expression, yul::Expression>());
+			return add(yul::Statement{yul::VariableDeclaration{location, move(variables), move(value)}});
+		}
+		case YulKind::FunctionDefinition:
+		{
+			yul::YulString name = readString();
+			yul::TypedNameList parameters = typedNames();
+			yul::TypedNameList returnVariables = typedNames();
+			yul::Block body = take<yul::Statement, yul::Block>();
+			return add(yul::Statement{yul::FunctionDefinition{
+				location,
+				name,
+				move(parameters),
+				move(returnVariables),
+				move(body)
+			}});
+		}
+		case YulKind::If:
+		{
+			auto condition = yul::makeNode<yul::Expression>(take<yul::Expression, yul::Expression>());
+			yul::Block body = take<yul::Statement, yul::Block>();
+			return add(yul::Statement{yul::If{location, move(condition), move(body)}});
+		}
+		case YulKind::Switch:
+		{
+			auto expression = yul::makeNode<yul::Expression>(take<yul::Expression, yul::Expression>());
+			vector<yul::Case> cases(m_in.count());
+			for (yul::Case& switchCase: cases)
+			{
+				switchCase.location = m_in.location(m_source);
+				if (m_in.flag())
+					switchCase.value = yul::makeNode<yul::Literal>(take<yul::Expression, yul::Literal>());
+				switchCase.body = take<yul::Statement, yul::Block>();
+			}
+			return add(yul::Statement{yul::Switch{location, move(expression), move(cases)}});
+		}
+		case YulKind::ForLoop:
+		{
+			yul::Block pre = take<yul::Statement, yul::Block>();
+			auto condition = yul::makeNode<yul::Expression>(take<yul::Expression, yul::Expression>());
+			yul::Block post = take<yul::Statement, yul::Block>();
+			yul::Block body = take<yul::Statement, yul::Block>();
+			return add(yul::Statement{yul::ForLoop{location, move(pre), move(condition), move(post), move(body)}});
+		}
+		case YulKind::Break:
+			return add(yul::Statement{yul::Break{location}});
+		case YulKind::Continue:
+			return add(yul::Statement{yul::Continue{location}});
+		case YulKind::Leave:
+			return add(yul::Statement{yul::Leave{location}});
+		case YulKind::Block:
+		{
+			vector<yul::Statement> statements = list<yul::Statement, yul::Statement>();
+			return add(yul::Statement{yul::Block{location, move(statements)}});
+		}
+		}
+		astAssert(false, "Invalid inline assembly node kind in binary AST.");
+	}
+
+	void add(Node _node)
+	{
+		m_nodes.emplace_back(move(_node));
+	}
+
+	/// Takes the node with the given one-based index, which has to be a @a Variant holding a @a T.
+	template <class Variant, class T>
+	T take(uint64_t _reference)
+	{
+		astAssert(0 < _reference && _reference <= m_nodes.size(), "Invalid node reference in binary AST.");
+		optional<Node>& node = m_nodes[static_cast<size_t>(_reference - 1)];
+		astAssert(node, "Node referenced twice in binary AST.");
+		Variant* variant = get_if<Variant>(&*node);
+		astAssert(variant, "Node of unexpected type in binary AST.");
+		T result;
+		if constexpr (is_same_v<Variant, T>)
+			result = move(*variant);
+		else
+		{
+			astAssert(holds_alternative<T>(*variant), "Node of unexpected type in binary AST.");
+			result = move(get<T>(*variant));
+		}
+		node.reset();
+		return result;
+	}
+
+	template <class Variant, class T>
+	T take() { return take<Variant, T>(m_in.varint()); }
+
+	template <class Variant, class T>
+	vector<T> list()
+	{
+		vector<T> result(m_in.count());
+		for (T& element: result)
+			element = take<Variant, T>();
+		return result;
+	}
+
+	yul::YulString readString()
+	{
+		uint64_t index = m_in.varint();
+		astAssert(index < m_strings.size(), "Invalid string index in binary AST.");
+		return yul::YulString(*m_strings[static_cast<size_t>(index)]);
+	}
+
+	yul::Identifier identifier()
+	{
+		SourceLocation location = m_in.location(m_source);
+		return yul::Identifier{location, readString()};
+	}
+
+	yul::TypedNameList typedNames()
+	{
+		yul::TypedNameList names(m_in.count());
+		for (yul::TypedName& name: names)
+		{
+			name.location = m_in.location(m_source);
+			name.name = readString();
+			name.type = readString();
+		}
+		return names;
+	}
+
+	Reader& m_in;
+	vector<ASTPointer<ASTString>> const& m_strings;
+	shared_ptr<CharStream> m_source;
+	vector<optional<Node>> m_nodes;
+};
+
+/// Creates the source units of a binary AST. Every node is created after its children, so that a
+/// single pass suffices, and every node but the source unit has to be referenced exactly once.
+class Decoder
+{
+public:
+	Decoder(std::string const& _data, EVMVersion _evmVersion): m_in(_data), m_evmVersion(_evmVersion) {}
+
+	vector<ASTBinaryFormat::Source> decode()
+	{
+		astAssert(m_in.bytes(magic.size()) == magic, "Input is not a binary AST.");
+		astAssert(m_in.byte() == ASTBinaryFormat::version, "Unsupported binary AST version.");
+
+		m_strings.resize(m_in.count());
+		for (auto& str: m_strings)
+			str = make_shared<ASTString>(m_in.bytes(m_in.count()));
+
+		vector<ASTBinaryFormat::Source> sources(m_in.count());
+		set<std::string> names;
+		for (auto& source: sources)
+		{
+			std::string const& name = *readString();
+			astAssert(names.insert(name).second, "All sources must have unique names");
+			source.charStream = make_shared<CharStream>(m_in.bytes(m_in.count()), name);
+			source.ast = readSourceUnit(source.charStream);
+		}
+		astAssert(m_in.atEnd(), "Trailing data after binary AST.");
+		sort(m_ids.begin(), m_ids.end());
+		astAssert(adjacent_find(m_ids.begin(), m_ids.end()) == m_ids.end(), "Found duplicate node ID!");
+		return sources;
+	}
+
+private:
+	ASTPointer<SourceUnit> readSourceUnit(shared_ptr<CharStream> const& _source)
+	{
+		m_source = _source;
+		m_nodes.clear();
+		size_t count = m_in.count();
+		astAssert(count > 0, "Empty source unit in binary AST.");
+		m_nodes.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			m_nodes.emplace_back(readNode());
+		auto sourceUnit = take<SourceUnit>(count);
+		for (auto const& node: m_nodes)
+			astAssert(!node, "Unreferenced node in binary AST.");
+		sourceUnit->annotation().path = _source->name();
+		return sourceUnit;
+	}
+
+	struct Header
+	{
+		int64_t id;
+		SourceLocation location;
+	};
+
+	ASTPointer<ASTNode> readNode()
+	{
+		auto kind = NodeKind(m_in.byte());
+		Header header{m_in.signedVarint(), m_in.location(m_source)};
+		m_ids.push_back(header.id);
+
+		switch (kind)
+		{
+		case NodeKind::SourceUnit:
+		{
+			optional<std::string> license;
+			if (m_in.flag())
+				license = *readString();
+			auto nodes = nodeList<ASTNode>();
+			return create<SourceUnit>(header, move(license), move(nodes));
+		}
+		case NodeKind::PragmaDirective:
+		{
+			vector<Token> tokens(m_in.count());
+			vector<ASTString> literals;
+			for (Token& token: tokens)
+			{
+				token = m_in.enumValue(Token::NUM_TOKENS);
+				astAssert(token != Token::NUM_TOKENS, "Invalid token in binary AST.");
+				literals.emplace_back(*readString());
+			}
+			return create<PragmaDirective>(header, move(tokens), move(literals));
+		}
+		case NodeKind::ImportDirective:
+		{
+			auto path = readString();
+			auto unitAlias = readString();
+			ImportDirective::SymbolAliasList symbolAliases(m_in.count());
+			for (auto& alias: symbolAliases)
+			{
+				alias.symbol = node<Identifier>();
+				alias.alias = readOptionalString();
+				alias.location = m_in.location(m_source);
+			}
+			auto importDirective = create<ImportDirective>(header, move(path), unitAlias, move(symbolAliases));
+			if (m_in.flag())
+				importDirective->annotation().absolutePath = *readString();
+			return importDirective;
+		}
+		case NodeKind::StructuredDocumentation:
+			return create<StructuredDocumentation>(header, readString());
+		case NodeKind::ContractDefinition:
+		{
+			auto name = readString();
+			auto documentation = optionalNode<StructuredDocumentation>();
+			auto baseContracts = nodeList<InheritanceSpecifier>();
+			auto subNodes = nodeList<ASTNode>();
+			auto contractKind = m_in.enumValue(ContractKind::Library);
+			bool abstract = m_in.flag();
+			return create<ContractDefinition>(
+				header,
+				move(name),
+				move(documentation),
+				move(baseContracts),
+				move(subNodes),
+				contractKind,
+				abstract
+			);
+		}
+		case NodeKind::InheritanceSpecifier:
+		{
+			auto baseName = node<UserDefinedTypeName>();
+			auto arguments = optionalNodeList<Expression>();
+			return create<InheritanceSpecifier>(header, move(baseName), move(arguments));
+		}
+		case NodeKind::UsingForDirective:
+		{
+			auto libraryName = node<UserDefinedTypeName>();
+			auto typeName = optionalNode<TypeName>();
+			return create<UsingForDirective>(header, move(libraryName), move(typeName));
+		}
+		case NodeKind::StructDefinition:
+		{
+			auto name = readString();
+			auto members = nodeList<VariableDeclaration>();
+			return create<StructDefinition>(header, move(name), move(members));
+		}
+		case NodeKind::EnumDefinition:
+		{
+			auto name = readString();
+			auto members = nodeList<EnumValue>();
+			return create<EnumDefinition>(header, move(name), move(members));
+		}
+		case NodeKind::EnumValue:
+			return create<EnumValue>(header, readString());
+		case NodeKind::ParameterList:
+			return create<ParameterList>(header, nodeList<VariableDeclaration>());
+		case NodeKind::OverrideSpecifier:
+			return create<OverrideSpecifier>(header, nodeList<UserDefinedTypeName>());
+		case NodeKind::FunctionDefinition:
+		{
+			auto name = readString();
+			auto visibility = m_in.enumValue(Visibility::External);
+			auto stateMutability = m_in.enumValue(StateMutability::Payable);
+			bool free = m_in.flag();
+			auto kind = m_in.enumValue(Token::NUM_TOKENS);
+			astAssert(
+				kind == Token::Function || kind == Token::Constructor || kind == Token::Fallback || kind == Token::Receive,
+				"Invalid function kind in binary AST."
+			);
+			bool isVirtual = m_in.flag();
+			auto overrides = optionalNode<OverrideSpecifier>();
+			auto documentation = optionalNode<StructuredDocumentation>();
+			auto parameters = node<ParameterList>();
+			auto modifiers = nodeList<ModifierInvocation>();
+			auto returnParameters = node<ParameterList>();
+			auto body = optionalNode<Block>();
+			return create<FunctionDefinition>(
+				header,
+				move(name),
+				visibility,
+				stateMutability,
+				free,
+				kind,
+				isVirtual,
+				move(overrides),
+				move(documentation),
+				move(parameters),
+				move(modifiers),
+				move(returnParameters),
+				move(body)
+			);
+		}
+		case NodeKind::VariableDeclaration:
+		{
+			auto typeName = node<TypeName>();
+			auto name = readString();
+			auto value = optionalNode<Expression>();
+			auto visibility = m_in.enumValue(Visibility::External);
+			auto documentation = optionalNode<StructuredDocumentation>();
+			bool indexed = m_in.flag();
+			auto mutability = m_in.enumValue(VariableDeclaration::Mutability::Constant);
+			auto overrides = optionalNode<OverrideSpecifier>();
+			auto location = m_in.enumValue(VariableDeclaration::Location::CallData);
+			return create<VariableDeclaration>(
+				header,
+				move(typeName),
+				move(name),
+				move(value),
+				visibility,
+				move(documentation),
+				indexed,
+				mutability,
+				move(overrides),
+				location
+			);
+		}
+		case NodeKind::ModifierDefinition:
+		{
+			auto name = readString();
+			auto documentation = optionalNode<StructuredDocumentation>();
+			auto parameters = node<ParameterList>();
+			bool isVirtual = m_in.flag();
+			auto overrides = optionalNode<OverrideSpecifier>();
+			auto body = optionalNode<Block>();
+			return create<ModifierDefinition>(
+				header,
+				move(name),
+				move(documentation),
+				move(parameters),
+				isVirtual,
+				move(overrides),
+				move(body)
+			);
+		}
+		case NodeKind::ModifierInvocation:
+		{
+			auto name = node<Identifier>();
+			auto arguments = optionalNodeList<Expression>();
+			return create<ModifierInvocation>(header, move(name), move(arguments));
+		}
+		case NodeKind::EventDefinition:
+		{
+			auto name = readString();
+			auto documentation = optionalNode<StructuredDocumentation>();
+			auto parameters = node<ParameterList>();
+			bool anonymous = m_in.flag();
+			return create<EventDefinition>(header, move(name), move(documentation), move(parameters), anonymous);
+		}
+		case NodeKind::ElementaryTypeName:
+		{
+			auto [token, firstNumber, secondNumber] = TokenTraits::fromIdentifierOrKeyword(*readString());
+			astAssert(TokenTraits::isElementaryTypeName(token), "Invalid elementary type name in binary AST.");
+			optional<StateMutability> stateMutability;
+			if (m_in.flag())
+				stateMutability = m_in.enumValue(StateMutability::Payable);
+			return create<ElementaryTypeName>(
+				header,
+				ElementaryTypeNameToken(token, firstNumber, secondNumber),
+				stateMutability
+			);
+		}
+		case NodeKind::UserDefinedTypeName:
+		{
+			vector<ASTString> namePath(m_in.count());
+			for (ASTString& name: namePath)
+				name = *readString();
+			return create<UserDefinedTypeName>(header, move(namePath));
+		}
+		case NodeKind::FunctionTypeName:
+		{
+			auto parameterTypes = node<ParameterList>();
+			auto returnTypes = node<ParameterList>();
+			auto visibility = m_in.enumValue(Visibility::External);
+			auto stateMutability = m_in.enumValue(StateMutability::Payable);
+			return create<FunctionTypeName>(header, move(parameterTypes), move(returnTypes), visibility, stateMutability);
+		}
+		case NodeKind::Mapping:
+		{
+			auto keyType = node<TypeName>();
+			auto valueType = node<TypeName>();
+			return create<Mapping>(header, move(keyType), move(valueType));
+		}
+		case NodeKind::ArrayTypeName:
+		{
+			auto baseType = node<TypeName>();
+			auto length = optionalNode<Expression>();
+			return create<ArrayTypeName>(header, move(baseType), move(length));
+		}
+		case NodeKind::InlineAssembly:
+		{
+			auto documentation = readOptionalString();
+			auto operations = make_shared<yul::Block>(YulDecoder(m_in, m_strings, m_source).decode());
+			return create<InlineAssembly>(
+				header,
+				move(documentation),
+				yul::EVMDialect::strictAssemblyForEVM(m_evmVersion),
+				move(operations)
+			);
+		}
+		case NodeKind::Block:
+		{
+			auto documentation = readOptionalString();
+			auto statements = nodeList<Statement>();
+			return create<Block>(header, move(documentation), move(statements));
+		}
+		case NodeKind::PlaceholderStatement:
+			return create<PlaceholderStatement>(header, readOptionalString());
+		case NodeKind::IfStatement:
+		{
+			auto documentation = readOptionalString();
+			auto condition = node<Expression>();
+			auto trueBody = node<Statement>();
+			auto falseBody = optionalNode<Statement>();
+			return create<IfStatement>(header, move(documentation), move(condition), move(trueBody), move(falseBody));
+		}
+		case NodeKind::TryCatchClause:
+		{
+			auto errorName = readString();
+			auto parameters = optionalNode<ParameterList>();
+			auto block = node<Block>();
+			return create<TryCatchClause>(header, move(errorName), move(parameters), move(block));
+		}
+		case NodeKind::TryStatement:
+		{
+			auto documentation = readOptionalString();
+			auto externalCall = node<Expression>();
+			auto clauses = nodeList<TryCatchClause>();
+			return create<TryStatement>(header, move(documentation), move(externalCall), move(clauses));
+		}
+		case NodeKind::WhileStatement:
+		{
+			auto documentation = readOptionalString();
+			auto condition = node<Expression>();
+			auto body = node<Statement>();
+			bool isDoWhile = m_in.flag();
+			return create<WhileStatement>(header, move(documentation), move(condition), move(body), isDoWhile);
+		}
+		case NodeKind::ForStatement:
+		{
+			auto documentation = readOptionalString();
+			auto initialization = optionalNode<Statement>();
+			auto condition = optionalNode<Expression>();
+			auto loopExpression = optionalNode<ExpressionStatement>();
+			auto body = node<Statement>();
+			return create<ForStatement>(
+				header,
+				move(documentation),
+				move(initialization),
+				move(condition),
+				move(loopExpression),
+				move(body)
+			);
+		}
+		case NodeKind::Continue:
+			return create<Continue>(header, readOptionalString());
+		case NodeKind::Break:
+			return create<Break>(header, readOptionalString());
+		case NodeKind::Return:
+		{
+			auto documentation = readOptionalString();
+			auto expression = optionalNode<Expression>();
+			return create<Return>(header, move(documentation), move(expression));
+		}
+		case NodeKind::Throw:
+			return create<Throw>(header, readOptionalString());
+		case NodeKind::EmitStatement:
+		{
+			auto documentation = readOptionalString();
+			auto eventCall = node<FunctionCall>();
+			return create<EmitStatement>(header, move(documentation), move(eventCall));
+		}
+		case NodeKind::VariableDeclarationStatement:
+		{
+			auto documentation = readOptionalString();
+			auto declarations = nodeList<VariableDeclaration>(true);
+			auto initialValue = optionalNode<Expression>();
+			return create<VariableDeclarationStatement>(header, move(documentation), move(declarations), move(initialValue));
+		}
+		case NodeKind::ExpressionStatement:
+		{
+			auto documentation = readOptionalString();
+			auto expression = node<Expression>();
+			return create<ExpressionStatement>(header, move(documentation), move(expression));
+		}
+		case NodeKind::Conditional:
+		{
+			auto condition = node<Expression>();
+			auto trueExpression = node<Expression>();
+			auto falseExpression = node<Expression>();
+			return create<Conditional>(header, move(condition), move(trueExpression), move(falseExpression));
+		}
+		case NodeKind::Assignment:
+		{
+			auto leftHandSide = node<Expression>();
+			auto assignmentOperator = m_in.enumValue(Token::NUM_TOKENS);
+			astAssert(TokenTraits::isAssignmentOp(assignmentOperator), "Invalid assignment operator in binary AST.");
+			auto rightHandSide = node<Expression>();
+			return create<Assignment>(header, move(leftHandSide), assignmentOperator, move(rightHandSide));
+		}
+		case NodeKind::TupleExpression:
+		{
+			auto components = nodeList<Expression>(true);
+			bool isArray = m_in.flag();
+			return create<TupleExpression>(header, move(components), isArray);
+		}
+		case NodeKind::UnaryOperation:
+		{
+			auto unaryOperator = m_in.enumValue(Token::NUM_TOKENS);
+			astAssert(TokenTraits::isUnaryOp(unaryOperator), "Invalid unary operator in binary AST.");
+			auto subExpression = node<Expression>();
+			bool isPrefix = m_in.flag();
+			return create<UnaryOperation>(header, unaryOperator, move(subExpression), isPrefix);
+		}
+		case NodeKind::BinaryOperation:
+		{
+			auto left = node<Expression>();
+			auto binaryOperator = m_in.enumValue(Token::NUM_TOKENS);
+			astAssert(
+				TokenTraits::isBinaryOp(binaryOperator) || TokenTraits::isCompareOp(binaryOperator),
+				"Invalid binary operator in binary AST."
+			);
+			auto right = node<Expression>();
+			return create<BinaryOperation>(header, move(left), binaryOperator, move(right));
+		}
+		case NodeKind::FunctionCall:
+		{
+			auto expression = node<Expression>();
+			auto arguments = nodeList<Expression>();
+			auto names = readStrings();
+			return create<FunctionCall>(header, move(expression), move(arguments), move(names));
+		}
+		case NodeKind::FunctionCallOptions:
+		{
+			auto expression = node<Expression>();
+			auto options = nodeList<Expression>();
+			auto names = readStrings();
+			return create<FunctionCallOptions>(header, move(expression), move(options), move(names));
+		}
+		case NodeKind::NewExpression:
+			return create<NewExpression>(header, node<TypeName>());
+		case NodeKind::MemberAccess:
+		{
+			auto expression = node<Expression>();
+			auto memberName = readString();
+			return create<MemberAccess>(header, move(expression), move(memberName));
+		}
+		case NodeKind::IndexAccess:
+		{
+			auto base = node<Expression>();
+			auto index = optionalNode<Expression>();
+			return create<IndexAccess>(header, move(base), move(index));
+		}
+		case NodeKind::IndexRangeAccess:
+		{
+			auto base = node<Expression>();
+			auto start = optionalNode<Expression>();
+			auto end = optionalNode<Expression>();
+			return create<IndexRangeAccess>(header, move(base), move(start), move(end));
+		}
+		case NodeKind::Identifier:
+			return create<Identifier>(header, readString());
+		case NodeKind::ElementaryTypeNameExpression:
+			return create<ElementaryTypeNameExpression>(header, node<ElementaryTypeName>());
+		case NodeKind::Literal:
+		{
+			auto token = m_in.enumValue(Token::NUM_TOKENS);
+			astAssert(
+				token == Token::Number ||
+				token == Token::StringLiteral ||
+				token == Token::UnicodeStringLiteral ||
+				token == Token::HexStringLiteral ||
+				token == Token::TrueLiteral ||
+				token == Token::FalseLiteral,
+				"Invalid literal kind in binary AST."
+			);
+			auto value = readString();
+			auto subDenomination = Literal::SubDenomination(m_in.enumValue(Token::NUM_TOKENS));
+			switch (subDenomination)
+			{
+			case Literal::SubDenomination::None:
+			case Literal::SubDenomination::Wei:
+			case Literal::SubDenomination::Gwei:
+			case Literal::SubDenomination::Ether:
+			case Literal::SubDenomination::Second:
+			case Literal::SubDenomination::Minute:
+			case Literal::SubDenomination::Hour:
+			case Literal::SubDenomination::Day:
+			case Literal::SubDenomination::Week:
+			case Literal::SubDenomination::Year:
+				break;
+			default:
+				astAssert(false, "Invalid subdenomination in binary AST.");
+			}
+			return create<Literal>(header, token, move(value), subDenomination);
+		}
+		}
+		astAssert(false, "Invalid node kind in binary AST.");
+		return nullptr;
+	}
+
+	template <class T, class... Args>
+	ASTPointer<T> create(Header const& _header, Args&&... _args)
+	{
+		return make_shared<T>(_header.id, _header.location, forward<Args>(_args)...);
+	}
+
+	/// Takes the node with the given one-based index, which has to be a @a T.
+	template <class T>
+	ASTPointer<T> take(uint64_t _reference)
+	{
+		astAssert(0 < _reference && _reference <= m_nodes.size(), "Invalid node reference in binary AST.");
+		ASTPointer<ASTNode>& slot = m_nodes[static_cast<size_t>(_reference - 1)];
+		astAssert(slot, "Node referenced twice in binary AST.");
+		astAssert(dynamic_cast<T*>(slot.get()), "Node of unexpected type in binary AST.");
+		ASTPointer<T> result = static_pointer_cast<T>(slot);
+		slot.reset();
+		return result;
+	}
+
+	template <class T>
+	ASTPointer<T> optionalNode()
+	{
+		uint64_t reference = m_in.varint();
+		return reference ? take<T>(reference) : nullptr;
+	}
+
+	template <class T>
+	ASTPointer<T> node() { return take<T>(m_in.varint()); }
+
+	template <class T>
+	vector<ASTPointer<T>> nodeList(bool _allowNull = false)
+	{
+		vector<ASTPointer<T>> nodes(m_in.count());
+		for (auto& element: nodes)
+			element = _allowNull ? optionalNode<T>() : node<T>();
+		return nodes;
+	}
+
+	template <class T>
+	unique_ptr<vector<ASTPointer<T>>> optionalNodeList()
+	{
+		if (!m_in.flag())
+			return nullptr;
+		return make_unique<vector<ASTPointer<T>>>(nodeList<T>());
+	}
+
+	/// @returns the string with the given index, which is shared by all nodes that refer to it.
+	ASTPointer<ASTString> const& readString()
+	{
+		uint64_t index = m_in.varint();
+		astAssert(index < m_strings.size(), "Invalid string index in binary AST.");
+		return m_strings[static_cast<size_t>(index)];
+	}
+
+	ASTPointer<ASTString> readOptionalString()
+	{
+		uint64_t index = m_in.varint();
+		if (!index)
+			return nullptr;
+		astAssert(index <= m_strings.size(), "Invalid string index in binary AST.");
+		return m_strings[static_cast<size_t>(index - 1)];
+	}
+
+	vector<ASTPointer<ASTString>> readStrings()
+	{
+		vector<ASTPointer<ASTString>> strings(m_in.count());
+		for (auto& str: strings)
+			str = readString();
+		return strings;
+	}
+
+	Reader m_in;
+	EVMVersion m_evmVersion;
+	vector<ASTPointer<ASTString>> m_strings;
+	shared_ptr<CharStream> m_source;
+	/// Nodes of the current source unit that have not been referenced yet.
+	vector<ASTPointer<ASTNode>> m_nodes;
+	/// IDs of all nodes, which are checked for duplicates at the end.
+	vector<int64_t> m_ids;
+};
+
+}
+
+std::string ASTBinaryFormat::encode(vector<Source> const& _sources)
+{
+	StringTable strings;
+	std::string body;
+	Writer sourceCount;
+	sourceCount.varint(_sources.size());
+	body += sourceCount.data;
+	for (Source const& source: _sources)
+	{
+		Writer header;
+		header.varint(strings.index(source.charStream->name()));
+		header.varint(source.charStream->source().size());
+		body += header.data;
+		body += source.charStream->source();
+		body += Encoder(strings).encode(*source.ast);
+	}
+
+	Writer out;
+	out.data = magic;
+	out.byte(version);
+	strings.write(out);
+	return out.data + body;
+}
+
+vector<ASTBinaryFormat::Source> ASTBinaryFormat::decode(std::string const& _data, EVMVersion _evmVersion)
+{
+	return Decoder(_data, _evmVersion).decode();
+}
+
+bool ASTBinaryFormat::isBinaryAST(std::string const& _data)
+{
+	return _data.compare(0, magic.size(), magic) == 0;
+}
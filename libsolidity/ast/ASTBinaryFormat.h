@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of the ASTs of a set of source units.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Binary format of parsed source units, which can be imported without parsing the sources again.
+ *
+ * The AST is written and read directly, without a JSON representation in between:
+ * All names and string values are stored once in a string table. The nodes of each source unit
+ * are stored in a node arena in post-order, so that every node refers to its children by their
+ * (smaller) index in the arena and the nodes can be created in a single pass. Node IDs, source
+ * locations, indices and enum values are varint-encoded.
+ *
+ * Layout: magic, version, string table (count, then length-prefixed strings),
+ * sources (count, then for each: name, source text, node count and nodes).
+ *
+ * The text of each source is stored as well, so that the imported source units are
+ * indistinguishable from the parsed ones, including their metadata and error messages.
+ */
+class ASTBinaryFormat
+{
+public:
+	/// Version of the format that is written by encode(). Other versions are rejected by decode().
+	static uint8_t constexpr version = 2;
+
+	struct Source
+	{
+		/// Name and text of the source, which the source locations of the AST refer to.
+		std::shared_ptr<langutil::CharStream> charStream;
+		ASTPointer<SourceUnit> ast;
+	};
+
+	/// @returns the binary encoding of the given source units, which have to have unique names.
+	static std::string encode(std::vector<Source> const& _sources);
+	/// Decodes data created by encode(). Inline assembly blocks are created for the given EVM version.
+	/// @throws InvalidAstError if the data is malformed or of a different version.
+	static std::vector<Source> decode(std::string const& _data, langutil::EVMVersion _evmVersion);
+
+	/// @returns true if @a _data starts with the magic of the binary AST format.
+	static bool isBinaryAST(std::string const& _data);
+};
+
+}
@@ -36,19 +36,29 @@ namespace solidity::frontend {
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @param _inlineAssemblyCache inline assembly snippets shared with the compilers of other contracts.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _inlineAssemblyCache),
+		m_context(_evmVersion, _revertStrings, &m_runtimeContext, _inlineAssemblyCache)
 	{ }
 
-	/// Compiles a contract.
+	/// Compiles a contract. The assembly is not optimised, see @a optimise.
 	/// @arg _metadata contains the to be injected metadata CBOR
 	void compileContract(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Runs the optimiser on the assembly of the compiled contract, which includes the
+	/// assemblies of the contracts it creates. Does not access the AST.
+	/// @param _threads maximal number of threads used to optimise independent sub-assemblies.
+	void optimise(size_t _threads = 1) { m_context.optimise(m_optimiserSettings, _threads); }
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
@@ -428,97 +428,125 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
+	// Several optimizer steps cannot handle externally supplied stack variables,
+	// so we essentially only optimize the ABI functions.
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	InlineAssemblyCache::Key cacheKey{_assembly, _sourceName, _localVariables, _externallyUsedFunctions, _system, optimize};
+	InlineAssemblyCache::Snippet const* snippet = m_inlineAssemblyCache ? m_inlineAssemblyCache->find(cacheKey) : nullptr;
+
+	// Cached snippets are parsed with a placeholder location that is replaced during code generation.
 	optional<langutil::SourceLocation> locationOverride;
+	optional<pair<langutil::SourceLocation, langutil::SourceLocation>> locationReplacement;
 	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
-	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
-		.parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
-
-	auto reportError = [&](string const& _context)
 	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n" +
-			_context + "\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatErrorInformation(*error);
-		message += "-------------------------------------------\n";
-
-		solAssert(false, message);
-	};
-
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
+		if (m_inlineAssemblyCache)
+		{
+			locationOverride = m_inlineAssemblyCache->placeholderLocation();
+			locationReplacement = make_pair(m_inlineAssemblyCache->placeholderLocation(), m_asm->currentSourceLocation());
+		}
+		else
+			locationOverride = m_asm->currentSourceLocation();
+	}
 
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	InlineAssemblyCache::Snippet parsedSnippet;
+	if (!snippet)
 	{
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
-
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
+		shared_ptr<yul::Block> parserResult =
+			yul::Parser(errorReporter, dialect, std::move(locationOverride))
+			.parse(scanner, false);
+#ifdef SOL_OUTPUT_ASM
+		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+#endif
 
-		if (_system)
+		auto reportError = [&](string const& _context)
 		{
-			// Store as generated sources, but first re-parse to update the source references.
-			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
-			string code = yul::AsmPrinter{dialect}(*obj.code);
-			scanner = make_shared<langutil::Scanner>(langutil::CharStream(m_generatedYulUtilityCode, _sourceName));
-			obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
-			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
-		}
+			string message =
+				"Error parsing/analyzing inline assembly block:\n" +
+				_context + "\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatErrorInformation(*error);
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		};
+
+		yul::AsmAnalysisInfo analysisInfo;
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				analysisInfo,
+				errorReporter,
+				dialect,
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		if (optimize)
+		{
+			yul::Object obj;
+			obj.code = parserResult;
+			obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+
+			optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+
+			if (_system)
+			{
+				// Store as generated sources, but first re-parse to update the source references.
+				parsedSnippet.generatedSource = yul::AsmPrinter(dialect)(*obj.code);
+				scanner = make_shared<langutil::Scanner>(langutil::CharStream(parsedSnippet.generatedSource, _sourceName));
+				obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
+				*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			}
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
+			analysisInfo = std::move(*obj.analysisInfo);
+			parserResult = std::move(obj.code);
 
 #ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+			cout << "After optimizer:" << endl;
+			cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
 #endif
+		}
+		else if (_system)
+			// Store as generated source.
+			parsedSnippet.generatedSource = _assembly;
+
+		if (!errorReporter.errors().empty())
+			reportError("Failed to analyze inline assembly block.");
+
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+		parsedSnippet.code = move(parserResult);
+		parsedSnippet.analysisInfo = make_shared<yul::AsmAnalysisInfo>(move(analysisInfo));
+		snippet = &parsedSnippet;
 	}
-	else if (_system)
+
+	if (_system)
 	{
-		// Store as generated source.
 		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
+		m_generatedYulUtilityCode = snippet->generatedSource;
 	}
 
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
-
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
+		*snippet->code,
+		*snippet->analysisInfo,
 		*m_asm,
 		m_evmVersion,
 		identifierAccess,
 		_system,
-		_optimiserSettings.optimizeStackAllocation
+		_optimiserSettings.optimizeStackAllocation,
+		move(locationReplacement)
 	);
 
+	if (m_inlineAssemblyCache && snippet == &parsedSnippet)
+		m_inlineAssemblyCache->insert(move(cacheKey), move(parsedSnippet));
+
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
 	updateSourceLocation();
 }
@@ -567,7 +595,7 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0, 1};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -60,13 +61,15 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_inlineAssemblyCache(std::move(_inlineAssemblyCache)),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -273,8 +276,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step, optimising independent sub-assemblies on up to @a _threads threads.
+	void optimise(OptimiserSettings const& _settings, size_t _threads = 1)
+	{
+		evmasm::Assembly::OptimiserSettings settings = translateOptimiserSettings(_settings);
+		settings.threads = _threads;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -380,6 +388,8 @@ private:
 	std::stack<ASTNode const*> m_visitedNodes;
 	/// The runtime context if in Creation mode, this is used for generating tags that would be stored into the storage and then used at runtime.
 	CompilerContext *m_runtimeContext;
+	/// Inline assembly snippets already parsed for this or other contracts, if shared.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 	/// The index of the runtime subroutine.
 	size_t m_runtimeSub = std::numeric_limits<size_t>::max();
 	/// An index of low-level function labels by name.
@@ -0,0 +1,43 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly snippets parsed by the legacy code generator.
+ */
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+#include <liblangutil/CharStream.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+InlineAssemblyCache::InlineAssemblyCache():
+	// Only the identity of the source matters, since locations are compared by their source pointer.
+	m_placeholderLocation{0, 0, make_shared<langutil::CharStream>("", "--CODEGEN-PLACEHOLDER--")}
+{
+}
+
+InlineAssemblyCache::Snippet const* InlineAssemblyCache::find(Key const& _key) const
+{
+	auto it = m_snippets.find(_key);
+	if (it == m_snippets.end())
+		return nullptr;
+	++m_hits;
+	return &it->second;
+}
@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly snippets parsed by the legacy code generator.
+ */
+
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace solidity::yul
+{
+struct AsmAnalysisInfo;
+struct Block;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Parsed, analysed and (if requested) optimized inline assembly snippets of the legacy
+ * code generator, shared by the contracts of one compilation.
+ * Snippets are identified by their code and the parameters of
+ * CompilerContext::appendInlineAssembly apart from the optimiser settings, the EVM version and
+ * the current source location, so the cache must not be used with different settings.
+ * Snippets that are not marked as system code are parsed with the @a placeholderLocation,
+ * which has to be replaced by the actual source location during code generation.
+ */
+class InlineAssemblyCache
+{
+public:
+	struct Key
+	{
+		std::string code;
+		std::string sourceName;
+		std::vector<std::string> localVariables;
+		std::set<std::string> externallyUsedFunctions;
+		bool system = false;
+		bool optimize = false;
+
+		bool operator<(Key const& _other) const
+		{
+			return
+				std::tie(code, sourceName, localVariables, externallyUsedFunctions, system, optimize) <
+				std::tie(_other.code, _other.sourceName, _other.localVariables, _other.externallyUsedFunctions, _other.system, _other.optimize);
+		}
+	};
+
+	struct Snippet
+	{
+		std::shared_ptr<yul::Block const> code;
+		std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+		/// Code stored as generated source for system snippets.
+		std::string generatedSource;
+	};
+
+	InlineAssemblyCache();
+
+	/// @returns the cached snippet for @a _key or nullptr if there is none.
+	Snippet const* find(Key const& _key) const;
+	void insert(Key _key, Snippet _snippet) { m_snippets[std::move(_key)] = std::move(_snippet); }
+
+	langutil::SourceLocation const& placeholderLocation() const { return m_placeholderLocation; }
+
+	/// @returns the number of snippets that were taken from the cache instead of being parsed.
+	size_t hits() const { return m_hits; }
+
+private:
+	std::map<Key, Snippet> m_snippets;
+	langutil::SourceLocation m_placeholderLocation;
+	mutable size_t m_hits = 0;
+};
+
+}
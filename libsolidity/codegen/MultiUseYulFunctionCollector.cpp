@@ -29,6 +29,12 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 
+MultiUseYulFunctionCache::Function const* MultiUseYulFunctionCache::find(string const& _name) const
+{
+	auto it = m_functions.find(_name);
+	return it == m_functions.end() ? nullptr : &it->second;
+}
+
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
 	string result;
@@ -44,6 +50,10 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	// The code of shared functions must not depend on functions that are not shared.
+	for (Creation& creation: m_creations)
+		creation.cacheable = false;
+
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions[_name] = "<<STUB<<";
@@ -54,3 +64,60 @@ string MultiUseYulFunctionCollector::createFunction(string const& _name, functio
 	}
 	return _name;
 }
+
+string MultiUseYulFunctionCollector::createSharedFunction(string const& _name, function<string ()> const& _creator)
+{
+	if (!m_cache)
+		return createFunction(_name, _creator);
+
+	addDependency(_name);
+	if (auto it = m_requestedFunctions.find(_name); it != m_requestedFunctions.end())
+	{
+		// Functions requesting a function that is not cached (e.g. because it is still being
+		// created) cannot be replayed from the cache.
+		if (!m_cache->find(_name))
+			for (Creation& creation: m_creations)
+				creation.cacheable = false;
+		return _name;
+	}
+
+	if (MultiUseYulFunctionCache::Function const* function = m_cache->find(_name))
+	{
+		m_cache->countHit();
+		addCachedFunction(_name, *function);
+		return _name;
+	}
+
+	m_requestedFunctions[_name] = "<<STUB<<";
+	m_creations.emplace_back();
+	string fun = _creator();
+	Creation creation = std::move(m_creations.back());
+	m_creations.pop_back();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+	if (creation.cacheable)
+		m_cache->insert(_name, {fun, std::move(creation.dependencies)});
+	m_requestedFunctions[_name] = std::move(fun);
+	return _name;
+}
+
+void MultiUseYulFunctionCollector::addDependency(string const& _name)
+{
+	if (!m_creations.empty())
+		m_creations.back().dependencies.push_back(_name);
+}
+
+void MultiUseYulFunctionCollector::addCachedFunction(
+	string const& _name,
+	MultiUseYulFunctionCache::Function const& _function
+)
+{
+	m_requestedFunctions[_name] = _function.code;
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			MultiUseYulFunctionCache::Function const* function = m_cache->find(dependency);
+			solAssert(function, "Dependency of cached function not cached.");
+			addCachedFunction(dependency, *function);
+		}
+}
@@ -24,11 +24,41 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Code of the shared multi-use functions created for the contracts of one compilation.
+ * Shared functions are only determined by their name, the EVM version and the revert
+ * strings setting, so the cache must not be used with different settings.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions requested while creating the function.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the cached function of the given name or nullptr if there is none.
+	Function const* find(std::string const& _name) const;
+	void insert(std::string const& _name, Function _function) { m_functions[_name] = std::move(_function); }
+
+	/// @returns the number of functions that were taken from the cache instead of being created.
+	size_t hits() const { return m_hits; }
+	void countHit() { ++m_hits; }
+
+private:
+	std::map<std::string, Function> m_functions;
+	size_t m_hits = 0;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -36,11 +66,24 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	MultiUseYulFunctionCollector() = default;
+	/// Creates a collector that takes shared functions from @a _cache instead of creating them
+	/// and stores the shared functions it creates in @a _cache.
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<MultiUseYulFunctionCache> _cache):
+		m_cache(std::move(_cache))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
+	/// Same as createFunction, but for functions that only depend on their name and the
+	/// settings of the compilation, like the utility and ABI functions. If the function is in
+	/// the cache, its code and the functions it requests are taken from there without
+	/// calling @a _creator.
+	std::string createSharedFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
 	/// @returns concatenation of all generated functions.
 	/// Guarantees that the order of functions in the generated code is deterministic and
 	/// platform-independent.
@@ -52,8 +95,25 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// Records @a _name as requested by the shared functions currently being created.
+	void addDependency(std::string const& _name);
+	/// Adds the cached function and, recursively, the functions it requests.
+	void addCachedFunction(std::string const& _name, MultiUseYulFunctionCache::Function const& _function);
+
+	/// Shared function currently being created.
+	struct Creation
+	{
+		std::vector<std::string> dependencies;
+		/// False if the function (indirectly) requests functions that are not shared
+		/// or that are still being created.
+		bool cacheable = true;
+	};
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<MultiUseYulFunctionCache> m_cache;
+	/// Shared functions currently being created, innermost last.
+	std::vector<Creation> m_creations;
 };
 
 }
@@ -128,7 +128,7 @@ void IRGenerationContext::initializeInternalDispatch(InternalDispatchMap _intern
 {
 	solAssert(internalDispatchClean(), "");
 
-	for (set<FunctionDefinition const*> const& functions: _internalDispatch | boost::adaptors::map_values)
+	for (auto const& functions: _internalDispatch | boost::adaptors::map_values)
 		for (auto function: functions)
 			enqueueFunctionForCodeGeneration(*function);
 
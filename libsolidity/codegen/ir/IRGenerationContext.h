@@ -44,7 +44,7 @@ namespace solidity::frontend
 class YulUtilFunctions;
 class ABIFunctions;
 
-using InternalDispatchMap = std::map<YulArity, std::set<FunctionDefinition const*>>;
+using InternalDispatchMap = std::map<YulArity, std::set<FunctionDefinition const*, ASTNode::CompareByID>>;
 
 /**
  * Class that contains contextual information during IR generation.
@@ -55,11 +55,13 @@ public:
 	IRGenerationContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
-		m_optimiserSettings(std::move(_optimiserSettings))
+		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_functions(std::move(_functionCache))
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
@@ -172,7 +174,7 @@ private:
 	/// The order and duplicates are irrelevant here (hence std::set rather than std::queue) as
 	/// long as the order of Yul functions in the generated code is deterministic and the same on
 	/// all platforms - which is a property guaranteed by MultiUseYulFunctionCollector.
-	std::set<FunctionDefinition const*> m_functionGenerationQueue;
+	std::set<FunctionDefinition const*, ASTNode::CompareByID> m_functionGenerationQueue;
 
 	/// Collection of functions that need to be callable via internal dispatch.
 	/// Note that having a key with an empty set of functions is a valid situation. It means that
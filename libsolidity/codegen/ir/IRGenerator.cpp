@@ -39,6 +39,10 @@
 
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/range/adaptor/map.hpp>
 
 #include <sstream>
@@ -48,32 +52,84 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(
+namespace
+{
+
+string const c_warning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+}
+
+string IRGenerator::runUnoptimized(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
 {
-	string const ir = yul::reindent(generate(_contract, _otherYulSources));
+	return c_warning + yul::reindent(generate(_contract, _otherYulSources));
+}
+
+unique_ptr<yul::AssemblyStack> IRGenerator::parse(
+	string const& _ir,
+	langutil::EVMVersion _evmVersion,
+	OptimiserSettings const& _optimiserSettings,
+	map<yul::YulString, shared_ptr<yul::Object const>> const& _optimizedSubObjects
+)
+{
+	solAssert(boost::starts_with(_ir, c_warning), "");
+	string const ir = _ir.substr(c_warning.size());
 
-	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
+	auto asmStack = make_unique<yul::AssemblyStack>(_evmVersion, yul::AssemblyStack::Language::StrictAssembly, _optimiserSettings);
+	if (!asmStack->parseAndAnalyze("", ir, _optimizedSubObjects))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: asmStack->errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
+	return asmStack;
+}
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+string IRGenerator::placeholderObject(ContractDefinition const& _contract)
+{
+	return "object \"" + IRNames::creationObject(_contract) + "\" { code { } }\n";
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::replacePlaceholders(
+	string const& _ir,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources
+)
+{
+	solAssert(boost::starts_with(_ir, c_warning), "");
+
+	map<string, string_view> replacements;
+	for (auto const& [contract, source]: _otherYulSources)
+		replacements.emplace(boost::trim_copy(placeholderObject(*contract)), source);
+
+	vector<string> lines;
+	boost::split(lines, _ir.substr(c_warning.size()), boost::is_any_of("\n"));
+	string code;
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		if (i > 0)
+			code += '\n';
+		auto replacement = replacements.find(boost::trim_copy(lines[i]));
+		if (replacement == replacements.end())
+			code += lines[i];
+		else
+			// The IR code of created contracts ends with a newline like the placeholder it replaces.
+			code += replacement->second.substr(0, replacement->second.size() - 1);
+	}
+	return c_warning + yul::reindent(code);
+}
+
+string IRGenerator::print(yul::AssemblyStack const& _stack)
+{
+	return c_warning + _stack.print();
 }
 
 string IRGenerator::generate(
@@ -142,6 +198,7 @@ string IRGenerator::generate(
 	InternalDispatchMap internalDispatchMap = generateInternalDispatchFunctions();
 	t("functions", m_context.functionCollector().requestedFunctions());
 	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
+	m_subObjectsCreated = m_context.subObjectsCreated();
 
 	// This has to be called only after all other code generation for the creation object is complete.
 	bool creationInvolvesAssembly = m_context.inlineAssemblySeen();
@@ -161,6 +218,7 @@ string IRGenerator::generate(
 	generateInternalDispatchFunctions();
 	t("runtimeFunctions", m_context.functionCollector().requestedFunctions());
 	t("runtimeSubObjects", subObjectSources(m_context.subObjectsCreated()));
+	m_subObjectsCreated.insert(m_context.subObjectsCreated().begin(), m_context.subObjectsCreated().end());
 
 	// This has to be called only after all other code generation for the runtime object is complete.
 	bool runtimeInvolvesAssembly = m_context.inlineAssemblySeen();
@@ -701,7 +759,7 @@ void IRGenerator::resetContext(ContractDefinition const& _contract)
 		m_context.internalDispatchClean(),
 		"Reset internal dispatch map without consuming it."
 	);
-	m_context = IRGenerationContext(m_evmVersion, m_context.revertStrings(), m_optimiserSettings);
+	m_context = IRGenerationContext(m_evmVersion, m_context.revertStrings(), m_optimiserSettings, m_functionCache);
 
 	m_context.setMostDerivedContract(_contract);
 	for (auto const& var: ContractType(_contract).stateVariables())
@@ -27,9 +27,18 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
+#include <libyul/YulString.h>
 #include <liblangutil/EVMVersion.h>
+#include <map>
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+class AssemblyStack;
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
@@ -41,21 +50,55 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
-		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
+		m_functionCache(std::move(_functionCache)),
+		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings), m_functionCache),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates and returns the unoptimized IR code.
+	std::string runUnoptimized(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
+	/// @returns the contracts whose objects are embedded into the code generated by @a runUnoptimized.
+	std::set<ContractDefinition const*, ASTNode::CompareByID> const& subObjectsCreated() const
+	{
+		return m_subObjectsCreated;
+	}
+
+	/// Parses and analyzes IR code returned by @a runUnoptimized.
+	/// @param _optimizedSubObjects already optimized objects of created contracts, which are
+	/// used instead of the respective sub-objects (usually placeholders) contained in @a _ir.
+	/// @returns the assembly stack holding the analyzed Yul object. Does not access the Solidity
+	/// AST or types and can thus be run concurrently for different contracts.
+	static std::unique_ptr<yul::AssemblyStack> parse(
+		std::string const& _ir,
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings const& _optimiserSettings,
+		std::map<yul::YulString, std::shared_ptr<yul::Object const>> const& _optimizedSubObjects = {}
+	);
+
+	/// @returns an empty object named like the creation object of @a _contract, which can be
+	/// passed to @a runUnoptimized instead of the IR code of @a _contract if the object is
+	/// replaced after parsing (see @a parse).
+	static std::string placeholderObject(ContractDefinition const& _contract);
+
+	/// @returns the IR code @a _ir returned by @a runUnoptimized with the placeholder objects
+	/// of the contracts in @a _otherYulSources replaced by their IR code.
+	static std::string replacePlaceholders(
+		std::string const& _ir,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+	);
+
+	/// @returns the IR code held by @a _stack in the form of the optimized IR output.
+	static std::string print(yul::AssemblyStack const& _stack);
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -108,9 +151,12 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	std::shared_ptr<MultiUseYulFunctionCache> const m_functionCache;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+	/// Contracts created in the creation or the runtime code.
+	std::set<ContractDefinition const*, ASTNode::CompareByID> m_subObjectsCreated;
 };
 
 }
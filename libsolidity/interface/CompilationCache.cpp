@@ -0,0 +1,195 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+string const c_entryDirectory = "solc-compilation-cache";
+string const c_entryExtension = ".json";
+string const c_temporaryExtension = ".tmp";
+/// Pattern of the names of temporary files, each % is replaced by a hex digit.
+string const c_temporaryPattern = "%%%%-%%%%-%%%%-%%%%" + c_temporaryExtension;
+/// Temporary files older than this (in seconds) are left over from processes that did not finish.
+time_t const c_staleTemporaryAge = 60 * 60;
+
+bool isHexDigit(char _c)
+{
+	return ('0' <= _c && _c <= '9') || ('a' <= _c && _c <= 'f');
+}
+
+/// @returns true if @a _name is the name of an entry, i.e. a key in hex followed by the extension.
+bool isEntryName(string const& _name)
+{
+	size_t const keyLength = 2 * size_t(util::h256::size);
+	return
+		_name.size() == keyLength + c_entryExtension.size() &&
+		all_of(_name.begin(), _name.begin() + keyLength, isHexDigit) &&
+		_name.compare(keyLength, string::npos, c_entryExtension) == 0;
+}
+
+/// @returns true if @a _name matches the pattern of the temporary files.
+bool isTemporaryName(string const& _name)
+{
+	if (_name.size() != c_temporaryPattern.size())
+		return false;
+	for (size_t i = 0; i < _name.size(); ++i)
+		if (c_temporaryPattern[i] == '%' ? !isHexDigit(_name[i]) : _name[i] != c_temporaryPattern[i])
+			return false;
+	return true;
+}
+
+}
+
+CompilationCache::CompilationCache(fs::path _directory, uint64_t _maxSize):
+	m_directory(std::move(_directory) / c_entryDirectory),
+	m_maxSize(_maxSize)
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+}
+
+optional<string> CompilationCache::load(util::h256 const& _key) const
+{
+	fs::path const path = entryPath(_key);
+	ifstream file(path.string(), ifstream::binary);
+	if (!file)
+		return nullopt;
+	string value{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+	if (file.bad())
+		return nullopt;
+
+	// The modification time serves as the time of last use for eviction.
+	boost::system::error_code error;
+	fs::last_write_time(path, time(nullptr), error);
+	return value;
+}
+
+void CompilationCache::store(util::h256 const& _key, string const& _value) const
+{
+	boost::system::error_code error;
+	fs::path const temporaryPath = m_directory / fs::unique_path(c_temporaryPattern, error);
+	if (error)
+		return;
+	{
+		ofstream file(temporaryPath.string(), ofstream::binary | ofstream::trunc);
+		file << _value;
+		if (!file.flush())
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::path const path = entryPath(_key);
+	uint64_t replacedSize = fs::file_size(path, error);
+	if (error)
+		replacedSize = 0;
+	// Renaming is atomic, so concurrent readers never observe a partially written entry.
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+
+	lock_guard<mutex> lock(m_mutex);
+	if (!m_totalSize)
+		m_totalSize = scan(nullopt);
+	else
+	{
+		*m_totalSize -= min(replacedSize, *m_totalSize);
+		*m_totalSize += _value.size();
+	}
+	if (*m_totalSize > m_maxSize)
+		// Evicting a bit more than needed means that the directory is not listed again
+		// for each of the next stores. Modification times only have a resolution of a second,
+		// so the entry just stored could otherwise be taken for the least recently used one.
+		m_totalSize = scan(m_maxSize - m_maxSize / 10, path);
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + c_entryExtension);
+}
+
+uint64_t CompilationCache::scan(optional<uint64_t> _targetSize, fs::path const& _keep) const
+{
+	time_t const now = time(nullptr);
+	vector<tuple<time_t, fs::path, uint64_t>> entries;
+	uint64_t totalSize = 0;
+	boost::system::error_code iterationError;
+	for (
+		fs::directory_iterator it(m_directory, iterationError), end;
+		!iterationError && it != end;
+		it.increment(iterationError)
+	)
+	{
+		boost::system::error_code error;
+		fs::path const& path = it->path();
+		string const name = path.filename().string();
+		bool const isTemporary = isTemporaryName(name);
+		if (!isTemporary && !isEntryName(name))
+			continue;
+		time_t lastUse = fs::last_write_time(path, error);
+		if (error)
+			continue;
+		if (isTemporary)
+		{
+			if (now - lastUse > c_staleTemporaryAge)
+				fs::remove(path, error);
+			continue;
+		}
+		uint64_t size = fs::file_size(path, error);
+		if (error)
+			continue;
+		entries.emplace_back(lastUse, path, size);
+		totalSize += size;
+	}
+
+	if (!_targetSize || totalSize <= *_targetSize)
+		return totalSize;
+	sort(entries.begin(), entries.end());
+	// Entries might be removed concurrently by other processes, so errors are ignored.
+	boost::system::error_code error;
+	for (auto const& entry: entries)
+	{
+		if (totalSize <= *_targetSize)
+			break;
+		if (get<1>(entry) == _keep)
+			continue;
+		fs::remove(get<1>(entry), error);
+		totalSize -= get<2>(entry);
+	}
+	return totalSize;
+}
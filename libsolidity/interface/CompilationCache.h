@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Content-addressed on-disk cache for compilation outputs.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Stores compilation outputs in a directory, one file per key.
+ *
+ * The files are kept in a subdirectory of the given directory that is owned by the cache, and
+ * only files named like entries or like the cache's temporary files are ever removed, so that
+ * pointing the cache at a directory holding other files does not affect them.
+ * The directory can be shared by several processes: entries are written to a temporary file
+ * first and then renamed, so readers either see a complete entry or none at all.
+ * Once the total size of the entries exceeds the limit, the least recently used ones are removed
+ * until it is below 90% of the limit. The total size is only determined by listing the directory
+ * for the first store and when evicting, otherwise it is tracked in memory. Changes made by other
+ * processes in between are noticed at the next eviction.
+ * The cache is best-effort: entries that cannot be read or written are treated as missing.
+ */
+class CompilationCache
+{
+public:
+	static constexpr uint64_t DefaultMaxSize = uint64_t(1) << 30;
+
+	/// @param _directory directory holding the subdirectory with the entries, both are created
+	/// if they do not exist.
+	/// @param _maxSize maximal total size of all entries in bytes.
+	explicit CompilationCache(boost::filesystem::path _directory, uint64_t _maxSize = DefaultMaxSize);
+
+	/// @returns the value stored for @a _key, if any, and marks the entry as recently used.
+	std::optional<std::string> load(util::h256 const& _key) const;
+	/// Stores @a _value for @a _key and removes least recently used entries if the cache became too large.
+	void store(util::h256 const& _key, std::string const& _value) const;
+
+	/// @returns the subdirectory holding the entries.
+	boost::filesystem::path const& entryDirectory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Lists the entry directory, removes stale temporary files and, if @a _targetSize is given,
+	/// least recently used entries other than @a _keep until their total size is at most
+	/// @a _targetSize.
+	/// @returns the total size of the remaining entries.
+	uint64_t scan(std::optional<uint64_t> _targetSize, boost::filesystem::path const& _keep = {}) const;
+
+	boost::filesystem::path m_directory;
+	uint64_t m_maxSize;
+	/// Protects m_totalSize.
+	mutable std::mutex m_mutex;
+	/// Estimated total size of the entries, unknown before the first store.
+	mutable std::optional<uint64_t> m_totalSize;
+};
+
+}
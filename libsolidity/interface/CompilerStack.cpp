@@ -43,6 +43,7 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/ast/ASTBinaryFormat.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
@@ -69,10 +70,18 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <utility>
 
 using namespace std;
@@ -138,6 +147,11 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setThreads(size_t _threads)
+{
+	m_threads = max<size_t>(_threads, 1);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -226,13 +240,22 @@ void CompilerStack::reset(bool _keepSettings)
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_nodeIDOutput = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_threads = 1;
+		m_profiler.reset();
 	}
+	m_resolver.reset();
 	m_globalContext.reset();
+	m_supersededASTs.clear();
+	m_yulFunctionCache.reset();
+	m_retainedWarnings.clear();
+	m_analysisSteps.clear();
+	m_lastNodeID = 0;
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
@@ -250,27 +273,178 @@ void CompilerStack::setSources(StringMap _sources)
 	m_stackState = SourcesSet;
 }
 
+bool CompilerStack::updateSources(StringMap _sources)
+{
+	// Superseded ASTs accumulate, so the stack is reset from time to time to free them,
+	// which bounds the memory to about three times that of the current sources.
+	bool const keepAnalysis =
+		m_stackState >= AnalysisPerformed &&
+		!m_hasError &&
+		!m_importedSources &&
+		m_resolver &&
+		Error::containsOnlyWarnings(m_errorReporter.errors()) &&
+		m_supersededASTs.size() <= 2 * m_sources.size();
+	if (!keepAnalysis)
+	{
+		reset(true);
+		setSources(move(_sources));
+		return false;
+	}
+
+	set<string> keptSources;
+	set<string> provisionalSources;
+	for (auto const& [path, source]: m_sources)
+	{
+		if (!source.analysed)
+			continue;
+		auto newSource = _sources.find(path);
+		if (newSource != _sources.end())
+		{
+			if (newSource->second == source.scanner->source())
+				keptSources.insert(path);
+		}
+		else if (source.loaded && m_readFile)
+		{
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), path);
+			if (result.success && result.responseOrErrorMessage == source.scanner->source())
+			{
+				keptSources.insert(path);
+				provisionalSources.insert(path);
+			}
+		}
+	}
+	// Sources importing a changed source have to be analysed again, and so do the sources importing them.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto it = keptSources.begin(); it != keptSources.end();)
+		{
+			bool importsChangedSource = false;
+			for (ASTPointer<ASTNode> const& node: m_sources.at(*it).ast->nodes())
+				if (auto import = dynamic_cast<ImportDirective const*>(node.get()))
+					if (!keptSources.count(*import->annotation().absolutePath))
+						importsChangedSource = true;
+			if (importsChangedSource)
+			{
+				it = keptSources.erase(it);
+				changed = true;
+			}
+			else
+				++it;
+		}
+	}
+
+	set<CharStream const*> keptStreams;
+	for (string const& path: keptSources)
+		keptStreams.insert(m_sources.at(path).scanner->charStream().get());
+	m_retainedWarnings.clear();
+	map<Error const*, size_t> analysisSteps;
+	for (auto const& error: m_errorReporter.errors())
+		if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error))
+			// Warnings reported after the analysis are reported again by the code generation.
+			if (keptStreams.count(location->source.get()) && m_analysisSteps.count(error.get()))
+			{
+				m_retainedWarnings.push_back(error);
+				analysisSteps[error.get()] = m_analysisSteps.at(error.get());
+			}
+	swap(m_analysisSteps, analysisSteps);
+
+	map<string const, Source> sources;
+	for (auto& [path, content]: _sources)
+		if (keptSources.count(path))
+		{
+			sources[path] = move(m_sources.at(path));
+			sources[path].loaded = false;
+		}
+		else
+			sources[path].scanner = make_shared<Scanner>(CharStream(move(content), path));
+	for (string const& path: provisionalSources)
+		if (keptSources.count(path))
+		{
+			sources[path] = move(m_sources.at(path));
+			sources[path].provisional = true;
+		}
+	for (auto const& [path, source]: m_sources)
+		if (!keptSources.count(path) && source.ast)
+			m_supersededASTs.push_back(source.ast);
+	swap(m_sources, sources);
+
+	m_sourceOrder.clear();
+	m_contracts.clear();
+	m_unhandledSMTLib2Queries.clear();
+	m_errorReporter.clear();
+	m_stackState = SourcesSet;
+	return true;
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
 
+	// Re-parsed sources receive other AST IDs than in a compilation from scratch. The names in
+	// the IR contain these IDs and the Yul optimiser orders by name, so the output would differ,
+	// as would the outputs containing the IDs themselves.
+	if (m_viaIR || m_generateIR || m_generateEwasm || m_nodeIDOutput)
+		discardKeptAnalysis();
+
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
+	m_errorReporter.append(m_retainedWarnings);
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	util::Profiler::Activation profilerActivation{m_profiler.get(), ""};
+	util::Profiler::Phase parsingPhase{"parsing"};
 
+	// Sources are parsed concurrently, each by its own parser, while the parsed sources are
+	// processed in the order of a sequential parse: their nodes are moved to the IDs they
+	// would have received and the sources they import are loaded and queued for parsing.
+	// The read callback is thus never called concurrently.
+	struct ParsedSource
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter{errors};
+		unique_ptr<Parser> parser;
+		ASTPointer<SourceUnit> ast;
+		exception_ptr exception;
+	};
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
-
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
-	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
+	vector<unique_ptr<ParsedSource>> parsedSources(sourcesToParse.size());
+	size_t nextToParse = 0;
+	size_t nextToProcess = 0;
+	bool processing = false;
+	bool failed = false;
+	mutex queueMutex;
+	condition_variable queueChanged;
+
+	auto parseSource = [&](size_t _index, shared_ptr<Scanner> const& _scanner) {
+		auto parsedSource = make_unique<ParsedSource>();
+		try
+		{
+			parsedSource->parser = make_unique<Parser>(parsedSource->errorReporter, m_evmVersion, m_parserErrorRecovery);
+			_scanner->reset();
+			parsedSource->ast = parsedSource->parser->parse(_scanner);
+		}
+		catch (...)
+		{
+			parsedSource->exception = current_exception();
+		}
+		lock_guard<mutex> lock(queueMutex);
+		parsedSources[_index] = move(parsedSource);
+	};
+	// Only called by one thread at a time.
+	auto processSource = [&](size_t _index, ParsedSource& _parsedSource) {
+		if (_parsedSource.exception)
+			rethrow_exception(_parsedSource.exception);
+		// Copied, since more sources can be queued while this one is processed.
+		string const path = sourcesToParse[_index];
+		Source& source = m_sources.at(path);
+		_parsedSource.parser->shiftNodeIDs(m_lastNodeID);
+		m_lastNodeID = _parsedSource.parser->lastNodeID();
+		m_errorReporter.append(_parsedSource.errors);
+		source.ast = _parsedSource.ast;
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
@@ -281,11 +455,72 @@ bool CompilerStack::parse()
 				{
 					string const& newPath = newSource.first;
 					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+					auto scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+					lock_guard<mutex> lock(queueMutex);
+					m_sources[newPath].scanner = move(scanner);
+					m_sources[newPath].loaded = true;
 					sourcesToParse.push_back(newPath);
+					parsedSources.emplace_back();
 				}
 		}
-	}
+	};
+
+	yul::YulStringRepository& repository = yul::YulStringRepository::instance();
+	thread::id const callingThread = this_thread::get_id();
+	util::parallelFor(m_threads, m_threads, [&](size_t) {
+		// Inline assembly blocks create Yul strings.
+		yul::YulStringRepository::Scope repositoryScope{repository};
+		double const cpuStart = m_profiler ? util::Profiler::threadCPUTime() : 0;
+		unique_lock<mutex> lock(queueMutex);
+		while (!failed && nextToProcess < sourcesToParse.size())
+			if (!processing && parsedSources[nextToProcess])
+			{
+				size_t index = nextToProcess;
+				unique_ptr<ParsedSource> parsedSource = move(parsedSources[index]);
+				processing = true;
+				lock.unlock();
+				try
+				{
+					if (parsedSource->parser)
+						processSource(index, *parsedSource);
+				}
+				catch (...)
+				{
+					lock.lock();
+					failed = true;
+					queueChanged.notify_all();
+					throw;
+				}
+				lock.lock();
+				processing = false;
+				nextToProcess++;
+				queueChanged.notify_all();
+			}
+			else if (nextToParse < sourcesToParse.size())
+			{
+				size_t index = nextToParse++;
+				Source const& source = m_sources.at(sourcesToParse[index]);
+				if (source.analysed)
+				{
+					parsedSources[index] = make_unique<ParsedSource>();
+					continue;
+				}
+				shared_ptr<Scanner> scanner = source.scanner;
+				lock.unlock();
+				parseSource(index, scanner);
+				lock.lock();
+				queueChanged.notify_all();
+			}
+			else
+				queueChanged.wait(lock);
+		// The CPU time of the calling thread is measured by the phase itself.
+		if (m_profiler && this_thread::get_id() != callingThread)
+			parsingPhase.addCPUTime(util::Profiler::threadCPUTime() - cpuStart);
+	});
+	parsingPhase.stop();
+
+	if (m_stopAfter >= ParsedAndImported)
+		dropUnusedProvisionalSources();
 
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
@@ -321,13 +556,44 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	storeContractDefinitions();
 }
 
+void CompilerStack::importBinaryAST(string const& _data)
+{
+	if (m_stackState != Empty)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call importBinaryAST only before the SourcesSet state."));
+	for (ASTBinaryFormat::Source& source: ASTBinaryFormat::decode(_data, m_evmVersion))
+	{
+		Source& target = m_sources[source.charStream->name()];
+		target.scanner = make_shared<Scanner>(source.charStream);
+		target.ast = move(source.ast);
+	}
+	// The sources are the ones the ASTs were parsed from, so unlike after importASTs(),
+	// the metadata does not differ from a compilation of the sources.
+	m_stackState = ParsedAndImported;
+
+	storeContractDefinitions();
+}
+
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
 	resolveImports();
 
+	// Sources kept by updateSources() have been analysed already.
+	vector<Source const*> sourcesToAnalyse;
 	for (Source const* source: m_sourceOrder)
+		if (!source->analysed)
+			sourcesToAnalyse.push_back(source);
+	// Each step reports its errors in the order of the sources. The steps are numbered to sort
+	// in the warnings retained for kept sources where analysing them again would report them.
+	m_analysisStepStarts.clear();
+	auto nextStep = [&]() { m_analysisStepStarts.push_back(m_errorReporter.errors().size()); };
+	ScopeGuard orderWarnings([&]() { orderRetainedWarnings(); });
+
+	util::Profiler::Activation profilerActivation{m_profiler.get(), ""};
+	util::Profiler::Phase phase{"analysis/scoper"};
+	nextStep();
+	for (Source const* source: sourcesToAnalyse)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
 
@@ -335,38 +601,57 @@ bool CompilerStack::analyze()
 
 	try
 	{
+		phase.restart("analysis/syntaxChecker");
+		nextStep();
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
+		phase.restart("analysis/docStringTagParser");
+		nextStep();
 		DocStringTagParser DocStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !DocStringTagParser.parseDocStrings(*source->ast))
 				noErrors = false;
 
-		m_globalContext = make_shared<GlobalContext>();
-		// We need to keep the same resolver during the whole process.
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		phase.restart("analysis/nameAndTypeResolver");
+		nextStep();
+		// We need to keep the same resolver during the whole process, including later updates of the sources.
+		if (!m_resolver)
+		{
+			m_globalContext = make_shared<GlobalContext>();
+			m_resolver = make_unique<NameAndTypeResolver>(*m_globalContext, m_evmVersion, m_errorReporter);
+		}
+		NameAndTypeResolver& resolver = *m_resolver;
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.registerDeclarations(*source->ast))
 				return false;
 
+		nextStep();
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
 				return false;
 
-		resolver.warnHomonymDeclarations();
+		nextStep();
+		set<SourceUnit const*> sourceUnits;
+		for (Source const* source: sourcesToAnalyse)
+			if (source->ast)
+				sourceUnits.insert(source->ast.get());
+		resolver.warnHomonymDeclarations(sourceUnits);
 
-		for (Source const* source: m_sourceOrder)
+		nextStep();
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		phase.restart("analysis/declarationTypeChecker");
+		nextStep();
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
@@ -374,15 +659,19 @@ bool CompilerStack::analyze()
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		phase.restart("analysis/contractLevelChecker");
+		nextStep();
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (auto sourceAst = source->ast)
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
+		phase.restart("analysis/docStringAnalyser");
+		nextStep();
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 
@@ -393,18 +682,23 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		phase.restart("analysis/typeChecker");
+		nextStep();
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			phase.restart("analysis/postTypeChecker");
+			nextStep();
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !postTypeChecker.check(*source->ast))
 					noErrors = false;
+			nextStep();
 			if (!postTypeChecker.finalize())
 				noErrors = false;
 		}
@@ -412,25 +706,32 @@ bool CompilerStack::analyze()
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+		{
+			phase.restart("analysis/immutableValidator");
+			nextStep();
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+		}
 
 		if (noErrors)
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			phase.restart("analysis/controlFlowAnalyzer");
+			nextStep();
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !cfg.constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
+				nextStep();
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
+				for (Source const* source: sourcesToAnalyse)
 					if (source->ast && !controlFlowAnalyzer.analyze(*source->ast))
 						noErrors = false;
 			}
@@ -439,8 +740,10 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			phase.restart("analysis/staticAnalyzer");
+			nextStep();
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
@@ -448,8 +751,10 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			phase.restart("analysis/viewPureChecker");
+			nextStep();
 			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					ast.push_back(source->ast);
 
@@ -459,8 +764,10 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			phase.restart("analysis/modelChecker");
+			nextStep();
 			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
@@ -472,14 +779,109 @@ bool CompilerStack::analyze()
 			throw; // Something is weird here, rather throw again.
 		noErrors = false;
 	}
+	phase.stop();
 
 	m_stackState = AnalysisPerformed;
 	if (!noErrors)
 		m_hasError = true;
+	else
+	{
+		set<Source const*> analysedSources(m_sourceOrder.begin(), m_sourceOrder.end());
+		for (auto& [path, source]: m_sources)
+			if (source.ast && analysedSources.count(&source))
+				source.analysed = true;
+	}
 
 	return !m_hasError;
 }
 
+void CompilerStack::dropRepeatedRetainedWarnings()
+{
+	if (m_retainedWarnings.empty())
+		return;
+
+	auto key = [](Error const& _error) {
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error);
+		string const* comment = _error.comment();
+		return make_tuple(
+			_error.errorId().error,
+			location ? location->source.get() : nullptr,
+			location ? location->start : -1,
+			location ? location->end : -1,
+			comment ? *comment : string{}
+		);
+	};
+	set<Error const*> retained;
+	set<decltype(key(declval<Error>()))> retainedKeys;
+	for (auto const& warning: m_retainedWarnings)
+	{
+		retained.insert(warning.get());
+		retainedKeys.insert(key(*warning));
+	}
+
+	ErrorList errors;
+	for (auto const& error: m_errorReporter.errors())
+		if (retained.count(error.get()) || !retainedKeys.count(key(*error)))
+			errors.push_back(error);
+	if (errors.size() != m_errorReporter.errors().size())
+	{
+		m_errorReporter.clear();
+		m_errorReporter.append(errors);
+	}
+}
+
+void CompilerStack::orderRetainedWarnings()
+{
+	ErrorList const& errors = m_errorReporter.errors();
+	set<Error const*> retained;
+	for (auto const& warning: m_retainedWarnings)
+		retained.insert(warning.get());
+	for (size_t i = 0; i < errors.size(); ++i)
+		if (!retained.count(errors[i].get()))
+			m_analysisSteps[errors[i].get()] = static_cast<size_t>(
+				upper_bound(m_analysisStepStarts.begin(), m_analysisStepStarts.end(), i) - m_analysisStepStarts.begin()
+			);
+	if (m_retainedWarnings.empty())
+		return;
+
+	// The analysis steps following a failed one are skipped, and so are their warnings.
+	m_retainedWarnings.erase(
+		remove_if(m_retainedWarnings.begin(), m_retainedWarnings.end(), [&](shared_ptr<Error const> const& _warning) {
+			return m_analysisSteps.at(_warning.get()) > m_analysisStepStarts.size();
+		}),
+		m_retainedWarnings.end()
+	);
+	ErrorList reported;
+	for (auto const& error: errors)
+		if (!retained.count(error.get()))
+			reported.push_back(error);
+	m_errorReporter.clear();
+	m_errorReporter.append(reported);
+	dropRepeatedRetainedWarnings();
+
+	map<CharStream const*, size_t> sourceRanks;
+	for (size_t i = 0; i < m_sourceOrder.size(); ++i)
+		sourceRanks[m_sourceOrder[i]->scanner->charStream().get()] = i + 1;
+	auto key = [&](Error const& _error) {
+		size_t rank = 0;
+		if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error))
+			if (auto it = sourceRanks.find(location->source.get()); it != sourceRanks.end())
+				rank = it->second;
+		return make_pair(m_analysisSteps.at(&_error), rank);
+	};
+	ErrorList merged;
+	merge(
+		m_errorReporter.errors().begin(),
+		m_errorReporter.errors().end(),
+		m_retainedWarnings.begin(),
+		m_retainedWarnings.end(),
+		back_inserter(merged),
+		[&](auto const& _retained, auto const& _reported) { return key(*_retained) < key(*_reported); }
+	);
+	m_errorReporter.clear();
+	m_errorReporter.append(merged);
+}
+
 bool CompilerStack::parseAndAnalyze(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -532,56 +934,137 @@ bool CompilerStack::compile(State _stopAfter)
 
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-
+	vector<ContractDefinition const*> legacyContracts;
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	bool const generateYul = m_viaIR || m_generateIR || m_generateEwasm;
+	// Utility and ABI functions used by several contracts are only created once.
+	m_yulFunctionCache = generateYul ? make_shared<MultiUseYulFunctionCache>() : nullptr;
+	// Inline assembly snippets of the legacy code generator are only parsed once.
+	auto inlineAssemblyCache = make_shared<InlineAssemblyCache>();
+	try
+	{
+		// Code generation from the AST is performed sequentially in dependency order,
+		// since it accesses (and lazily fills) AST annotations and the global type provider.
+		for (ContractDefinition const* contract: requestedContracts)
+		{
+			if (generateYul)
+				generateIR(*contract, m_yulFunctionCache);
+			if (m_generateEvmBytecode && !m_viaIR)
+				compileContract(*contract, otherCompilers, legacyContracts, inlineAssemblyCache);
+		}
+
+		inlineAssemblyCache.reset();
+
+		if (!legacyContracts.empty())
+			assembleContracts(legacyContracts);
+
+		if (generateYul)
+		{
+			// Everything that follows only depends on the IR code of the respective contract
+			// and the optimized objects of the contracts it creates, so the contracts can be
+			// processed concurrently. Created contracts precede the contracts creating them and,
+			// since parallelFor hands out indices in increasing order, their optimization has
+			// always started when a contract waits for it.
+			vector<ContractDefinition const*> irContracts;
+			map<ContractDefinition const*, size_t> irContractIndices;
+			set<ContractDefinition const*> embeddedContracts;
+			std::function<void(ContractDefinition const&)> addIRContract = [&](ContractDefinition const& _contract) {
+				Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+				if (compiledContract.yulIRWithPlaceholders.empty() || irContractIndices.count(&_contract))
+					return;
+				for (auto const* subObject: compiledContract.yulSubObjects)
 				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
+					addIRContract(*subObject);
+					embeddedContracts.insert(subObject);
+				}
+				irContractIndices[&_contract] = irContracts.size();
+				irContracts.push_back(&_contract);
+			};
+			for (auto const& contract: m_contracts)
+				addIRContract(*contract.second.contract);
+
+			// The object of each created contract, optimized as a sub-object exactly like it would
+			// be as part of each contract creating it, and shared by all of them.
+			vector<promise<shared_ptr<yul::Object const>>> embeddedObjects(irContracts.size());
+			vector<shared_future<shared_ptr<yul::Object const>>> sharedEmbeddedObjects;
+			for (auto& embeddedObject: embeddedObjects)
+				sharedEmbeddedObjects.emplace_back(embeddedObject.get_future().share());
+
+			// Threads not needed for the contracts themselves are used to optimise their functions.
+			size_t optimiserThreads = max<size_t>(1, m_threads / max<size_t>(1, irContracts.size()));
+			yul::YulStringRepository& repository = yul::YulStringRepository::instance();
+			util::parallelFor(irContracts.size(), m_threads, [&](size_t _index) {
+				yul::YulStringRepository::Scope repositoryScope{repository};
+				ContractDefinition const& contract = *irContracts[_index];
+				util::Profiler::Activation profilerActivation{m_profiler.get(), contract.fullyQualifiedName()};
+				unique_ptr<yul::AssemblyStack> optimizedIR;
+				try
+				{
+					map<yul::YulString, shared_ptr<yul::Object const>> optimizedSubObjects;
+					for (auto const* subObject: m_contracts.at(contract.fullyQualifiedName()).yulSubObjects)
 					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
+						shared_ptr<yul::Object const> object = sharedEmbeddedObjects[irContractIndices.at(subObject)].get();
+						optimizedSubObjects[object->name] = move(object);
 					}
+					shared_ptr<yul::Object const> embeddedObject;
+					tie(optimizedIR, embeddedObject) = optimizeIR(
+						contract,
+						optimiserThreads,
+						optimizedSubObjects,
+						embeddedContracts.count(&contract)
+					);
+					embeddedObjects[_index].set_value(move(embeddedObject));
 				}
+				catch (...)
+				{
+					embeddedObjects[_index].set_exception(current_exception());
+					throw;
+				}
+				// The optimized IR is handed on in parsed form instead of being printed and re-parsed.
+				if (!isRequestedContract(contract))
+					return;
+				if (m_generateEvmBytecode && m_viaIR)
+					generateEVMFromIR(contract, *optimizedIR);
+				if (m_generateEwasm)
+					generateEwasm(contract, *optimizedIR);
+			});
+		}
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -954,6 +1437,21 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+string CompilerStack::binaryAST() const
+{
+	if (m_stackState < Parsed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing not yet performed."));
+
+	vector<ASTBinaryFormat::Source> sources;
+	for (auto const& source: m_sources)
+	{
+		if (!source.second.ast)
+			BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing was not successful."));
+		sources.push_back({source.second.scanner->charStream(), source.second.ast});
+	}
+	return ASTBinaryFormat::encode(sources);
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1135,6 +1633,90 @@ void CompilerStack::resolveImports()
 	swap(m_sourceOrder, sourceOrder);
 }
 
+void CompilerStack::discardKeptAnalysis()
+{
+	if (!m_resolver)
+		return;
+
+	for (auto it = m_sources.begin(); it != m_sources.end();)
+		if (it->second.provisional)
+			it = m_sources.erase(it);
+		else
+		{
+			it->second.ast.reset();
+			it->second.analysed = false;
+			++it;
+		}
+	m_resolver.reset();
+	m_globalContext.reset();
+	m_supersededASTs.clear();
+	m_retainedWarnings.clear();
+	m_analysisSteps.clear();
+	m_lastNodeID = 0;
+	TypeProvider::reset();
+}
+
+void CompilerStack::dropUnusedProvisionalSources()
+{
+	vector<string> toVisit;
+	set<string> used;
+	for (auto const& [path, source]: m_sources)
+		if (!source.provisional)
+		{
+			toVisit.push_back(path);
+			used.insert(path);
+		}
+	while (!toVisit.empty())
+	{
+		Source const& source = m_sources.at(toVisit.back());
+		toVisit.pop_back();
+		if (source.ast)
+			for (ASTPointer<ASTNode> const& node: source.ast->nodes())
+				if (auto import = dynamic_cast<ImportDirective const*>(node.get()))
+					if (
+						import->annotation().absolutePath.set() &&
+						m_sources.count(*import->annotation().absolutePath) &&
+						used.insert(*import->annotation().absolutePath).second
+					)
+						toVisit.push_back(*import->annotation().absolutePath);
+	}
+
+	set<CharStream const*> droppedStreams;
+	for (auto it = m_sources.begin(); it != m_sources.end();)
+		if (!it->second.provisional)
+			++it;
+		else if (used.count(it->first))
+		{
+			it->second.provisional = false;
+			++it;
+		}
+		else
+		{
+			if (it->second.ast)
+				m_supersededASTs.push_back(it->second.ast);
+			droppedStreams.insert(it->second.scanner->charStream().get());
+			it = m_sources.erase(it);
+		}
+	if (droppedStreams.empty())
+		return;
+
+	// The warnings about the dropped sources were retained by updateSources().
+	auto inDroppedSource = [&](shared_ptr<Error const> const& _error) {
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*_error);
+		return location && droppedStreams.count(location->source.get());
+	};
+	ErrorList errors;
+	for (auto const& error: m_errorReporter.errors())
+		if (!inDroppedSource(error))
+			errors.push_back(error);
+	m_errorReporter.clear();
+	m_errorReporter.append(errors);
+	m_retainedWarnings.erase(
+		remove_if(m_retainedWarnings.begin(), m_retainedWarnings.end(), inDroppedSource),
+		m_retainedWarnings.end()
+	);
+}
+
 void CompilerStack::storeContractDefinitions()
 {
 	for (auto const& pair: m_sources)
@@ -1166,7 +1748,9 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	vector<ContractDefinition const*>& _compiledContracts,
+	shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache
 )
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1177,93 +1761,217 @@ void CompilerStack::compileContract(
 		return;
 
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _compiledContracts, _inlineAssemblyCache);
 
 	if (!_contract.canBeDeployed())
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	util::Profiler::Activation profilerActivation{m_profiler.get(), _contract.fullyQualifiedName()};
+	util::Profiler::Phase phase{"codeGeneration"};
+
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		_inlineAssemblyCache
+	);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
 
-	try
-	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
-	}
-	catch(evmasm::OptimizerException const&)
-	{
-		solAssert(false, "Optimizer exception during compilation");
-	}
+	compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
 
-	try
-	{
-		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiler->assembledObject();
-	}
-	catch(evmasm::AssemblyException const&)
-	{
-		solAssert(false, "Assembly exception for bytecode");
-	}
+	_compiledContracts.push_back(&_contract);
+	_otherCompilers[compiledContract.contract] = compiler;
+}
 
-	try
+void CompilerStack::assembleContracts(vector<ContractDefinition const*> const& _contracts)
+{
+	// The assembly of a contract embeds the assemblies of the contracts it creates, which are
+	// optimised again and assembled as part of it. A contract therefore waits for the contracts
+	// before it that share an assembly with it, which keeps the order in which each assembly is
+	// modified independent of the number of threads. Since parallelFor hands out indices in
+	// increasing order, the contracts waited for have always started.
+	vector<set<evmasm::Assembly const*>> assemblies(_contracts.size());
+	std::function<void(evmasm::Assembly const&, set<evmasm::Assembly const*>&)> collectAssemblies =
+		[&](evmasm::Assembly const& _assembly, set<evmasm::Assembly const*>& _assemblies) {
+			if (_assemblies.insert(&_assembly).second)
+				for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+					collectAssemblies(_assembly.sub(subId), _assemblies);
+		};
+	map<evmasm::Assembly const*, vector<size_t>> contractsByAssembly;
+	vector<set<size_t>> predecessors(_contracts.size());
+	for (size_t index = 0; index < _contracts.size(); ++index)
 	{
-		// Assemble runtime object.
-		compiledContract.runtimeObject = compiler->runtimeObject();
-	}
-	catch(evmasm::AssemblyException const&)
-	{
-		solAssert(false, "Assembly exception for deployed bytecode");
+		Contract const& compiledContract = m_contracts.at(_contracts[index]->fullyQualifiedName());
+		collectAssemblies(compiledContract.compiler->assembly(), assemblies[index]);
+		for (evmasm::Assembly const* assembly: assemblies[index])
+		{
+			vector<size_t>& users = contractsByAssembly[assembly];
+			predecessors[index] += users;
+			users.push_back(index);
+		}
 	}
 
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation initialization returns data with length of more than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			5574_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
+	vector<promise<void>> done(_contracts.size());
+	vector<shared_future<void>> sharedDone;
+	for (auto& contractDone: done)
+		sharedDone.emplace_back(contractDone.get_future().share());
+
+	// Threads not needed for the contracts themselves are used to optimise their sub-assemblies.
+	size_t optimiserThreads = max<size_t>(1, m_threads / _contracts.size());
+	util::parallelFor(_contracts.size(), m_threads, [&](size_t _index) {
+		ContractDefinition const& contract = *_contracts[_index];
+		Contract& compiledContract = m_contracts.at(contract.fullyQualifiedName());
+		util::Profiler::Activation profilerActivation{m_profiler.get(), contract.fullyQualifiedName()};
+		try
+		{
+			for (size_t predecessor: predecessors[_index])
+				sharedDone[predecessor].get();
 
-	_otherCompilers[compiledContract.contract] = compiler;
+			util::Profiler::Phase phase{"assembling"};
+			try
+			{
+				// Run optimiser on the contract including the contracts it creates.
+				compiledContract.compiler->optimise(optimiserThreads);
+			}
+			catch(evmasm::OptimizerException const&)
+			{
+				solAssert(false, "Optimizer exception during compilation");
+			}
+
+			try
+			{
+				// Assemble deployment (incl. runtime)  object.
+				compiledContract.object = compiledContract.compiler->assembledObject();
+			}
+			catch(evmasm::AssemblyException const&)
+			{
+				solAssert(false, "Assembly exception for bytecode");
+			}
+
+			try
+			{
+				// Assemble runtime object.
+				compiledContract.runtimeObject = compiledContract.compiler->runtimeObject();
+			}
+			catch(evmasm::AssemblyException const&)
+			{
+				solAssert(false, "Assembly exception for deployed bytecode");
+			}
+			done[_index].set_value();
+		}
+		catch (...)
+		{
+			done[_index].set_exception(current_exception());
+			throw;
+		}
+	});
+
+	for (ContractDefinition const* contract: _contracts)
+		// Throw a warning if EIP-170 limits are exceeded:
+		//   If contract creation initialization returns data with length of more than 0x6000 (214 + 213) bytes,
+		//   contract creation fails with an out of gas error.
+		if (
+			m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
+			m_contracts.at(contract->fullyQualifiedName()).runtimeObject.bytecode.size() > 0x6000
+		)
+			m_errorReporter.warning(
+				5574_error,
+				contract->location(),
+				"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
+				"This contract may not be deployable on mainnet. "
+				"Consider enabling the optimizer (with a low \"runs\" value!), "
+				"turning off revert strings, or using libraries."
+			);
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract)
+void CompilerStack::generateIR(
+	ContractDefinition const& _contract,
+	shared_ptr<MultiUseYulFunctionCache> const& _functionCache
+)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called generateIR with errors."));
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	if (!compiledContract.yulIR.empty())
+	if (!compiledContract.yulIRWithPlaceholders.empty())
 		return;
 
-	string dependenciesSource;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		generateIR(*dependency);
+		generateIR(*dependency, _functionCache);
 
 	if (!_contract.canBeDeployed())
 		return;
 
-	map<ContractDefinition const*, string_view const> otherYulSources;
-	for (auto const& pair: m_contracts)
-		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
+	// Contracts created in functions of base contracts are only dependencies of the base contracts.
+	set<ContractDefinition const*> dependencies;
+	std::function<void(ContractDefinition const&)> addDependencies = [&](ContractDefinition const& _dependent) {
+		for (auto const* dependency: _dependent.annotation().contractDependencies)
+			if (dependencies.insert(dependency).second)
+				addDependencies(*dependency);
+	};
+	addDependencies(_contract);
+
+	// The objects of created contracts are optimized on their own and inserted after parsing,
+	// so only placeholders are needed in the code that is optimized.
+	map<ContractDefinition const*, string> placeholders;
+	for (auto const* dependency: dependencies)
+		placeholders.emplace(dependency, IRGenerator::placeholderObject(*dependency));
+	util::Profiler::Activation profilerActivation{m_profiler.get(), _contract.fullyQualifiedName()};
+	util::Profiler::Phase phase{"irGeneration"};
+	map<ContractDefinition const*, string_view const> placeholderSources(placeholders.begin(), placeholders.end());
+
+	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, _functionCache);
+	compiledContract.yulIRWithPlaceholders = generator.runUnoptimized(_contract, placeholderSources);
+	compiledContract.yulSubObjects.assign(generator.subObjectsCreated().begin(), generator.subObjectsCreated().end());
+
+	// The IR output contains the complete objects of created contracts, which are inserted as text
+	// instead of generating the code of the contract a second time.
+	if (m_generateIR)
+	{
+		map<ContractDefinition const*, string_view const> otherYulSources;
+		for (auto const* dependency: dependencies)
+			otherYulSources.emplace(dependency, m_contracts.at(dependency->fullyQualifiedName()).yulIR);
+		compiledContract.yulIR = IRGenerator::replacePlaceholders(compiledContract.yulIRWithPlaceholders, otherYulSources);
+	}
+}
+
+pair<unique_ptr<yul::AssemblyStack>, shared_ptr<yul::Object const>> CompilerStack::optimizeIR(
+	ContractDefinition const& _contract,
+	size_t _threads,
+	map<yul::YulString, shared_ptr<yul::Object const>> const& _optimizedSubObjects,
+	bool _embedded
+)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(!compiledContract.yulIRWithPlaceholders.empty(), "");
+
+	OptimiserSettings optimiserSettings = m_optimiserSettings;
+	optimiserSettings.yulOptimiserThreads = _threads;
+	util::Profiler::Phase phase{"irParsing"};
+	unique_ptr<yul::AssemblyStack> stack = IRGenerator::parse(
+		compiledContract.yulIRWithPlaceholders,
+		m_evmVersion,
+		optimiserSettings,
+		_optimizedSubObjects
+	);
+	phase.stop();
+	shared_ptr<yul::Object const> embeddedObject;
+	if (_embedded)
+		embeddedObject = stack->optimizeForEmbedding();
+	else
+		stack->optimize();
+	if (m_generateIR)
+		compiledContract.yulIROptimized = IRGenerator::print(*stack);
+	return {move(stack), move(embeddedObject)};
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, yul::AssemblyStack const& _stack)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1273,19 +1981,15 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	//cout << yul::AsmPrinter{}(*_stack.parserResult()->code) << endl;
 
 	// TODO: support passing metadata
-	auto result = stack.assemble(yul::AssemblyStack::Machine::EVM);
+	util::Profiler::Phase phase{"evmCodeGeneration"};
+	auto result = _stack.assemble(yul::AssemblyStack::Machine::EVM);
+	phase.stop();
 	compiledContract.object = std::move(*result.bytecode);
 	// TODO: support runtimeObject
 	// TODO: add EIP-170 size check for runtimeObject
@@ -1293,7 +1997,7 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	//       assemblyString, assemblyJSON, and functionEntryPoints to work with this code path
 }
 
-void CompilerStack::generateEwasm(ContractDefinition const& _contract)
+void CompilerStack::generateEwasm(ContractDefinition const& _contract, yul::AssemblyStack& _stack)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1303,22 +2007,16 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.ewasm.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-
-	stack.optimize();
-	stack.translate(yul::AssemblyStack::Language::Ewasm);
-	stack.optimize();
+	_stack.translate(yul::AssemblyStack::Language::Ewasm);
+	_stack.optimize();
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	//cout << yul::AsmPrinter{}(*_stack.parserResult()->code) << endl;
 
 	// Turn into Ewasm text representation.
-	auto result = stack.assemble(yul::AssemblyStack::Machine::Ewasm);
+	auto result = _stack.assemble(yul::AssemblyStack::Machine::Ewasm);
 	compiledContract.ewasm = std::move(result.assembly);
 	compiledContract.ewasmObject = std::move(*result.bytecode);
 }
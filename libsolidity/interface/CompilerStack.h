@@ -59,6 +59,18 @@ class Scanner;
 }
 
 
+namespace solidity::yul
+{
+class AssemblyStack;
+class YulString;
+struct Object;
+}
+
+namespace solidity::util
+{
+class Profiler;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -76,8 +88,11 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class MultiUseYulFunctionCache;
+class InlineAssemblyCache;
 class Natspec;
 class DeclarationContainer;
+class NameAndTypeResolver;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -166,6 +181,15 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximal number of threads used to process independent contracts (and, in the
+	/// Yul optimiser, independent functions and, in the EVM assembly optimiser, independent
+	/// sub-assemblies) concurrently during compilation.
+	/// The output does not depend on this setting. Defaults to one.
+	void setThreads(size_t _threads = 1);
+
+	/// Sets a profiler that measures the phases of parsing, analysis and compilation, or none.
+	void setProfiler(std::shared_ptr<util::Profiler> _profiler) { m_profiler = std::move(_profiler); }
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -194,6 +218,11 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable outputs that contain AST node IDs, i.e. the AST and the storage layout, which
+	/// makes updateSources() keep nothing, so that the IDs match a compilation from scratch.
+	/// Must be set before parsing.
+	void enableNodeIDOutput(bool _enable = true) { m_nodeIDOutput = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -206,6 +235,20 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the sources of a stack that has been analysed, e.g. after an edit in a long-lived session.
+	/// Sources whose content and transitive imports did not change keep their AST and analysis
+	/// results, so that a subsequent call to parseAndAnalyze() only processes the changed sources
+	/// and the sources importing them. Warnings about unchanged sources are reported again.
+	/// Sources that were loaded by the read callback are kept as well if the callback still returns
+	/// the same content, but are dropped after parsing if no source imports them any more.
+	/// If the previous analysis did not succeed, the stack is reset (keeping the settings) instead.
+	/// @returns false if the stack was reset.
+	/// If the IR is generated (via-IR, IR or Ewasm output enabled at the time of parsing) or outputs
+	/// containing AST node IDs are enabled, nothing is kept and all sources are parsed and analysed
+	/// again, since these outputs would differ otherwise.
+	/// @note Otherwise, re-parsed sources receive fresh AST IDs, which differ from a compilation from scratch.
+	bool updateSources(StringMap _sources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(util::h256 const& _hash, std::string const& _response);
@@ -218,6 +261,11 @@ public:
 	/// Will throw errors if the import fails
 	void importASTs(std::map<std::string, Json::Value> const& _sources);
 
+	/// Imports the SourceUnits and sources stored in the binary AST format (see binaryAST()).
+	/// Leads to the same internal state as parse().
+	/// Will throw errors if the import fails
+	void importBinaryAST(std::string const& _data);
+
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
 	/// @returns false on error.
@@ -244,7 +292,11 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
-	/// Helper function for logs printing. Do only use in error cases, it's quite expensive.
+	/// @returns the ASTs and the texts of all sources in the binary AST format, which is understood
+	/// by importBinaryAST().
+	std::string binaryAST() const;
+
+	/// Helper function for logs printing.
 	/// line and columns are numbered starting from 1 with following order:
 	/// start line, start column, end line, end column
 	std::tuple<int, int, int, int> positionFromSourceLocation(langutil::SourceLocation const& _sourceLocation) const;
@@ -290,6 +342,10 @@ public:
 	/// Format: [ { name: string, id: number, language: "Yul", contents: string }, ... ]
 	Json::Value generatedSources(std::string const& _contractName, bool _runtime = false) const;
 
+	/// @returns the cache of the Yul functions shared between the contracts of the last compilation
+	/// or nullptr if no IR was generated.
+	MultiUseYulFunctionCache const* yulFunctionCache() const { return m_yulFunctionCache.get(); }
+
 	/// @returns the string that provides a mapping between bytecode and sourcecode or a nullptr
 	/// if the contract does not (yet) have bytecode.
 	std::string const* sourceMapping(std::string const& _contractName) const;
@@ -347,6 +403,13 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// Whether the AST has been analysed successfully. Such ASTs are kept by updateSources().
+		bool analysed = false;
+		/// Whether the source was loaded by the read callback.
+		bool loaded = false;
+		/// Whether the source was loaded by the read callback and kept by updateSources() without
+		/// knowing whether it is still imported.
+		bool provisional = false;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
@@ -360,8 +423,12 @@ private:
 		std::shared_ptr<Compiler> compiler;
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
-		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		std::string yulIR; ///< Experimental Yul IR code. Only stored if IR output is requested.
+		/// Yul IR code in which the objects of created contracts are empty placeholders.
+		std::string yulIRWithPlaceholders;
+		/// Contracts whose objects are embedded into the Yul IR code.
+		std::vector<ContractDefinition const*> yulSubObjects;
+		std::string yulIROptimized; ///< Optimized experimental Yul IR code. Only stored if IR output is requested.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -381,9 +448,20 @@ private:
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
+	/// Discards the ASTs and analysis kept by updateSources(), so that all sources are parsed
+	/// and analysed again as in a compilation from scratch.
+	void discardKeptAnalysis();
+	/// Removes the provisional sources that are not imported by the other sources any more.
+	void dropUnusedProvisionalSources();
 
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
+	/// Removes warnings that have been retained by updateSources() and were reported again
+	/// while analysing the sources depending on the kept sources.
+	void dropRepeatedRetainedWarnings();
+	/// Drops repeated retained warnings and moves the remaining ones to where the analysis
+	/// of their sources would have reported them.
+	void orderRetainedWarnings();
 
 	/// @returns true if the source is requested to be compiled.
 	bool isRequestedSource(std::string const& _sourceName) const;
@@ -391,25 +469,57 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
-	/// Compile a single contract.
+	/// Generate the EVM assembly of a single contract, which is optimized and assembled
+	/// by assembleContracts.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
-	///                        their bytecode if needed. Only filled after they have been compiled.
+	///                        their assembly if needed. Only filled after they have been compiled.
+	/// @param _compiledContracts the contracts compiled so far, in the order of compilation.
+	/// @param _inlineAssemblyCache inline assembly snippets already parsed for other contracts.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::vector<ContractDefinition const*>& _compiledContracts,
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache
 	);
 
+	/// Optimize and assemble the EVM assembly generated by compileContract for @a _contracts,
+	/// which have to be in the order of compilation. Does not access the AST, so independent
+	/// contracts are processed concurrently.
+	void assembleContracts(std::vector<ContractDefinition const*> const& _contracts);
+
 	/// Generate Yul IR for a single contract.
-	/// The IR is stored but otherwise unused.
-	void generateIR(ContractDefinition const& _contract);
+	/// The IR with placeholders for the objects of created contracts is stored for optimizeIR,
+	/// the complete IR only if IR output was requested.
+	/// @param _functionCache shared utility functions already created for other contracts.
+	void generateIR(
+		ContractDefinition const& _contract,
+		std::shared_ptr<MultiUseYulFunctionCache> const& _functionCache
+	);
+
+	/// Optimize the Yul IR of a single contract.
+	/// Depends on output generated by generateIR, but does not access the AST,
+	/// so it can be run concurrently for different contracts.
+	/// The optimized IR is only printed and stored if IR output was requested.
+	/// @param _threads maximal number of threads used to optimise different functions concurrently.
+	/// @param _optimizedSubObjects objects of the contracts created by @a _contract, optimized
+	/// as sub-objects, which replace the placeholders instead of being optimized again.
+	/// @param _embedded whether @a _contract is created by other contracts.
+	/// @returns the assembly stack holding the optimized Yul object and, if @a _embedded is set,
+	/// the object optimized as a sub-object of another object.
+	std::pair<std::unique_ptr<yul::AssemblyStack>, std::shared_ptr<yul::Object const>> optimizeIR(
+		ContractDefinition const& _contract,
+		size_t _threads,
+		std::map<yul::YulString, std::shared_ptr<yul::Object const>> const& _optimizedSubObjects,
+		bool _embedded
+	);
 
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// @param _stack the optimized IR returned by optimizeIR.
+	void generateEVMFromIR(ContractDefinition const& _contract, yul::AssemblyStack const& _stack);
 
 	/// Generate Ewasm representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEwasm(ContractDefinition const& _contract);
+	/// @param _stack the optimized IR returned by optimizeIR. It is translated to Ewasm in place.
+	void generateEwasm(ContractDefinition const& _contract, yul::AssemblyStack& _stack);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -465,6 +575,8 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_threads = 1;
+	std::shared_ptr<util::Profiler> m_profiler;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
@@ -472,6 +584,7 @@ private:
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	bool m_nodeIDOutput = false;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -482,6 +595,21 @@ private:
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
+	/// The resolver is kept across updateSources() since it holds the scopes of the unchanged sources.
+	std::unique_ptr<NameAndTypeResolver> m_resolver;
+	/// ASTs replaced by updateSources(). They are kept alive until the next reset because the
+	/// resolver and the type caches still refer to them.
+	std::vector<std::shared_ptr<SourceUnit>> m_supersededASTs;
+	/// Utility and ABI functions shared between the contracts of the last compilation.
+	std::shared_ptr<MultiUseYulFunctionCache> m_yulFunctionCache;
+	/// Warnings about sources kept by updateSources(), reported again after parsing.
+	langutil::ErrorList m_retainedWarnings;
+	/// Number of errors reported before each step of the last analysis.
+	std::vector<size_t> m_analysisStepStarts;
+	/// Analysis step in which each of the current errors was reported (0 for parsing).
+	std::map<langutil::Error const*, size_t> m_analysisSteps;
+	/// ID of the last AST node created by the parser. Re-parsed sources continue after it.
+	int64_t m_lastNodeID = 0;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
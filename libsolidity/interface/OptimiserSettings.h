@@ -83,6 +83,8 @@ struct OptimiserSettings
 		return standard();
 	}
 
+	/// Compares all settings that can influence the output, i.e. all except yulOptimiserThreads
+	/// and yulOptimiserSkipUnchangedFunctions.
 	bool operator==(OptimiserSettings const& _other) const
 	{
 		return
@@ -124,6 +126,13 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Maximal number of threads the Yul optimiser uses to optimise different functions of the
+	/// same object concurrently. The optimised code does not depend on this setting.
+	size_t yulOptimiserThreads = 1;
+	/// Only optimise the functions again that changed (or whose callees' side effects changed) in
+	/// the previous round of a repeated part of the Yul optimiser sequence. The optimised code does
+	/// not depend on this setting, disabling it allows comparing against optimising all functions.
+	bool yulOptimiserSkipUnchangedFunctions = true;
 };
 
 }
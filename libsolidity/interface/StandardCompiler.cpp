@@ -24,6 +24,8 @@
 #include <libsolidity/interface/StandardCompiler.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/StandardOutputSink.h>
+#include <libsolidity/interface/Version.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
@@ -33,11 +35,13 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -316,6 +320,20 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output containing AST node IDs was requested.
+bool isNodeIDRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (string const output: {"ast", "legacyAST", "storageLayout"})
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -414,7 +432,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings", "stopAfter", "threads", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -595,6 +613,93 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return { std::move(settings) };
 }
 
+/// @returns the fatal error output for the exception that is currently being handled.
+Json::Value formatCurrentException()
+{
+	try
+	{
+		throw;
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+	}
+	catch (util::Exception const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+	}
+	catch (...)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
+	}
+}
+
+/// @returns true if the input requests a profile of the compilation, which must not be cached.
+bool isProfileRequested(Json::Value const& _input)
+{
+	return
+		_input.isObject() &&
+		_input["settings"].isObject() &&
+		_input["settings"]["debug"].isObject() &&
+		_input["settings"]["debug"]["profile"].isBool() &&
+		_input["settings"]["debug"]["profile"].asBool();
+}
+
+/// Stream buffer that passes the characters written to it on to a stream and also appends them
+/// to a string.
+class TeeBuffer: public std::streambuf
+{
+public:
+	explicit TeeBuffer(ostream& _stream): m_stream(_stream) {}
+
+	string& copy() { return m_copy; }
+
+protected:
+	int overflow(int _character) override
+	{
+		if (_character != traits_type::eof())
+		{
+			m_copy.push_back(traits_type::to_char_type(_character));
+			m_stream.put(traits_type::to_char_type(_character));
+		}
+		return m_stream ? traits_type::not_eof(_character) : traits_type::eof();
+	}
+
+	streamsize xsputn(char const* _data, streamsize _size) override
+	{
+		m_copy.append(_data, static_cast<size_t>(_size));
+		m_stream.write(_data, _size);
+		return m_stream ? _size : 0;
+	}
+
+private:
+	ostream& m_stream;
+	string m_copy;
+};
+
+/// @returns the measurements of @a _profiler with the phases measured for the whole compilation
+/// in the member "phases" and those measured for each contract in the member "contracts".
+Json::Value formatProfile(util::Profiler const& _profiler)
+{
+	Json::Value profile = Json::objectValue;
+	profile["phases"] = Json::objectValue;
+	profile["contracts"] = Json::objectValue;
+	for (auto const& [context, phases]: _profiler.measurements())
+		if (context.empty())
+			profile["phases"] = util::Profiler::toJson(phases);
+		else
+		{
+			size_t colon = context.rfind(':');
+			solAssert(colon != string::npos, "");
+			profile["contracts"][context.substr(0, colon)][context.substr(colon + 1)] = util::Profiler::toJson(phases);
+		}
+	return profile;
+}
+
 }
 
 std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
@@ -756,6 +861,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("threads"))
+	{
+		if (!settings["threads"].isUInt() || settings["threads"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.threads\" must be a positive integer.");
+		ret.threads = settings["threads"].asUInt();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -768,7 +880,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	if (settings.isMember("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"revertStrings", "profile"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].isMember("revertStrings"))
@@ -785,6 +897,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				);
 			ret.revertStrings = *revertStrings;
 		}
+
+		if (settings["debug"].isMember("profile"))
+		{
+			if (!settings["debug"]["profile"].isBool())
+				return formatFatalError("JSONError", "settings.debug.profile must be a Boolean.");
+			ret.profile = settings["debug"]["profile"].asBool();
+		}
 	}
 
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
@@ -905,15 +1024,41 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputSink& _output)
 {
-	CompilerStack compilerStack(m_readFile);
-
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+
+	unique_ptr<CompilerStack> temporaryCompilerStack;
+	optional<YulStringRepository::Scope> sessionScope;
+	if (m_session)
+	{
+		Session& session = *m_session;
+		bool reused =
+			session.compilerStack &&
+			session.settings == _inputsAndSettings.reusableSettings &&
+			session.compilerStack->updateSources(sourceList);
+		if (!reused)
+		{
+			// The old stack has to be gone before a new one can be created.
+			session.compilerStack.reset();
+			session.compilerStack = make_unique<CompilerStack>(m_readFile);
+			session.compilerStack->setSources(sourceList);
+			session.settings = std::move(_inputsAndSettings.reusableSettings);
+			session.yulStrings = YulStringRepository::createScoped();
+		}
+		sessionScope.emplace(*session.yulStrings);
+	}
+	else
+	{
+		temporaryCompilerStack = make_unique<CompilerStack>(m_readFile);
+		temporaryCompilerStack->setSources(sourceList);
+	}
+	CompilerStack& compilerStack = m_session ? *m_session->compilerStack : *temporaryCompilerStack;
+
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setThreads(_inputsAndSettings.threads);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
@@ -924,10 +1069,17 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+	shared_ptr<util::Profiler> profiler;
+	if (_inputsAndSettings.profile)
+	{
+		profiler = make_shared<util::Profiler>();
+		compilerStack.setProfiler(profiler);
+	}
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableNodeIDOutput(isNodeIDRequested(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1064,41 +1216,37 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		((binariesRequested && !compilationSuccess) || !analysisPerformed) &&
 		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
-		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	{
+		_output.set({}, formatFatalError("InternalCompilerError", "No error reported, but compilation failed."));
+		return;
+	}
 
+	// The members are set in the order of their serialisation, which allows the output of
+	// each contract and source to be released once it has been passed on.
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value auxiliaryInput = Json::objectValue;
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			auxiliaryInput["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_output.set({"auxiliaryInputRequested"}, std::move(auxiliaryInput));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
-		{
-			Json::Value sourceResult = Json::objectValue;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(false, compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
-				sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
-
-	Json::Value contractsOutput = Json::objectValue;
+	// Contracts are ordered by source name first, which differs from the order of their fully
+	// qualified names if a source name contains characters that sort before the colon.
+	vector<pair<string, string>> contracts;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		contracts.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	sort(contracts.begin(), contracts.end());
 
+	for (auto const& [file, name]: contracts)
+	{
+		string const contractName = file + ":" + name;
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
@@ -1167,16 +1315,34 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["evm"] = evmData;
 
 		if (!contractData.empty())
+			_output.set({"contracts", file, name}, std::move(contractData));
+	}
+
+	// The members following the errors are prepared first, so that a failure while creating them
+	// can still be reported in the errors.
+	vector<pair<vector<string>, OutputSink::Prepared>> laterMembers;
+	if (profiler)
+		laterMembers.emplace_back(vector<string>{"profile"}, _output.prepare(formatProfile(*profiler)));
+
+	unsigned sourceIndex = 0;
+	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
+		for (string const& sourceName: compilerStack.sourceNames())
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			Json::Value sourceResult = Json::objectValue;
+			sourceResult["id"] = sourceIndex++;
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+				sourceResult["ast"] = ASTJsonConverter(false, compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
+				sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			laterMembers.emplace_back(vector<string>{"sources", sourceName}, _output.prepare(std::move(sourceResult)));
 		}
-	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
+	if (sourceIndex == 0)
+		laterMembers.emplace_back(vector<string>{"sources"}, _output.prepare(Json::objectValue));
 
-	return output;
+	if (errors.size() > 0)
+		_output.set({"errors"}, std::move(errors));
+	for (auto& [path, value]: laterMembers)
+		_output.setPrepared(path, std::move(value));
 }
 
 
@@ -1190,6 +1356,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return formatFatalError("JSONError", "Field \"settings.remappings\" cannot be used for Yul.");
 	if (_inputsAndSettings.revertStrings != RevertStrings::Default)
 		return formatFatalError("JSONError", "Field \"settings.debug.revertStrings\" cannot be used for Yul.");
+	if (_inputsAndSettings.profile)
+		return formatFatalError("JSONError", "Field \"settings.debug.profile\" cannot be used for Yul.");
 
 	Json::Value output = Json::objectValue;
 
@@ -1271,63 +1439,172 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// All Yul strings of this compilation are released once it ends.
+	YulStringRepository::Scope yulStringScope;
 
 	try
 	{
-		auto parsed = parseInput(_input);
-		if (std::holds_alternative<Json::Value>(parsed))
-			return std::get<Json::Value>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
-	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+		if (!m_cache || m_session || isProfileRequested(_input))
+			return compileUncached(_input);
+
+		util::h256 const key = cacheKey(_input);
+		// The cached output is parsed because it is returned as a JSON value.
+		if (optional<string> cachedOutput = m_cache->load(key))
+		{
+			Json::Value output;
+			if (util::jsonParseStrict(*cachedOutput, output))
+				return output;
+		}
+
+		Json::Value output;
+		if (!readCallbackUsedBy([&]() { output = compileUncached(_input); }))
+			m_cache->store(key, util::jsonCompactPrint(output));
+		return output;
 	}
-	catch (Json::RuntimeError const& _exception)
+	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+		return formatCurrentException();
 	}
-	catch (util::Exception const& _exception)
+}
+
+Json::Value StandardCompiler::compileUncached(Json::Value const& _input)
+{
+	JsonOutputSink output;
+	compileUncached(_input, output);
+	return std::move(output.output());
+}
+
+void StandardCompiler::compileUncached(Json::Value const& _input, OutputSink& _output)
+{
+	auto parsed = parseInput(_input);
+	if (std::holds_alternative<Json::Value>(parsed))
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		_output.set({}, std::get<Json::Value>(std::move(parsed)));
+		return;
 	}
-	catch (...)
+	InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+	if (m_session)
+		settings.reusableSettings = reusableSettings(_input);
+	if (settings.language == "Solidity")
+		compileSolidity(std::move(settings), _output);
+	else if (settings.language == "Yul")
+		_output.set({}, compileYul(std::move(settings)));
+	else
+		_output.set({}, formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language."));
+}
+
+util::h256 StandardCompiler::cacheKey(Json::Value const& _input)
+{
+	Json::Value input = _input;
+	if (input.isObject() && input["settings"].isObject())
+		input["settings"].removeMember("threads");
+	// Object members are printed in a fixed order, so equivalent inputs yield the same key.
+	return util::keccak256(VersionString + "\n" + util::jsonCompactPrint(input));
+}
+
+string StandardCompiler::reusableSettings(Json::Value const& _input)
+{
+	Json::Value input = _input;
+	input.removeMember("sources");
+	if (input.isMember("settings"))
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
+		Json::Value& settings = input["settings"];
+		settings.removeMember("outputSelection");
+		settings.removeMember("threads");
+		if (settings.isMember("debug"))
+			settings["debug"].removeMember("profile");
 	}
+	return util::jsonCompactPrint(input);
+}
+
+bool StandardCompiler::readCallbackUsedBy(function<void()> const& _compile)
+{
+	bool readCallbackUsed = false;
+	ReadCallback::Callback readFile = m_readFile;
+	if (readFile)
+		m_readFile = [&](string const& _kind, string const& _data) {
+			readCallbackUsed = true;
+			return readFile(_kind, _data);
+		};
+	ScopeGuard restoreReadFile([&]() { m_readFile = readFile; });
+	_compile();
+	return readCallbackUsed;
+}
+
+void StandardCompiler::enableAnalysisReuse()
+{
+	if (!m_session)
+		m_session = make_unique<Session>();
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	ostringstream output;
+	compile(_input, output);
+	return output.str();
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
 {
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonCompactPrint(formatFatalError("JSONError", errors));
+		{
+			util::jsonCompactPrint(formatFatalError("JSONError", errors), _output);
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+	// All Yul strings of this compilation are released once it ends.
+	YulStringRepository::Scope yulStringScope;
+
+	optional<util::h256> key;
+	try
+	{
+		if (m_cache && !m_session && !isProfileRequested(input))
+		{
+			key = cacheKey(input);
+			// Entries only become visible once they are completely written, so they are not validated.
+			if (optional<string> cachedOutput = m_cache->load(*key))
+			{
+				_output << *cachedOutput;
+				return;
+			}
+		}
+	}
+	catch (...)
+	{
+		util::jsonCompactPrint(formatCurrentException(), _output);
+		return;
+	}
 
+	// The output is also collected in a string if it is to be stored in the cache, which still
+	// takes much less memory than its JSON value.
+	unique_ptr<TeeBuffer> teeBuffer = key ? make_unique<TeeBuffer>(_output) : nullptr;
+	ostream teeStream(teeBuffer.get());
+	StreamingOutputSink output(key ? teeStream : _output);
 	try
 	{
-		return util::jsonCompactPrint(output);
+		bool const readCallbackUsed = readCallbackUsedBy([&]() { compileUncached(input, output); });
+		output.finish();
+		if (key && !readCallbackUsed)
+			m_cache->store(*key, teeBuffer->copy());
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		try
+		{
+			output.fail(formatCurrentException());
+		}
+		catch (...)
+		{
+		}
 	}
 }
@@ -23,8 +23,14 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <libyul/YulString.h>
+
+#include <functional>
+#include <memory>
+#include <ostream>
 #include <optional>
 #include <utility>
 #include <variant>
@@ -32,6 +38,8 @@
 namespace solidity::frontend
 {
 
+class OutputSink;
+
 /**
  * Standard JSON compiler interface, which expects a JSON input and returns a JSON output.
  * See docs/using-the-compiler#compiler-input-and-output-json-description.
@@ -42,8 +50,14 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback()):
-		m_readFile(std::move(_readFile))
+	/// @param _cache cache for the outputs of compilations, used if not null. Outputs of
+	/// compilations that invoke @a _readFile are not stored, since they depend on more than the input.
+	explicit StandardCompiler(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<CompilationCache const> _cache = nullptr
+	):
+		m_readFile(std::move(_readFile)),
+		m_cache(std::move(_cache))
 	{
 	}
 
@@ -53,6 +67,21 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Parses input as JSON and writes the serialized JSON output to @a _output. The output of each
+	/// contract is written as soon as it is available, without keeping the whole output in memory.
+	/// Only the errors are held back until the members following them are written, and the
+	/// members following the errors (the sources) are serialised before them, see StreamingOutputSink.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Keeps the sources analysed by each compilation, so that the next compilation with the same
+	/// settings (apart from the output selection, the number of threads and profiling) does not
+	/// parse and analyse the sources again whose content and imports did not change, see
+	/// CompilerStack::updateSources. This is meant for long-running compiler processes.
+	/// The cache is not used afterwards and, since the compiler stack is kept, no other compiler
+	/// stack may be created while this object exists.
+	/// Nothing is kept if outputs containing AST node IDs (the AST and the storage layout) are
+	/// requested, so that the IDs are the same as in a compilation from scratch.
+	void enableAnalysisReuse();
 
 private:
 	struct InputsAndSettings
@@ -66,6 +95,7 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
+		bool profile = false;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
@@ -73,16 +103,46 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		unsigned threads = 1;
+		/// The input apart from the members that may differ between compilations reusing the
+		/// analysis of their sources. Only set if analysis reuse is enabled.
+		std::string reusableSettings;
+	};
+
+	/// The state kept across compilations if analysis reuse is enabled.
+	struct Session
+	{
+		/// The reusable settings of the last compilation.
+		std::string settings;
+		/// Holds the Yul strings of the inline assembly blocks of the kept ASTs.
+		std::unique_ptr<yul::YulStringRepository> yulStrings;
+		std::unique_ptr<CompilerStack> compilerStack;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the compilation of @a _input without consulting the cache.
+	Json::Value compileUncached(Json::Value const& _input);
+	void compileUncached(Json::Value const& _input, OutputSink& _output);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputSink& _output);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// Runs @a _compile and @returns true if it invoked the read callback, in which case the output
+	/// may depend on more than the input and must not be cached.
+	bool readCallbackUsedBy(std::function<void()> const& _compile);
+
+	/// @returns the key of the cache entry for @a _input. Settings that do not influence the output
+	/// are ignored and the compiler version is included.
+	static util::h256 cacheKey(Json::Value const& _input);
+	/// @returns @a _input without the sources and the settings that do not prevent reusing the
+	/// analysis of a previous compilation.
+	static std::string reusableSettings(Json::Value const& _input);
+
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<CompilationCache const> m_cache;
+	std::unique_ptr<Session> m_session;
 };
 
 }
@@ -0,0 +1,173 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/StandardOutputSink.h>
+
+#include <liblangutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+void JsonOutputSink::set(vector<string> const& _path, Json::Value _value)
+{
+	Json::Value* member = &m_output;
+	for (string const& key: _path)
+		member = &(*member)[key];
+	*member = std::move(_value);
+}
+
+void JsonOutputSink::setPrepared(vector<string> const& _path, Prepared _value)
+{
+	set(_path, std::get<Json::Value>(std::move(_value)));
+}
+
+void StreamingOutputSink::set(vector<string> const& _path, Json::Value _value)
+{
+	solAssert(!m_finished, "");
+	if (_path.empty())
+	{
+		solAssert(!m_started && m_errors.isNull(), "");
+		util::jsonCompactPrint(_value, m_stream);
+		m_finished = true;
+		return;
+	}
+	if (_path == vector<string>{"errors"})
+	{
+		solAssert(!m_errorsWritten && m_errors.isNull(), "");
+		m_errors = std::move(_value);
+		return;
+	}
+	setPrepared(_path, std::move(_value));
+}
+
+OutputSink::Prepared StreamingOutputSink::prepare(Json::Value _value)
+{
+	return util::jsonCompactPrint(_value);
+}
+
+void StreamingOutputSink::setPrepared(vector<string> const& _path, Prepared _value)
+{
+	solAssert(!m_finished && !_path.empty() && _path != vector<string>{"errors"}, "");
+	if (_path.front() > "errors")
+		writeErrors();
+	writeKeys(_path);
+	if (auto const* serialised = get_if<string>(&_value))
+		m_stream << *serialised;
+	else
+		util::jsonCompactPrint(get<Json::Value>(_value), m_stream);
+}
+
+void StreamingOutputSink::finish()
+{
+	if (!m_finished)
+		end();
+}
+
+void StreamingOutputSink::fail(Json::Value const& _fatalError)
+{
+	if (m_finished)
+		return;
+	if (!m_started && m_errors.isNull())
+	{
+		set({}, _fatalError);
+		return;
+	}
+	solAssert(_fatalError.getMemberNames() == vector<string>{"errors"}, "");
+	if (m_errorsWritten)
+	{
+		// The errors cannot be amended anymore. This only happens if writing a prepared member
+		// fails, e.g. if the memory is exhausted.
+		m_finished = true;
+		return;
+	}
+	if (m_errors.isNull())
+		m_errors = Json::arrayValue;
+	for (Json::Value const& error: _fatalError["errors"])
+		m_errors.append(error);
+	end();
+}
+
+void StreamingOutputSink::writeKeys(vector<string> const& _path)
+{
+	if (!m_started)
+	{
+		m_stream << '{';
+		m_started = true;
+	}
+
+	size_t common = 0;
+	while (common < m_openPath.size() && common + 1 < _path.size() && m_openPath[common] == _path[common])
+		common++;
+	closeObjects(common);
+
+	for (size_t depth = common; depth < _path.size(); depth++)
+	{
+		writeKey(_path[depth]);
+		if (depth + 1 < _path.size())
+		{
+			m_stream << '{';
+			m_openPath.emplace_back(_path[depth]);
+			m_lastKeys.emplace_back(nullopt);
+		}
+	}
+}
+
+void StreamingOutputSink::writeErrors()
+{
+	if (m_errorsWritten)
+		return;
+	m_errorsWritten = true;
+	if (m_errors.isNull())
+		return;
+	writeKeys({"errors"});
+	util::jsonCompactPrint(m_errors, m_stream);
+	m_errors = Json::Value();
+}
+
+void StreamingOutputSink::writeKey(string const& _key)
+{
+	optional<string>& lastKey = m_lastKeys.back();
+	solAssert(!lastKey || *lastKey < _key, "Output members not set in order.");
+	if (lastKey)
+		m_stream << ',';
+	lastKey = _key;
+	util::jsonCompactPrint(Json::Value(_key), m_stream);
+	m_stream << ':';
+}
+
+void StreamingOutputSink::closeObjects(size_t _depth)
+{
+	while (m_openPath.size() > _depth)
+	{
+		m_stream << '}';
+		m_openPath.pop_back();
+		m_lastKeys.pop_back();
+	}
+}
+
+void StreamingOutputSink::end()
+{
+	writeErrors();
+	if (!m_started)
+		m_stream << '{';
+	closeObjects(0);
+	m_stream << '}';
+	m_finished = true;
+}
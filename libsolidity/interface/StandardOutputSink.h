@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Receivers of the standard JSON output, which is either collected or serialised on the fly.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Receives the output of a compilation in the order of its serialisation.
+ */
+class OutputSink
+{
+public:
+	virtual ~OutputSink() = default;
+	/// Sets the member at @a _path of the output object to @a _value. An empty path replaces the
+	/// whole output. Members have to be set in the order in which they are serialised, i.e. sorted
+	/// by their path, and no member can be set inside of a member that has already been set.
+	virtual void set(std::vector<std::string> const& _path, Json::Value _value) = 0;
+
+	/// Value of a member in the form in which the sink keeps it until the member is set.
+	using Prepared = std::variant<Json::Value, std::string>;
+	/// Converts @a _value into the form in which the sink keeps it, so that the conversion, and any
+	/// failure during it, happens before the members preceding it are set.
+	virtual Prepared prepare(Json::Value _value) { return _value; }
+	/// Sets a member like set() to a value returned by prepare().
+	virtual void setPrepared(std::vector<std::string> const& _path, Prepared _value) = 0;
+};
+
+/**
+ * Collects the output in a JSON value.
+ */
+class JsonOutputSink: public OutputSink
+{
+public:
+	void set(std::vector<std::string> const& _path, Json::Value _value) override;
+	void setPrepared(std::vector<std::string> const& _path, Prepared _value) override;
+
+	Json::Value& output() { return m_output; }
+
+private:
+	Json::Value m_output = Json::objectValue;
+};
+
+/**
+ * Serialises each member as soon as it is set, keeping only the keys of the enclosing objects.
+ * The top-level "errors" member is held back until a member is set that is serialised after it or
+ * until the output ends, so that a fatal error occurring while the contracts are written can still
+ * be added to it and the result is identical to the compact serialisation of the output collected
+ * by a JsonOutputSink. Members set after the errors have to be prepared before the errors are set,
+ * which serialises them, so that nothing can fail once the errors have been written.
+ */
+class StreamingOutputSink: public OutputSink
+{
+public:
+	explicit StreamingOutputSink(std::ostream& _stream): m_stream(_stream) {}
+
+	void set(std::vector<std::string> const& _path, Json::Value _value) override;
+	/// @returns the compact serialisation of @a _value.
+	Prepared prepare(Json::Value _value) override;
+	void setPrepared(std::vector<std::string> const& _path, Prepared _value) override;
+
+	/// Writes the errors if they are still held back and closes all open objects.
+	void finish();
+
+	/// Replaces the output by @a _fatalError if nothing has been written yet. Otherwise closes all
+	/// open objects and writes the errors of @a _fatalError, which must not have any other members,
+	/// together with the held back errors. If these have already been written, the output is left
+	/// incomplete, so that it cannot be mistaken for the output of a successful compilation.
+	void fail(Json::Value const& _fatalError);
+
+private:
+	/// Writes the keys of @a _path, opening the objects that are not open yet.
+	void writeKeys(std::vector<std::string> const& _path);
+	/// Writes the held back errors, if any.
+	void writeErrors();
+	void writeKey(std::string const& _key);
+	/// Closes the open objects nested deeper than @a _depth.
+	void closeObjects(std::size_t _depth);
+	/// Writes the held back errors, closes all open objects and ends the output.
+	void end();
+
+	std::ostream& m_stream;
+	bool m_started = false;
+	bool m_finished = false;
+	bool m_errorsWritten = false;
+	/// Keys of the objects that are currently open, outermost first.
+	std::vector<std::string> m_openPath;
+	/// Last key written into the output object and into each open object.
+	std::vector<std::optional<std::string>> m_lastKeys{std::nullopt};
+	/// The top-level "errors" member as long as it has not been written.
+	Json::Value m_errors;
+};
+
+}
@@ -65,7 +65,7 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.registerNode(make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...));
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -75,6 +75,14 @@ private:
 	SourceLocation m_location;
 };
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	for (weak_ptr<ASTNode> const& createdNode: m_createdNodes)
+		if (ASTPointer<ASTNode> node = createdNode.lock())
+			node->m_id = static_cast<size_t>(node->id() + _offset);
+	m_currentNodeID += _offset;
+}
+
 ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 {
 	solAssert(!m_insideModifier, "");
@@ -1224,7 +1232,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = block->location.end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	return registerNode(make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -27,6 +27,9 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <memory>
+#include <vector>
+
 namespace solidity::langutil
 {
 class Scanner;
@@ -41,14 +44,24 @@ public:
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::EVMVersion _evmVersion,
-		bool _errorRecovery = false
+		bool _errorRecovery = false,
+		int64_t _lastNodeID = 0
 	):
 		ParserBase(_errorReporter, _errorRecovery),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_currentNodeID(_lastNodeID)
 	{}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// @returns the ID of the last AST node created, i.e. the largest ID in use.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+
+	/// Adds @a _offset to the IDs of all nodes created so far. This allows sources to be
+	/// parsed concurrently by separate parsers and to be given the IDs of a sequential parse
+	/// afterwards. Must be called before the IDs are used anywhere.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -182,6 +195,13 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Keeps track of @a _node for shiftNodeIDs. @returns @a _node.
+	template <class NodeType>
+	ASTPointer<NodeType> registerNode(ASTPointer<NodeType> _node)
+	{
+		m_createdNodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -210,6 +230,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// All nodes created so far, including the ones that have been discarded again.
+	std::vector<std::weak_ptr<ASTNode>> m_createdNodes;
 };
 
 }
@@ -122,11 +122,27 @@ string jsonPrettyPrint(Json::Value const& _input)
 	return result;
 }
 
-string jsonCompactPrint(Json::Value const& _input)
+namespace
+{
+
+StreamWriterBuilder const& compactWriterBuilder()
 {
 	static map<string, Json::Value> settings{{"indentation", ""}};
 	static StreamWriterBuilder writerBuilder(settings);
-	return print(_input, writerBuilder);
+	return writerBuilder;
+}
+
+}
+
+string jsonCompactPrint(Json::Value const& _input)
+{
+	return print(_input, compactWriterBuilder());
+}
+
+void jsonCompactPrint(Json::Value const& _input, ostream& _output)
+{
+	unique_ptr<Json::StreamWriter> writer(compactWriterBuilder().newStreamWriter());
+	writer->write(_input, &_output);
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
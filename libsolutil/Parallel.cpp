@@ -0,0 +1,199 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+/**
+ * Process-wide set of worker threads that is only ever grown, so that repeated calls
+ * to parallelFor do not start new threads.
+ */
+class WorkerPool
+{
+public:
+	static WorkerPool& instance()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	~WorkerPool()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_wakeUp.notify_all();
+		for (thread& worker: m_workers)
+			worker.join();
+	}
+
+	/// Makes @a _copies pool threads run @a _task, starting new threads if there are fewer
+	/// than @a _copies. The task is only queued, it may run after the call has returned.
+	void post(function<void()> _task, size_t _copies)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			while (m_workers.size() < _copies)
+				try
+				{
+					m_workers.emplace_back([this]() { work(); });
+				}
+				catch (system_error const&)
+				{
+					// Could not start another thread, continue with the ones we have.
+					break;
+				}
+			for (size_t i = 0; i < _copies; ++i)
+				m_tasks.push_back(_task);
+		}
+		m_wakeUp.notify_all();
+	}
+
+private:
+	WorkerPool() = default;
+
+	void work()
+	{
+		while (true)
+		{
+			function<void()> task;
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_wakeUp.wait(lock, [&]() { return m_stopping || !m_tasks.empty(); });
+				if (m_stopping)
+					return;
+				task = move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	mutex m_mutex;
+	condition_variable m_wakeUp;
+	deque<function<void()>> m_tasks;
+	vector<thread> m_workers;
+	bool m_stopping = false;
+};
+
+/// State of one parallelFor call shared with the pool threads helping with it.
+/// Pool threads may only pick up their task after the call has returned, so they must not
+/// touch the job once @a finished is set.
+struct ParallelJob
+{
+	ParallelJob(size_t _count, function<void(size_t)> const& _job):
+		count(_count), job(_job), exceptions(_count)
+	{}
+
+	/// Processes indices until there are none left or a call has failed.
+	void work()
+	{
+		while (!failed)
+		{
+			size_t index = nextIndex++;
+			if (index >= count)
+				break;
+			try
+			{
+				job(index);
+			}
+			catch (...)
+			{
+				exceptions[index] = current_exception();
+				failed = true;
+			}
+		}
+	}
+
+	/// Called from a pool thread.
+	void help()
+	{
+		{
+			lock_guard<std::mutex> lock(stateMutex);
+			if (finished)
+				return;
+			++helpers;
+		}
+		work();
+		{
+			lock_guard<std::mutex> lock(stateMutex);
+			--helpers;
+		}
+		helpersDone.notify_all();
+	}
+
+	/// Called from the thread that called parallelFor after its own call to work().
+	/// No new indices are handed out at that point, so this only waits for calls that are
+	/// still running on pool threads.
+	void finish()
+	{
+		unique_lock<std::mutex> lock(stateMutex);
+		helpersDone.wait(lock, [&]() { return helpers == 0; });
+		finished = true;
+	}
+
+	size_t const count;
+	function<void(size_t)> const& job;
+	atomic<size_t> nextIndex{0};
+	atomic<bool> failed{false};
+	vector<exception_ptr> exceptions;
+
+	std::mutex stateMutex;
+	condition_variable helpersDone;
+	size_t helpers = 0;
+	bool finished = false;
+};
+
+}
+
+void solidity::util::parallelFor(size_t _count, size_t _threads, function<void(size_t)> const& _job)
+{
+	if (_threads <= 1 || _count <= 1)
+	{
+		for (size_t index = 0; index < _count; ++index)
+			_job(index);
+		return;
+	}
+
+	auto job = make_shared<ParallelJob>(_count, _job);
+	// The calling thread works on the job as well. If all pool threads are busy, for example
+	// because this is a nested call, it processes all indices on its own.
+	WorkerPool::instance().post([job]() { job->help(); }, min(_threads, _count) - 1);
+	job->work();
+	job->finish();
+
+	for (exception_ptr const& exception: job->exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
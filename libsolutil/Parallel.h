@@ -0,0 +1,41 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helper for running independent jobs on several threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _job for every index in the range [0, _count), using at most @a _threads threads
+/// (the calling thread included). Indices are handed out in increasing order.
+/// If @a _threads is zero or one, all calls are performed on the calling thread in order.
+/// The other threads are taken from a process-wide pool that is grown on demand and reused
+/// by later calls. Nested calls are allowed, the calling thread processes all indices itself
+/// if no pool thread is free.
+/// If one of the calls throws, no further indices are handed out and, after all running
+/// calls have finished, the exception thrown for the smallest index is re-thrown.
+/// This is the same exception a sequential loop over the range would have thrown.
+void parallelFor(size_t _count, size_t _threads, std::function<void(size_t)> const& _job);
+
+}
@@ -0,0 +1,191 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+thread_local Profiler* t_activeProfiler = nullptr;
+thread_local string t_activeContext;
+
+/// @returns the peak resident set size of the process in bytes or zero if it is not available.
+int64_t peakMemory()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return static_cast<int64_t>(usage.ru_maxrss);
+#else
+	return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+}
+
+Profiler::Measurement& Profiler::Measurement::operator+=(Measurement const& _other)
+{
+	wallTime += _other.wallTime;
+	cpuTime += _other.cpuTime;
+	peakMemoryIncrease += _other.peakMemoryIncrease;
+	count += _other.count;
+	return *this;
+}
+
+Profiler::Activation::Activation(Profiler* _profiler, string _context)
+{
+	if (!_profiler)
+		return;
+	m_active = true;
+	m_previousProfiler = t_activeProfiler;
+	m_previousContext = std::move(t_activeContext);
+	t_activeProfiler = _profiler;
+	t_activeContext = std::move(_context);
+}
+
+Profiler::Activation::~Activation()
+{
+	if (!m_active)
+		return;
+	t_activeProfiler = m_previousProfiler;
+	t_activeContext = std::move(m_previousContext);
+}
+
+Profiler::Phase::Phase(string_view _prefix, string_view _name)
+{
+	start(_prefix, _name);
+}
+
+void Profiler::Phase::restart(string_view _prefix, string_view _name)
+{
+	stop();
+	start(_prefix, _name);
+}
+
+void Profiler::Phase::start(string_view _prefix, string_view _name)
+{
+	m_profiler = t_activeProfiler;
+	if (!m_profiler)
+		return;
+	m_name.assign(_prefix);
+	m_name.append(_name);
+	m_additionalCPUTime = 0;
+	m_peakMemoryStart = peakMemory();
+	m_cpuStart = threadCPUTime();
+	m_wallStart = chrono::steady_clock::now();
+}
+
+void Profiler::Phase::stop()
+{
+	if (!m_profiler)
+		return;
+	Measurement measurement;
+	measurement.wallTime = chrono::duration<double, milli>(chrono::steady_clock::now() - m_wallStart).count();
+	measurement.cpuTime = threadCPUTime() - m_cpuStart + m_additionalCPUTime;
+	measurement.peakMemoryIncrease = peakMemory() - m_peakMemoryStart;
+	measurement.count = 1;
+	m_profiler->record(t_activeContext, m_name, measurement);
+	m_profiler = nullptr;
+}
+
+void Profiler::count(string_view _prefix, string_view _name, size_t _count)
+{
+	if (!t_activeProfiler)
+		return;
+	Measurement measurement;
+	measurement.count = _count;
+	t_activeProfiler->record(t_activeContext, string(_prefix) + string(_name), measurement);
+}
+
+Profiler* Profiler::active()
+{
+	return t_activeProfiler;
+}
+
+double Profiler::threadCPUTime()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	timespec time{};
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0)
+		return static_cast<double>(time.tv_sec) * 1000.0 + static_cast<double>(time.tv_nsec) / 1e6;
+#endif
+	// Falls back to the CPU time of the whole process.
+	return static_cast<double>(clock()) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+void Profiler::record(string const& _context, string const& _phase, Measurement const& _measurement)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_measurements[_context][_phase] += _measurement;
+}
+
+map<string, map<string, Profiler::Measurement>> Profiler::measurements() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_measurements;
+}
+
+Json::Value Profiler::toJson(map<string, Measurement> const& _phases)
+{
+	Json::Value result = Json::objectValue;
+	for (auto const& [phase, measurement]: _phases)
+	{
+		Json::Value& phaseResult = result[phase];
+		phaseResult["wallTime"] = measurement.wallTime;
+		phaseResult["cpuTime"] = measurement.cpuTime;
+		phaseResult["peakMemoryIncrease"] = Json::Int64(measurement.peakMemoryIncrease);
+		phaseResult["count"] = Json::UInt64(measurement.count);
+	}
+	return result;
+}
+
+string Profiler::toString() const
+{
+	ostringstream out;
+	out << fixed << setprecision(2);
+	for (auto const& [context, phases]: measurements())
+	{
+		out << (context.empty() ? string("Compilation") : context) << ":" << endl;
+		for (auto const& [phase, measurement]: phases)
+		{
+			out << "  " << phase << ": " << measurement.wallTime << " ms wall, " << measurement.cpuTime << " ms CPU";
+			if (measurement.peakMemoryIncrease != 0)
+				out << ", peak memory +" << measurement.peakMemoryIncrease / 1024 << " KiB";
+			if (measurement.count > 1)
+				out << " (" << measurement.count << " runs)";
+			out << endl;
+		}
+	}
+	return out.str();
+}
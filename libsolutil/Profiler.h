@@ -0,0 +1,136 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Measurement of the time and memory used by the phases of a compilation.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Collects the wall time, the CPU time and the growth of the peak memory usage of named phases,
+ * grouped by a context (e.g. the contract they belong to). Phases can be nested, in which case
+ * the outer phase includes the inner one.
+ *
+ * Phases are measured by Phase objects, which record into the profiler activated on the current
+ * thread by an Activation object and do nothing if there is none. This allows phases to be
+ * measured anywhere in the compiler without passing the profiler around.
+ * Recording is thread-safe. Measurements of the same phase in the same context are summed up.
+ */
+class Profiler
+{
+public:
+	struct Measurement
+	{
+		/// Wall time in milliseconds.
+		double wallTime = 0;
+		/// CPU time of the measuring thread in milliseconds, which includes the CPU time
+		/// of helper threads only where this is stated for the phase.
+		double cpuTime = 0;
+		/// Growth of the peak resident set size of the process in bytes.
+		int64_t peakMemoryIncrease = 0;
+		/// Number of times the phase was run.
+		size_t count = 0;
+
+		Measurement& operator+=(Measurement const& _other);
+	};
+
+	/// Makes @a _profiler the active profiler of the calling thread and @a _context the context
+	/// of the phases measured on it, for the lifetime of the object. Does nothing if @a _profiler
+	/// is null.
+	class Activation
+	{
+	public:
+		Activation(Profiler* _profiler, std::string _context);
+		~Activation();
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		bool m_active = false;
+		Profiler* m_previousProfiler = nullptr;
+		std::string m_previousContext;
+	};
+
+	/// Measures a phase from its construction to its destruction, if a profiler is active on the
+	/// current thread at construction. The name of the phase is @a _prefix followed by @a _name.
+	class Phase
+	{
+	public:
+		explicit Phase(std::string_view _prefix, std::string_view _name = {});
+		~Phase() { stop(); }
+		Phase(Phase const&) = delete;
+		Phase& operator=(Phase const&) = delete;
+
+		/// Ends the current phase and starts measuring the next one.
+		void restart(std::string_view _prefix, std::string_view _name = {});
+		/// Ends the phase.
+		void stop();
+		/// Adds CPU time used by other threads on behalf of the phase.
+		void addCPUTime(double _milliseconds) { m_additionalCPUTime += _milliseconds; }
+
+	private:
+		void start(std::string_view _prefix, std::string_view _name);
+
+		Profiler* m_profiler = nullptr;
+		std::string m_name;
+		std::chrono::steady_clock::time_point m_wallStart;
+		double m_cpuStart = 0;
+		int64_t m_peakMemoryStart = 0;
+		double m_additionalCPUTime = 0;
+	};
+
+	/// Adds @a _count to the number of runs of the phase named @a _prefix followed by @a _name
+	/// without measuring any time, if a profiler is active on the current thread. Used to report
+	/// how often something happened, e.g. how often an optimiser rule was applied.
+	static void count(std::string_view _prefix, std::string_view _name, size_t _count);
+
+	/// @returns the profiler active on the calling thread or nullptr.
+	static Profiler* active();
+	/// @returns the CPU time used by the calling thread so far in milliseconds.
+	static double threadCPUTime();
+
+	void record(std::string const& _context, std::string const& _phase, Measurement const& _measurement);
+
+	/// @returns the measurements by context and phase.
+	std::map<std::string, std::map<std::string, Measurement>> measurements() const;
+
+	/// @returns the measurements of @a _phases as a JSON object with one member per phase, which
+	/// has the members "wallTime", "cpuTime", "peakMemoryIncrease" and "count".
+	static Json::Value toJson(std::map<std::string, Measurement> const& _phases);
+	/// @returns a human-readable report of the measurements, in which the phases measured without
+	/// a context are listed first.
+	std::string toString() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::map<std::string, Measurement>> m_measurements;
+};
+
+}
@@ -26,7 +26,10 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
@@ -73,9 +76,8 @@ string Whiskers::render() const
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -100,115 +102,309 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
+bool Whiskers::isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
 namespace
 {
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+
+/// Element of a parsed template.
+struct Node
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	enum class Kind { Text, Parameter, List, Condition, StringCondition };
+	Kind kind;
+	/// Text, parameter name or name of the list or condition.
+	string_view value;
+	/// Text of the list body or of the first part of a condition and its elements.
+	string_view body;
+	vector<Node> nodes;
+	/// Text and elements of the second part of a condition.
+	string_view elseBody;
+	vector<Node> elseNodes;
+};
+
+/// @returns the length of the parameter name starting at @a _pos, i.e. the number of consecutive
+/// parameter characters.
+size_t nameLength(string_view _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && Whiskers::isParameterCharacter(_text[end]))
+		end++;
+	return end - _pos;
+}
+
+bool startsWithTag(string_view _text, size_t _pos, char const* _prefix, string_view _name)
+{
+	size_t prefixLength = char_traits<char>::length(_prefix);
+	return
+		_text.compare(_pos, prefixLength, _prefix) == 0 &&
+		_text.compare(_pos + prefixLength, _name.size(), _name) == 0 &&
+		_pos + prefixLength + _name.size() < _text.size() &&
+		_text[_pos + prefixLength + _name.size()] == '>';
+}
+
+/// @returns the position of the first occurrence of the tag "<_prefix_name>" at or after @a _pos.
+size_t findTag(string_view _text, size_t _pos, char const* _prefix, string_view _name)
+{
+	for (; _pos < _text.size(); _pos++)
+		if (_text[_pos] == '<' && startsWithTag(_text, _pos, _prefix, _name))
+			return _pos;
+	return string_view::npos;
+}
+
+/// Splits @a _text into its elements. Matches the tags in the same way as the regular expression
+/// "<(name)>|<#(name)>(.*?)</\2>|<\?(\+?name)>(.*?)(<!\4>(.*?))?</\4>", i.e. the list
+/// and condition bodies extend to the first matching closing tag and text that does not form a
+/// complete element is kept as it is.
+vector<Node> parse(string_view _text)
+{
+	vector<Node> nodes;
+	size_t textStart = 0;
+	auto flushText = [&](size_t _end) {
+		if (_end > textStart)
+			nodes.push_back(Node{Node::Kind::Text, _text.substr(textStart, _end - textStart), {}, {}, {}, {}});
+	};
+
+	size_t pos = 0;
+	while (pos < _text.size())
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		if (_text[pos] != '<' || pos + 1 == _text.size())
+		{
+			pos++;
+			continue;
+		}
+
+		char const marker = _text[pos + 1];
+		if (size_t length = nameLength(_text, pos + 1); length > 0)
+		{
+			if (pos + 1 + length < _text.size() && _text[pos + 1 + length] == '>')
+			{
+				flushText(pos);
+				nodes.push_back(Node{Node::Kind::Parameter, _text.substr(pos + 1, length), {}, {}, {}, {}});
+				pos += length + 2;
+				textStart = pos;
+				continue;
+			}
+		}
+		else if (marker == '#' || marker == '?')
+		{
+			size_t nameStart = pos + 2;
+			bool const stringCondition = marker == '?' && nameStart < _text.size() && _text[nameStart] == '+';
+			// The closing tags of string conditions repeat the "+".
+			size_t const tagStart = nameStart;
+			if (stringCondition)
+				nameStart++;
+			size_t const length = nameLength(_text, nameStart);
+			size_t const bodyStart = nameStart + length + 1;
+			if (length > 0 && bodyStart <= _text.size() && _text[bodyStart - 1] == '>')
+			{
+				string_view const tag = _text.substr(tagStart, bodyStart - 1 - tagStart);
+				Node node{
+					marker == '#' ? Node::Kind::List : stringCondition ? Node::Kind::StringCondition : Node::Kind::Condition,
+					_text.substr(nameStart, length),
+					{}, {}, {}, {}
+				};
+				size_t end = string_view::npos;
+				if (marker == '#')
+				{
+					size_t close = findTag(_text, bodyStart, "</", tag);
+					if (close != string_view::npos)
+					{
+						node.body = _text.substr(bodyStart, close - bodyStart);
+						end = close + tag.size() + 3;
+					}
+				}
+				else
+					for (size_t candidate = bodyStart; candidate < _text.size(); candidate++)
+					{
+						if (_text[candidate] != '<')
+							continue;
+						if (startsWithTag(_text, candidate, "<!", tag))
+						{
+							size_t elseStart = candidate + tag.size() + 3;
+							size_t close = findTag(_text, elseStart, "</", tag);
+							if (close != string_view::npos)
+							{
+								node.body = _text.substr(bodyStart, candidate - bodyStart);
+								node.elseBody = _text.substr(elseStart, close - elseStart);
+								end = close + tag.size() + 3;
+								break;
+							}
+						}
+						else if (startsWithTag(_text, candidate, "</", tag))
+						{
+							node.body = _text.substr(bodyStart, candidate - bodyStart);
+							end = candidate + tag.size() + 3;
+							break;
+						}
+					}
+
+				if (end != string_view::npos)
+				{
+					node.nodes = parse(node.body);
+					node.elseNodes = parse(node.elseBody);
+					flushText(pos);
+					nodes.push_back(move(node));
+					pos = end;
+					textStart = pos;
+					continue;
+				}
+			}
+		}
+		pos++;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
+	flushText(_text.size());
+	return nodes;
 }
+
+/// Template text together with its elements, which refer to the text.
+struct ParsedTemplate
+{
+	explicit ParsedTemplate(string _text): text(move(_text)), nodes(parse(text)) {}
+
+	string const text;
+	vector<Node> const nodes;
+};
+
+/// @returns the parsed form of @a _template. Templates are only parsed once, since most of them
+/// are string literals that are used for every contract.
+shared_ptr<ParsedTemplate const> parsedTemplate(string const& _template)
+{
+	// Bounds the memory used for templates that are assembled at runtime.
+	size_t constexpr maxCachedTemplates = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string_view, shared_ptr<ParsedTemplate const>> cache;
+
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(_template);
+		if (it != cache.end())
+			return it->second;
+	}
+	auto parsed = make_shared<ParsedTemplate const>(_template);
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() < maxCachedTemplates)
+		cache.emplace(parsed->text, parsed);
+	return parsed;
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+/// Parameters available while rendering (a part of) a template.
+struct RenderContext
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	Whiskers::StringMap const& parameters;
+	map<string, bool> const& conditions;
+	/// Null inside of lists, since lists cannot be nested.
+	Whiskers::StringListMap const* listParameters;
+	/// Parameters of the current list element, if any.
+	Whiskers::StringMap const* listElement;
+
+	string const* parameter(string const& _name) const
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+		if (listElement)
+			if (auto it = listElement->find(_name); it != listElement->end())
+				return &it->second;
+		if (auto it = parameters.find(_name); it != parameters.end())
+			return &it->second;
+		return nullptr;
+	}
+};
+
+void renderNodes(string_view _text, vector<Node> const& _nodes, RenderContext const& _context, string& _output)
+{
+	for (Node const& node: _nodes)
+		switch (node.kind)
+		{
+		case Node::Kind::Text:
+			_output.append(node.value);
+			break;
+		case Node::Kind::Parameter:
 		{
+			string const name(node.value);
+			string const* value = _context.parameter(name);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + name + " not provided.\n" +
 				"Template:\n" +
-				_template
+				string(_text)
 			);
-			return _parameters.at(tagName);
+			_output.append(*value);
+			break;
 		}
-		else if (!listName.empty())
+		case Node::Kind::List:
 		{
-			string templ(_match[3]);
+			string const name(node.value);
+			auto list = _context.listParameters ? _context.listParameters->find(name) : Whiskers::StringListMap::const_iterator{};
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_context.listParameters && list != _context.listParameters->end(),
+				WhiskersError, "List parameter " + name + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (Whiskers::StringMap const& element: list->second)
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!_context.parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				renderNodes(node.body, node.nodes, RenderContext{_context.parameters, _context.conditions, nullptr, &element}, _output);
+			}
+			break;
 		}
-		else
+		case Node::Kind::Condition:
+		case Node::Kind::StringCondition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
+			string const name(node.value);
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (node.kind == Node::Kind::StringCondition)
 			{
-				string tag = conditionName.substr(1);
+				string const* value = _context.parameter(name);
 				assertThrow(
-					_parameters.count(tag),
-					WhiskersError, "Tag " + tag + " used as condition but was not set."
+					value,
+					WhiskersError, "Tag " + name + " used as condition but was not set."
 				);
-				conditionValue = !_parameters.at(tag).empty();
+				conditionValue = !value->empty();
 			}
 			else
 			{
+				auto condition = _context.conditions.find(name);
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					condition != _context.conditions.end(),
+					WhiskersError, "Condition parameter " + name + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = condition->second;
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			if (conditionValue)
+				renderNodes(node.body, node.nodes, _context, _output);
+			else
+				renderNodes(node.elseBody, node.elseNodes, _context, _output);
+			break;
 		}
-	});
+		}
+}
+
 }
 
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
+string Whiskers::replace(
+	string const& _template,
+	StringMap const& _parameters,
+	map<string, bool> const& _conditions,
+	map<string, vector<StringMap>> const& _listParameters
 )
 {
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
+	shared_ptr<ParsedTemplate const> parsed = parsedTemplate(_template);
 
+	size_t size = _template.size();
+	for (auto const& parameter: _parameters)
+		size += parameter.second.size();
+	string result;
+	result.reserve(size);
+	renderNodes(parsed->text, parsed->nodes, RenderContext{_parameters, _conditions, &_listParameters, nullptr}, result);
+	return result;
+}
@@ -88,6 +88,9 @@ public:
 
 	std::string render() const;
 
+	/// @returns true if @a _c can be part of a parameter name.
+	static bool isParameterCharacter(char _c);
+
 private:
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
@@ -101,11 +104,6 @@ private:
 		StringListMap const& _listParameters = StringListMap()
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
@@ -214,7 +214,7 @@ Assignment AsmJsonImporter::createAssignment(Json::Value const& _node)
 		for (auto const& var: member(_node, "variableNames"))
 			assignment.variableNames.emplace_back(createIdentifier(var));
 
-	assignment.value = make_unique<Expression>(createExpression(member(_node, "value")));
+	assignment.value = makeNode<Expression>(createExpression(member(_node, "value")));
 	return assignment;
 }
 
@@ -242,7 +242,7 @@ VariableDeclaration AsmJsonImporter::createVariableDeclaration(Json::Value const
 	auto varDec = createAsmNode<VariableDeclaration>(_node);
 	for (auto const& var: member(_node, "variables"))
 		varDec.variables.emplace_back(createTypedName(var));
-	varDec.value = make_unique<Expression>(createExpression(member(_node, "value")));
+	varDec.value = makeNode<Expression>(createExpression(member(_node, "value")));
 	return varDec;
 }
 
@@ -266,7 +266,7 @@ FunctionDefinition AsmJsonImporter::createFunctionDefinition(Json::Value const&
 If AsmJsonImporter::createIf(Json::Value const& _node)
 {
 	auto ifStatement = createAsmNode<If>(_node);
-	ifStatement.condition = make_unique<Expression>(createExpression(member(_node, "condition")));
+	ifStatement.condition = makeNode<Expression>(createExpression(member(_node, "condition")));
 	ifStatement.body = createBlock(member(_node, "body"));
 	return ifStatement;
 }
@@ -278,7 +278,7 @@ Case AsmJsonImporter::createCase(Json::Value const& _node)
 	if (value.isString())
 		yulAssert(value.asString() == "default", "Expected default case");
 	else
-		caseStatement.value = make_unique<Literal>(createLiteral(value));
+		caseStatement.value = makeNode<Literal>(createLiteral(value));
 	caseStatement.body = createBlock(member(_node, "body"));
 	return caseStatement;
 }
@@ -286,7 +286,7 @@ Case AsmJsonImporter::createCase(Json::Value const& _node)
 Switch AsmJsonImporter::createSwitch(Json::Value const& _node)
 {
 	auto switchStatement = createAsmNode<Switch>(_node);
-	switchStatement.expression = make_unique<Expression>(createExpression(member(_node, "expression")));
+	switchStatement.expression = makeNode<Expression>(createExpression(member(_node, "expression")));
 	for (auto const& var: member(_node, "cases"))
 		switchStatement.cases.emplace_back(createCase(var));
 	return switchStatement;
@@ -296,7 +296,7 @@ ForLoop AsmJsonImporter::createForLoop(Json::Value const& _node)
 {
 	auto forLoop = createAsmNode<ForLoop>(_node);
 	forLoop.pre = createBlock(member(_node, "pre"));
-	forLoop.condition = make_unique<Expression>(createExpression(member(_node, "condition")));
+	forLoop.condition = makeNode<Expression>(createExpression(member(_node, "condition")));
 	forLoop.post = createBlock(member(_node, "post"));
 	forLoop.body = createBlock(member(_node, "body"));
 	return forLoop;
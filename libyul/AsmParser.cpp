@@ -88,7 +88,7 @@ Statement Parser::parseStatement()
 	{
 		If _if = createWithLocation<If>();
 		advance();
-		_if.condition = make_unique<Expression>(parseExpression());
+		_if.condition = makeNode<Expression>(parseExpression());
 		_if.body = parseBlock();
 		return Statement{move(_if)};
 	}
@@ -96,7 +96,7 @@ Statement Parser::parseStatement()
 	{
 		Switch _switch = createWithLocation<Switch>();
 		advance();
-		_switch.expression = make_unique<Expression>(parseExpression());
+		_switch.expression = makeNode<Expression>(parseExpression());
 		while (currentToken() == Token::Case)
 			_switch.cases.emplace_back(parseCase());
 		if (currentToken() == Token::Default)
@@ -188,7 +188,7 @@ Statement Parser::parseStatement()
 
 		expectToken(Token::AssemblyAssign);
 
-		assignment.value = make_unique<Expression>(parseExpression());
+		assignment.value = makeNode<Expression>(parseExpression());
 		assignment.location.end = locationOf(*assignment.value).end;
 
 		return Statement{std::move(assignment)};
@@ -227,7 +227,7 @@ Case Parser::parseCase()
 		ElementaryOperation literal = parseElementaryOperation();
 		if (!holds_alternative<Literal>(literal))
 			fatalParserError(4805_error, "Literal expected.");
-		_case.value = make_unique<Literal>(std::get<Literal>(std::move(literal)));
+		_case.value = makeNode<Literal>(std::get<Literal>(std::move(literal)));
 	}
 	else
 		yulAssert(false, "Case or default case expected.");
@@ -247,7 +247,7 @@ ForLoop Parser::parseForLoop()
 	m_currentForLoopComponent = ForLoopComponent::ForLoopPre;
 	forLoop.pre = parseBlock();
 	m_currentForLoopComponent = ForLoopComponent::None;
-	forLoop.condition = make_unique<Expression>(parseExpression());
+	forLoop.condition = makeNode<Expression>(parseExpression());
 	m_currentForLoopComponent = ForLoopComponent::ForLoopPost;
 	forLoop.post = parseBlock();
 	m_currentForLoopComponent = ForLoopComponent::ForLoopBody;
@@ -362,7 +362,7 @@ VariableDeclaration Parser::parseVariableDeclaration()
 	if (currentToken() == Token::AssemblyAssign)
 	{
 		expectToken(Token::AssemblyAssign);
-		varDecl.value = make_unique<Expression>(parseExpression());
+		varDecl.value = makeNode<Expression>(parseExpression());
 		varDecl.location.end = locationOf(*varDecl.value).end;
 	}
 	else
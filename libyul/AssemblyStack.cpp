@@ -36,6 +36,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Suite.h>
@@ -44,6 +45,7 @@
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/Profiler.h>
 
 using namespace std;
 using namespace solidity;
@@ -77,16 +79,23 @@ Scanner const& AssemblyStack::scanner() const
 	return *m_scanner;
 }
 
-bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string const& _source)
+bool AssemblyStack::parseAndAnalyze(
+	std::string const& _sourceName,
+	std::string const& _source,
+	map<YulString, shared_ptr<Object const>> const& _optimizedSubObjects
+)
 {
 	m_errors.clear();
 	m_analysisSuccessful = false;
+	m_optimizedSubObjects.clear();
 	m_scanner = make_shared<Scanner>(CharStream(_source, _sourceName));
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion)).parse(m_scanner, false);
 	if (!m_errorReporter.errors().empty())
 		return false;
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
+	if (!_optimizedSubObjects.empty())
+		replaceSubObjects(*m_parserResult, _optimizedSubObjects);
 
 	return analyzeParsed();
 }
@@ -104,6 +113,30 @@ void AssemblyStack::optimize()
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
+shared_ptr<Object const> AssemblyStack::optimizeForEmbedding()
+{
+	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
+	yulAssert(m_parserResult, "");
+	if (!m_optimiserSettings.runYulOptimiser)
+		return m_parserResult->shallowCopy();
+
+	m_analysisSuccessful = false;
+	// The sub-objects are optimized in the same way in both cases, only the code of the
+	// outermost object is optimized as runtime code if it is embedded into another object.
+	for (auto& subNode: m_parserResult->subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			optimize(*subObject, false);
+	shared_ptr<Object> embedded = m_parserResult->shallowCopy();
+	embedded->code = make_shared<Block>(std::get<Block>(ASTCopier{}(*m_parserResult->code)));
+	embedded->analysisInfo = make_shared<AsmAnalysisInfo>(
+		AsmAnalyzer::analyzeStrictAssertCorrect(languageToDialect(m_language, m_evmVersion), *embedded)
+	);
+	optimizeCode(*m_parserResult, true);
+	optimizeCode(*embedded, false);
+	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+	return embedded;
+}
+
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
 {
 	if (m_language == _targetLanguage)
@@ -117,6 +150,8 @@ void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
 	*m_parserResult = EVMToEwasmTranslator(
 		languageToDialect(m_language, m_evmVersion)
 	).run(*parserResult());
+	// The translation creates new sub-objects, which still have to be optimized.
+	m_optimizedSubObjects.clear();
 
 	m_language = _targetLanguage;
 }
@@ -131,6 +166,8 @@ bool AssemblyStack::analyzeParsed()
 bool AssemblyStack::analyzeParsed(Object& _object)
 {
 	yulAssert(_object.code, "");
+	if (m_optimizedSubObjects.count(&_object))
+		return true;
 	_object.analysisInfo = make_shared<AsmAnalysisInfo>();
 
 	AsmAnalyzer analyzer(
@@ -172,10 +209,17 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+	if (m_optimizedSubObjects.count(&_object))
+		return;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 			optimize(*subObject, false);
+	optimizeCode(_object, _isCreation);
+}
 
+void AssemblyStack::optimizeCode(Object& _object, bool _isCreation)
+{
+	util::Profiler::Phase phase{"yulOptimizer"};
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
@@ -185,10 +229,33 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
+		m_optimiserSettings.yulOptimiserSteps,
+		{},
+		m_optimiserSettings.yulOptimiserThreads,
+		m_optimiserSettings.yulOptimiserSkipUnchangedFunctions
 	);
 }
 
+void AssemblyStack::replaceSubObjects(
+	Object& _object,
+	map<YulString, shared_ptr<Object const>> const& _optimizedSubObjects
+)
+{
+	for (auto& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+		{
+			auto optimizedSubObject = _optimizedSubObjects.find(subObject->name);
+			if (optimizedSubObject == _optimizedSubObjects.end())
+				replaceSubObjects(*subObject, _optimizedSubObjects);
+			else
+			{
+				shared_ptr<Object> copy = optimizedSubObject->second->shallowCopy();
+				m_optimizedSubObjects.insert(copy.get());
+				subNode = move(copy);
+			}
+		}
+}
+
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 {
 	yulAssert(m_analysisSuccessful, "");
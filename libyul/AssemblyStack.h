@@ -32,7 +32,9 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 namespace solidity::langutil
@@ -77,12 +79,26 @@ public:
 
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
 	/// Multiple calls overwrite the previous state.
-	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
+	/// Sub-objects (at any depth) named like one of @a _optimizedSubObjects are replaced by
+	/// (shallow copies of) it. These have to be analyzed and optimized already and are
+	/// neither analyzed nor optimized again, which allows an object embedded into several
+	/// others to be processed only once.
+	bool parseAndAnalyze(
+		std::string const& _sourceName,
+		std::string const& _source,
+		std::map<YulString, std::shared_ptr<Object const>> const& _optimizedSubObjects = {}
+	);
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Runs the optimizer suite like @a optimize and additionally optimizes a copy of the code of
+	/// the outermost object in the way it is optimized as a sub-object of another object.
+	/// @returns that copy, whose sub-objects share their code with the optimized object, to be
+	/// passed to @a parseAndAnalyze of the objects embedding it.
+	std::shared_ptr<Object const> optimizeForEmbedding();
+
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
 
@@ -111,6 +127,14 @@ private:
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
 	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes the code of @a _object without its sub-objects.
+	void optimizeCode(yul::Object& _object, bool _isCreation);
+
+	/// Replaces the sub-objects of @a _object by the matching ones in @a _optimizedSubObjects.
+	void replaceSubObjects(
+		yul::Object& _object,
+		std::map<YulString, std::shared_ptr<Object const>> const& _optimizedSubObjects
+	);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
@@ -120,6 +144,8 @@ private:
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
+	/// Sub-objects of m_parserResult that were optimized elsewhere.
+	std::set<yul::Object const*> m_optimizedSubObjects;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
 
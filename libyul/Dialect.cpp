@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AsmData.h>
 
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace std;
 using namespace solidity::langutil;
@@ -54,9 +56,12 @@ Dialect const& Dialect::yulDeprecated()
 {
 	static unique_ptr<Dialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 
 	if (!dialect)
 	{
+		YulStringRepository::Scope globalScope{YulStringRepository::global()};
 		// TODO will probably change, especially the list of types.
 		dialect = make_unique<Dialect>();
 		dialect->defaultType = "u256"_yulstring;
@@ -0,0 +1,234 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Pooled allocation of the Yul AST nodes that are owned through pointers.
+ */
+
+#include <libyul/NodePool.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Sizes are rounded up to multiples of this, which is also the alignment of all blocks.
+size_t constexpr c_granularity = alignof(max_align_t);
+/// Larger nodes are allocated with operator new.
+size_t constexpr c_sizeClasses = 16;
+/// Chunks are aligned to their size, so the chunk of a block can be found from its address.
+size_t constexpr c_chunkSize = 64 * 1024;
+
+struct FreeBlock
+{
+	FreeBlock* next;
+};
+
+using FreeLists = array<FreeBlock*, c_sizeClasses>;
+
+size_t sizeClass(size_t _size)
+{
+	return (_size + c_granularity - 1) / c_granularity - 1;
+}
+
+size_t blockSize(size_t _class)
+{
+	return (_class + 1) * c_granularity;
+}
+
+char* chunkOf(FreeBlock const* _block)
+{
+	return reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(_block) & ~uintptr_t(c_chunkSize - 1));
+}
+
+/// Moves all blocks of @a _from to the front of @a _to.
+void splice(FreeBlock*& _from, FreeBlock*& _to)
+{
+	if (!_from)
+		return;
+	FreeBlock* last = _from;
+	while (last->next)
+		last = last->next;
+	last->next = _to;
+	_to = _from;
+	_from = nullptr;
+}
+
+struct SharedPool
+{
+	mutex accessMutex;
+	/// Blocks handed over by other threads.
+	FreeLists freeLists{};
+	unordered_set<char*> chunks;
+	/// Incremented by releaseUnusedMemory to ask all threads to hand over their free lists.
+	atomic<size_t> generation{0};
+
+	/// @returns a list of free blocks of the given size class, taking the blocks handed over
+	/// by other threads if there are any or carving a new chunk otherwise.
+	FreeBlock* take(size_t _class)
+	{
+		lock_guard<mutex> lock(accessMutex);
+		FreeBlock* list = nullptr;
+		if (freeLists[_class])
+		{
+			swap(list, freeLists[_class]);
+			return list;
+		}
+
+		char* chunk = static_cast<char*>(::operator new(c_chunkSize, align_val_t(c_chunkSize)));
+		chunks.insert(chunk);
+		size_t const size = blockSize(_class);
+		for (size_t offset = 0; offset + size <= c_chunkSize; offset += size)
+		{
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + offset);
+			block->next = list;
+			list = block;
+		}
+		return list;
+	}
+
+	/// Frees the chunks all of whose blocks are in the shared free lists. Requires the lock.
+	void releaseFreeChunks()
+	{
+		for (size_t index = 0; index < c_sizeClasses; ++index)
+		{
+			size_t const blocksPerChunk = c_chunkSize / blockSize(index);
+			unordered_map<char*, size_t> freeBlocks;
+			for (FreeBlock* block = freeLists[index]; block; block = block->next)
+				++freeBlocks[chunkOf(block)];
+
+			bool anyUnused = false;
+			for (auto const& [chunk, count]: freeBlocks)
+				if (count == blocksPerChunk)
+					anyUnused = true;
+			if (!anyUnused)
+				continue;
+
+			FreeBlock** next = &freeLists[index];
+			while (*next)
+				if (freeBlocks.at(chunkOf(*next)) == blocksPerChunk)
+					*next = (*next)->next;
+				else
+					next = &(*next)->next;
+			for (auto const& [chunk, count]: freeBlocks)
+				if (count == blocksPerChunk)
+				{
+					chunks.erase(chunk);
+					::operator delete(chunk, align_val_t(c_chunkSize));
+				}
+		}
+	}
+};
+
+/// The shared pool is never destroyed, since nodes can still be freed during the
+/// destruction of other static objects.
+SharedPool& sharedPool()
+{
+	static SharedPool* pool = new SharedPool();
+	return *pool;
+}
+
+struct ThreadFreeLists
+{
+	FreeLists freeLists{};
+	size_t generation = 0;
+
+	~ThreadFreeLists()
+	{
+		handOver();
+	}
+
+	/// Hands the free lists over to the shared pool if releaseUnusedMemory was called since
+	/// the last time.
+	void update()
+	{
+		size_t const currentGeneration = sharedPool().generation.load(memory_order_relaxed);
+		if (generation != currentGeneration)
+		{
+			handOver();
+			generation = currentGeneration;
+		}
+	}
+
+	void handOver()
+	{
+		SharedPool& pool = sharedPool();
+		lock_guard<mutex> lock(pool.accessMutex);
+		for (size_t i = 0; i < c_sizeClasses; ++i)
+			splice(freeLists[i], pool.freeLists[i]);
+	}
+};
+
+thread_local ThreadFreeLists t_freeLists;
+
+}
+
+void* NodePool::allocate(size_t _size)
+{
+	size_t const index = sizeClass(_size);
+	if (index >= c_sizeClasses)
+		return ::operator new(_size);
+
+	t_freeLists.update();
+	FreeBlock*& list = t_freeLists.freeLists[index];
+	if (!list)
+		list = sharedPool().take(index);
+	FreeBlock* block = list;
+	list = block->next;
+	return block;
+}
+
+void NodePool::deallocate(void* _node, size_t _size) noexcept
+{
+	size_t const index = sizeClass(_size);
+	if (index >= c_sizeClasses)
+	{
+		::operator delete(_node);
+		return;
+	}
+
+	t_freeLists.update();
+	FreeBlock*& list = t_freeLists.freeLists[index];
+	FreeBlock* block = static_cast<FreeBlock*>(_node);
+	block->next = list;
+	list = block;
+}
+
+void NodePool::releaseUnusedMemory()
+{
+	SharedPool& pool = sharedPool();
+	t_freeLists.handOver();
+	lock_guard<mutex> lock(pool.accessMutex);
+	t_freeLists.generation = ++pool.generation;
+	pool.releaseFreeChunks();
+}
+
+size_t NodePool::reservedBytes()
+{
+	SharedPool& pool = sharedPool();
+	lock_guard<mutex> lock(pool.accessMutex);
+	return pool.chunks.size() * c_chunkSize;
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Pooled allocation of the Yul AST nodes that are owned through pointers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace solidity::yul
+{
+
+/**
+ * Memory pool for small AST nodes.
+ *
+ * Nodes are carved out of large chunks and freed nodes are kept in per-thread free lists
+ * (one per size class) to be reused for the next node of the same size, so that the
+ * optimiser steps that constantly create and destroy expressions do not go through
+ * the general purpose allocator for each of them. Nodes may be freed on a different thread
+ * than the one that allocated them. The free lists of a thread are handed over to
+ * the other threads when it finishes.
+ *
+ * Chunks whose blocks are all free are returned to the system by releaseUnusedMemory,
+ * which is called at the end of each scoped compilation (see YulStringRepository::Scope).
+ * Blocks in the free lists of other threads only count as free once those threads have handed
+ * them over, which they do at their next allocation or deallocation and when they finish.
+ */
+class NodePool
+{
+public:
+	/// @returns memory for an object of @a _size bytes, aligned for any object of that size.
+	static void* allocate(size_t _size);
+	/// Returns memory obtained from allocate with the same @a _size.
+	static void deallocate(void* _node, size_t _size) noexcept;
+
+	/// Returns the chunks whose blocks are all free to the system and hands the free lists
+	/// of the calling thread over to the shared pool.
+	static void releaseUnusedMemory();
+
+	/// @returns the number of bytes currently allocated from the system for the pool.
+	static size_t reservedBytes();
+};
+
+template <class T>
+struct NodeDeleter
+{
+	void operator()(T* _node) const noexcept
+	{
+		_node->~T();
+		NodePool::deallocate(_node, sizeof(T));
+	}
+};
+
+/// Owning pointer to an AST node allocated by makeNode.
+template <class T>
+using NodePointer = std::unique_ptr<T, NodeDeleter<T>>;
+
+/// Creates a node from the pool, equivalent to std::make_unique.
+template <class T, class... Args>
+NodePointer<T> makeNode(Args&&... _args)
+{
+	void* memory = NodePool::allocate(sizeof(T));
+	try
+	{
+		return NodePointer<T>(new (memory) T(std::forward<Args>(_args)...));
+	}
+	catch (...)
+	{
+		NodePool::deallocate(memory, sizeof(T));
+		throw;
+	}
+}
+
+}
@@ -114,3 +114,18 @@ vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 
 	return path;
 }
+
+shared_ptr<Object> Object::shallowCopy() const
+{
+	auto copy = make_shared<Object>();
+	copy->name = name;
+	copy->code = code;
+	copy->analysisInfo = analysisInfo;
+	copy->subIndexByName = subIndexByName;
+	for (shared_ptr<ObjectNode> const& subObjectNode: subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subObjectNode.get()))
+			copy->subObjects.emplace_back(subObject->shallowCopy());
+		else
+			copy->subObjects.emplace_back(subObjectNode);
+	return copy;
+}
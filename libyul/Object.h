@@ -85,6 +85,11 @@ public:
 	/// The path must not lead to a @a Data object (will throw in that case).
 	std::vector<size_t> pathToSubObject(YulString _qualifiedName) const;
 
+	/// @returns a copy of this object and its sub-objects that shares the code, the analysis
+	/// information and the data with this object. The copy can be assembled as part of
+	/// another object without modifying this object.
+	std::shared_ptr<Object> shallowCopy() const;
+
 	/// sub id for object if it is subobject of another object, max value if it is not subobject
 	size_t subId = std::numeric_limits<size_t>::max();
 
@@ -0,0 +1,266 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/NodePool.h>
+
+#include <mutex>
+
+using namespace std;
+using namespace solidity::yul;
+
+namespace
+{
+
+// Primes of XXH64, whose round function and final mix are used below.
+uint64_t constexpr c_prime1 = 11400714785074694791u;
+uint64_t constexpr c_prime2 = 14029467366897019727u;
+uint64_t constexpr c_prime3 = 1609587929392839161u;
+
+uint64_t rotateLeft(uint64_t _value, unsigned _bits)
+{
+	return (_value << _bits) | (_value >> (64 - _bits));
+}
+
+/// Reads @a Bytes bytes in little-endian order. Compilers turn this into a single load on
+/// little-endian machines.
+template <size_t Bytes>
+uint64_t readLittleEndian(char const* _data)
+{
+	uint64_t word = 0;
+	for (size_t i = 0; i < Bytes; ++i)
+		word |= uint64_t(uint8_t(_data[i])) << (8 * i);
+	return word;
+}
+
+uint64_t mixRound(uint64_t _accumulator, uint64_t _word)
+{
+	return rotateLeft(_accumulator + _word * c_prime2, 31) * c_prime1;
+}
+
+}
+
+YulStringRepository::Scope::Scope():
+	m_ownedRepository(new YulStringRepository(&YulStringRepository::global())),
+	m_repository(m_ownedRepository.get()),
+	m_previous(currentRepository())
+{
+	currentRepository() = m_repository;
+}
+
+YulStringRepository::Scope::Scope(YulStringRepository& _repository):
+	m_repository(&_repository),
+	m_previous(currentRepository())
+{
+	currentRepository() = m_repository;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	currentRepository() = m_previous;
+	// The compilation has ended, so most of its AST nodes are gone.
+	if (m_ownedRepository)
+		NodePool::releaseUnusedMemory();
+}
+
+YulStringRepository& YulStringRepository::global()
+{
+	static YulStringRepository repository;
+	return repository;
+}
+
+unique_ptr<YulStringRepository> YulStringRepository::createScoped()
+{
+	return unique_ptr<YulStringRepository>(new YulStringRepository(&global()));
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+
+	if (m_parent)
+		if (optional<uint64_t> id = m_parent->lookup(_string, h))
+			return Handle{*id, h};
+	if (optional<uint64_t> id = lookup(_string, h))
+		return Handle{*id, h};
+
+	Shard& shard = shardFor(h);
+	unique_lock<shared_mutex> lock(shard.mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (optional<uint64_t> id = find(_string, h, shard))
+		return Handle{*id, h};
+	uint64_t id = (uint64_t(shard.strings.append(_string)) << ShardBits) | uint64_t(&shard - m_shards.data());
+	if (id & ScopeMask)
+		throw out_of_range("Too many YulStrings.");
+	id |= m_scopeTag;
+	shard.hashToID.emplace(h, id);
+	return Handle{id, h};
+}
+
+uint64_t YulStringRepository::hash(string const& _string)
+{
+	if (_string.empty())
+		return emptyHash();
+
+	char const* data = _string.data();
+	size_t const size = _string.size();
+	// Identifiers are short, so the common case is covered by (at most) two overlapping reads.
+	uint64_t first = 0;
+	uint64_t second = 0;
+	if (size >= 8)
+	{
+		first = emptyHash();
+		second = c_prime1;
+		for (size_t offset = 0; offset + 16 < size; offset += 16)
+		{
+			first = mixRound(first, readLittleEndian<8>(data + offset));
+			second = mixRound(second, readLittleEndian<8>(data + offset + 8));
+		}
+		first ^= readLittleEndian<8>(data + (size > 16 ? size - 16 : 0));
+		second ^= readLittleEndian<8>(data + size - 8);
+	}
+	else if (size >= 4)
+	{
+		first = readLittleEndian<4>(data);
+		second = readLittleEndian<4>(data + size - 4);
+	}
+	else
+		first =
+			(uint64_t(uint8_t(data[0])) << 16) |
+			(uint64_t(uint8_t(data[size / 2])) << 8) |
+			uint64_t(uint8_t(data[size - 1]));
+
+	uint64_t hash = mixRound(emptyHash() ^ size, first);
+	hash = mixRound(hash, second);
+	hash ^= hash >> 33;
+	hash *= c_prime2;
+	hash ^= hash >> 29;
+	hash *= c_prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+void YulStringRepository::reset()
+{
+	for (auto const& cb: resetCallbacks())
+		cb();
+	YulStringRepository& repository = global();
+	for (Shard& shard: repository.m_shards)
+	{
+		shard.hashToID.clear();
+		shard.strings.clear();
+	}
+	repository.m_shards[0].strings.append({});
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	static mutex callbacksMutex;
+	lock_guard<mutex> lock(callbacksMutex);
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+YulStringRepository::Arena::~Arena()
+{
+	clear();
+}
+
+string const& YulStringRepository::Arena::at(size_t _index) const
+{
+	if (_index >= m_size.load(memory_order_acquire))
+		throw out_of_range("Invalid YulString ID.");
+	size_t position = _index + FirstSegmentSize;
+	size_t segment = 0;
+	while ((FirstSegmentSize << (segment + 1)) <= position)
+		++segment;
+	return m_segments[segment].load(memory_order_relaxed)[position - (FirstSegmentSize << segment)];
+}
+
+size_t YulStringRepository::Arena::append(string const& _string)
+{
+	size_t index = m_size.load(memory_order_relaxed);
+	size_t position = index + FirstSegmentSize;
+	size_t segment = 0;
+	while ((FirstSegmentSize << (segment + 1)) <= position)
+		++segment;
+	string* data = m_segments[segment].load(memory_order_relaxed);
+	if (!data)
+	{
+		data = new string[FirstSegmentSize << segment];
+		m_segments[segment].store(data, memory_order_relaxed);
+	}
+	data[position - (FirstSegmentSize << segment)] = _string;
+	// Publishes the string (and the segment) to readers that observe the new size.
+	m_size.store(index + 1, memory_order_release);
+	return index;
+}
+
+void YulStringRepository::Arena::clear()
+{
+	for (auto& segment: m_segments)
+		delete[] segment.exchange(nullptr);
+	m_size = 0;
+}
+
+YulStringRepository::YulStringRepository(YulStringRepository* _parent):
+	m_parent(_parent)
+{
+	// The empty string has ID zero, which belongs to the global repository.
+	if (!m_parent)
+		m_shards[0].strings.append({});
+	else
+	{
+		static atomic<uint64_t> nextScopeTag{0};
+		uint64_t tag = nextScopeTag++ & ((uint64_t(1) << ScopeTagBits) - 1);
+		m_scopeTag = ScopedFlag | (tag << ScopeTagShift);
+	}
+}
+
+optional<uint64_t> YulStringRepository::find(string const& _string, uint64_t _hash, Shard const& _shard) const
+{
+	auto range = _shard.hashToID.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return it->second;
+	return nullopt;
+}
+
+optional<uint64_t> YulStringRepository::lookup(string const& _string, uint64_t _hash) const
+{
+	Shard const& shard = shardFor(_hash);
+	shared_lock<shared_mutex> lock(shard.mutex);
+	return find(_string, _hash, shard);
+}
+
+YulStringRepository*& YulStringRepository::currentRepository()
+{
+	thread_local YulStringRepository* current = nullptr;
+	return current;
+}
+
+vector<function<void()>>& YulStringRepository::resetCallbacks()
+{
+	static vector<function<void()>> callbacks;
+	return callbacks;
+}
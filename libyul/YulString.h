@@ -23,8 +23,13 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,86 +41,159 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
-class YulStringRepository
+///
+/// There is one global repository, which is used unless a Scope is active in the current thread.
+/// A Scope provides a separate repository (e.g. for a single compilation) that falls back to the global
+/// one for lookups and releases its strings once the Scope ends.
+/// IDs of scoped strings carry a tag of their repository, so that looking them up in any other
+/// repository throws instead of returning an unrelated string.
+///
+/// The strings are distributed over several shards (selected by the string hash), each of which
+/// is locked separately and only exclusively for insertions. Lookups of strings by ID do not lock at all.
+/// @a reset is not thread-safe.
+class YulStringRepository: boost::noncopyable
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		std::uint64_t id;
 		std::uint64_t hash;
 	};
 
+	/// Makes a repository the current one of the calling thread for the lifetime of the Scope object.
+	class Scope: boost::noncopyable
+	{
+	public:
+		/// Creates a fresh repository on top of the global one. Its destruction also returns the
+		/// unused memory of the node pool to the system.
+		Scope();
+		/// Uses an existing repository, e.g. to let a worker thread share the repository of its parent.
+		explicit Scope(YulStringRepository& _repository);
+		~Scope();
+
+		YulStringRepository& repository() { return *m_repository; }
+
+	private:
+		std::unique_ptr<YulStringRepository> m_ownedRepository;
+		YulStringRepository* m_repository = nullptr;
+		YulStringRepository* m_previous = nullptr;
+	};
+
+	/// @returns the repository of the innermost active Scope of the current thread
+	/// or the global repository if there is none.
 	static YulStringRepository& instance()
 	{
-		static YulStringRepository inst;
-		return inst;
+		YulStringRepository* current = currentRepository();
+		return current ? *current : global();
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	/// @returns the global repository. Strings that outlive a compilation (e.g. the builtins
+	/// of dialects) have to be stored here.
+	static YulStringRepository& global();
+	/// @returns a new repository on top of the global one for strings that outlive a single
+	/// compilation, e.g. those of the ASTs kept by a long-running compiler session.
+	/// It is made current by a Scope referring to it.
+	static std::unique_ptr<YulStringRepository> createScoped();
+
+	Handle stringToHandle(std::string const& _string);
+	/// Does not lock. Strings of the global repository can be looked up through any scoped repository.
+	/// Throws std::out_of_range for strings of a scoped repository other than this one.
+	std::string const& idToString(std::uint64_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		if (m_parent && !isScopedID(_id))
+			return m_parent->idToString(_id);
+		if ((_id & ScopeMask) != m_scopeTag)
+			throw std::out_of_range("YulString accessed outside of its scope.");
+		size_t index = size_t(_id & ~ScopeMask);
+		return m_shards[index & (ShardCount - 1)].strings.at(index >> ShardBits);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
-	static std::uint64_t hash(std::string const& v)
+	/// @returns true if both IDs are known to belong to the same repository, which means that
+	/// different IDs refer to different strings.
+	static bool sameRepository(std::uint64_t _id1, std::uint64_t _id2)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
-		std::uint64_t hash = emptyHash();
-		for (char c: v)
-		{
-			hash *= 1099511628211u;
-			hash ^= static_cast<uint64_t>(c);
-		}
-
-		return hash;
+		return (_id1 & ScopeMask) == (_id2 & ScopeMask);
 	}
+
+	/// Deterministic 64-bit string hash that processes eight bytes at a time.
+	/// The input is read in little-endian order, so the result does not depend on the platform.
+	static std::uint64_t hash(std::string const& _string);
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Clear the global repository.
+	/// Use with care - there cannot be any dangling YulString references and no active Scopes.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
-	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
-	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+	/// Append-only storage of strings. Elements are never moved, so they can be
+	/// read without locking while other elements are appended.
+	/// Segment k holds FirstSegmentSize << k elements.
+	class Arena
+	{
+	public:
+		Arena() = default;
+		~Arena();
+
+		std::string const& at(size_t _index) const;
+		/// Appends a string and returns its index. Requires external synchronisation.
+		size_t append(std::string const& _string);
+		/// Removes all strings. Not thread-safe.
+		void clear();
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	private:
+		static constexpr size_t FirstSegmentBits = 6;
+		static constexpr size_t FirstSegmentSize = size_t(1) << FirstSegmentBits;
+		static constexpr size_t MaxSegments = sizeof(size_t) * 8 - FirstSegmentBits;
+
+		std::array<std::atomic<std::string*>, MaxSegments> m_segments{};
+		std::atomic<size_t> m_size{0};
+	};
+
+	struct Shard
 	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+		/// Taken in shared mode for lookups and exclusively for insertions.
+		mutable std::shared_mutex mutex;
+		std::unordered_multimap<std::uint64_t, std::uint64_t> hashToID;
+		Arena strings;
+	};
+
+	static constexpr size_t ShardBits = 4;
+	static constexpr size_t ShardCount = size_t(1) << ShardBits;
+	/// Flag set in all IDs of strings stored in scoped (i.e. non-global) repositories.
+	static constexpr std::uint64_t ScopedFlag = std::uint64_t(1) << 63;
+	/// Scoped IDs store the tag of their repository in the bits below the flag. Tags are
+	/// assigned round-robin, so they only repeat after 2^ScopeTagBits scopes.
+	static constexpr unsigned ScopeTagBits = 23;
+	static constexpr unsigned ScopeTagShift = 63 - ScopeTagBits;
+	/// Mask of the flag and the tag.
+	static constexpr std::uint64_t ScopeMask = ~((std::uint64_t(1) << ScopeTagShift) - 1);
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	explicit YulStringRepository(YulStringRepository* _parent = nullptr);
+
+	static bool isScopedID(std::uint64_t _id) { return _id & ScopedFlag; }
+	Shard& shardFor(std::uint64_t _hash) { return m_shards[_hash >> (64 - ShardBits)]; }
+	Shard const& shardFor(std::uint64_t _hash) const { return m_shards[_hash >> (64 - ShardBits)]; }
+	/// @returns the ID of @a _string in this repository (not considering the parent), if present.
+	/// Requires the lock of @a _shard.
+	std::optional<std::uint64_t> find(std::string const& _string, std::uint64_t _hash, Shard const& _shard) const;
+	/// @returns the ID of @a _string in this repository (not considering the parent), if present.
+	std::optional<std::uint64_t> lookup(std::string const& _string, std::uint64_t _hash) const;
+
+	static YulStringRepository*& currentRepository();
+	static std::vector<std::function<void()>>& resetCallbacks();
+
+	/// The global repository, which is consulted before inserting into a scoped one.
+	YulStringRepository* m_parent = nullptr;
+	/// Bits set in the IDs of all strings of this repository, zero for the global one.
+	std::uint64_t m_scopeTag = 0;
+	std::array<Shard, ShardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -145,9 +223,20 @@ public:
 		if (m_handle.id == _other.m_handle.id) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the string ID. Only if the two strings come from
+	/// different repositories (global and scoped), the strings themselves have to be compared.
+	bool operator==(YulString const& _other) const
+	{
+		if (m_handle.id == _other.m_handle.id)
+			return true;
+		if (
+			m_handle.hash != _other.m_handle.hash ||
+			YulStringRepository::sameRepository(m_handle.id, _other.m_handle.id)
+		)
+			return false;
+		return str() == _other.str();
+	}
+	bool operator!=(YulString const& _other) const { return !(*this == _other); }
 
 	bool empty() const { return m_handle.id == 0; }
 	std::string const& str() const
@@ -44,14 +44,21 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
-EthAssemblyAdapter::EthAssemblyAdapter(evmasm::Assembly& _assembly):
-	m_assembly(_assembly)
+EthAssemblyAdapter::EthAssemblyAdapter(
+	evmasm::Assembly& _assembly,
+	optional<pair<SourceLocation, SourceLocation>> _locationReplacement
+):
+	m_assembly(_assembly),
+	m_locationReplacement(move(_locationReplacement))
 {
 }
 
 void EthAssemblyAdapter::setSourceLocation(SourceLocation const& _location)
 {
-	m_assembly.setSourceLocation(_location);
+	if (m_locationReplacement && _location == m_locationReplacement->first)
+		m_assembly.setSourceLocation(m_locationReplacement->second);
+	else
+		m_assembly.setSourceLocation(_location);
 }
 
 int EthAssemblyAdapter::stackHeight() const
@@ -227,10 +234,11 @@ void CodeGenerator::assemble(
 	langutil::EVMVersion _evmVersion,
 	ExternalIdentifierAccess const& _identifierAccess,
 	bool _useNamedLabelsForFunctions,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	optional<pair<SourceLocation, SourceLocation>> _locationReplacement
 )
 {
-	EthAssemblyAdapter assemblyAdapter(_assembly);
+	EthAssemblyAdapter assemblyAdapter(_assembly, move(_locationReplacement));
 	BuiltinContext builtinContext;
 	CodeTransform transform(
 		assemblyAdapter,
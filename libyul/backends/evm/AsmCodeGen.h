@@ -25,6 +25,8 @@
 #include <libyul/AsmAnalysis.h>
 #include <liblangutil/SourceLocation.h>
 #include <functional>
+#include <optional>
+#include <utility>
 
 namespace solidity::evmasm
 {
@@ -39,7 +41,12 @@ struct Block;
 class EthAssemblyAdapter: public AbstractAssembly
 {
 public:
-	explicit EthAssemblyAdapter(evmasm::Assembly& _assembly);
+	/// @param _locationReplacement if set, source locations equal to its first element
+	/// are replaced by its second element.
+	explicit EthAssemblyAdapter(
+		evmasm::Assembly& _assembly,
+		std::optional<std::pair<langutil::SourceLocation, langutil::SourceLocation>> _locationReplacement = std::nullopt
+	);
 	void setSourceLocation(langutil::SourceLocation const& _location) override;
 	int stackHeight() const override;
 	void setStackHeight(int height) override;
@@ -72,6 +79,7 @@ private:
 	void appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType);
 
 	evmasm::Assembly& m_assembly;
+	std::optional<std::pair<langutil::SourceLocation, langutil::SourceLocation>> m_locationReplacement;
 	std::map<SubID, u256> m_dataHashBySubId;
 	size_t m_nextDataCounter = std::numeric_limits<size_t>::max() / 2;
 };
@@ -80,6 +88,8 @@ class CodeGenerator
 {
 public:
 	/// Performs code generation and appends generated to _assembly.
+	/// @param _locationReplacement pair of a placeholder source location the code was parsed with
+	/// and the actual source location to use instead.
 	static void assemble(
 		Block const& _parsedData,
 		AsmAnalysisInfo& _analysisInfo,
@@ -87,7 +97,8 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
 		bool _useNamedLabelsForFunctions = false,
-		bool _optimizeStackAllocation = false
+		bool _optimizeStackAllocation = false,
+		std::optional<std::pair<langutil::SourceLocation, langutil::SourceLocation>> _locationReplacement = std::nullopt
 	);
 };
 
@@ -180,7 +180,7 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 Representation RepresentationFinder::represent(u256 const& _value) const
 {
 	Representation repr;
-	repr.expression = make_unique<Expression>(Literal{m_location, LiteralKind::Number, YulString{formatNumber(_value)}, {}});
+	repr.expression = makeNode<Expression>(Literal{m_location, LiteralKind::Number, YulString{formatNumber(_value)}, {}});
 	repr.cost = m_meter.costs(*repr.expression);
 	return repr;
 }
@@ -191,7 +191,7 @@ Representation RepresentationFinder::represent(
 ) const
 {
 	Representation repr;
-	repr.expression = make_unique<Expression>(FunctionCall{
+	repr.expression = makeNode<Expression>(FunctionCall{
 		m_location,
 		Identifier{m_location, _instruction},
 		{ASTCopier{}.translate(*_argument.expression)}
@@ -207,7 +207,7 @@ Representation RepresentationFinder::represent(
 ) const
 {
 	Representation repr;
-	repr.expression = make_unique<Expression>(FunctionCall{
+	repr.expression = makeNode<Expression>(FunctionCall{
 		m_location,
 		Identifier{m_location, _instruction},
 		{ASTCopier{}.translate(*_arg1.expression), ASTCopier{}.translate(*_arg2.expression)}
@@ -57,7 +57,7 @@ public:
 
 	struct Representation
 	{
-		std::unique_ptr<Expression> expression;
+		NodePointer<Expression> expression;
 		size_t cost = size_t(-1);
 	};
 
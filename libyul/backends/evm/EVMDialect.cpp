@@ -35,6 +35,8 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -282,8 +284,14 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		// The builtins are shared between compilations and thus have to be stored globally.
+		YulStringRepository::Scope globalScope{YulStringRepository::global()};
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
+	}
 	return *dialects[_version];
 }
 
@@ -291,8 +299,13 @@ EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::Scope globalScope{YulStringRepository::global()};
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
+	}
 	return *dialects[_version];
 }
 
@@ -417,7 +430,12 @@ EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::Scope globalScope{YulStringRepository::global()};
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
+	}
 	return *dialects[_version];
 }
@@ -24,6 +24,8 @@
 #include <libyul/AsmData.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -163,8 +165,14 @@ WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
+	{
+		// Builtin names outlive individual compilations.
+		YulStringRepository::Scope globalScope{YulStringRepository::global()};
 		dialect = make_unique<WasmDialect>();
+	}
 	return *dialect;
 }
 
@@ -64,7 +64,7 @@ void WordSizeTransform::operator()(FunctionCall& _fc)
 
 void WordSizeTransform::operator()(If& _if)
 {
-	_if.condition = make_unique<Expression>(FunctionCall{
+	_if.condition = makeNode<Expression>(FunctionCall{
 		locationOf(*_if.condition),
 		Identifier{locationOf(*_if.condition), "or_bool"_yulstring},
 		expandValueToVector(*_if.condition)
@@ -80,7 +80,7 @@ void WordSizeTransform::operator()(Switch&)
 void WordSizeTransform::operator()(ForLoop& _for)
 {
 	(*this)(_for.pre);
-	_for.condition = make_unique<Expression>(FunctionCall{
+	_for.condition = makeNode<Expression>(FunctionCall{
 		locationOf(*_for.condition),
 		Identifier{locationOf(*_for.condition), "or_bool"_yulstring},
 		expandValueToVector(*_for.condition)
@@ -118,7 +118,7 @@ void WordSizeTransform::operator()(Block& _block)
 								ret.emplace_back(VariableDeclaration{
 									varDecl.location,
 									{TypedName{varDecl.location, newLhs[i], m_targetDialect.defaultType}},
-									make_unique<Expression>(Literal{
+									makeNode<Expression>(Literal{
 										locationOf(*varDecl.value),
 										LiteralKind::Number,
 										"0"_yulstring,
@@ -179,7 +179,7 @@ void WordSizeTransform::operator()(Block& _block)
 								ret.emplace_back(Assignment{
 									assignment.location,
 									{Identifier{assignment.location, newLhs[i]}},
-									make_unique<Expression>(Literal{
+									makeNode<Expression>(Literal{
 										locationOf(*assignment.value),
 										LiteralKind::Number,
 										"0"_yulstring,
@@ -305,7 +305,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 
 	Switch ret{
 		_location,
-		make_unique<Expression>(Identifier{_location, _splitExpressions.at(_depth)}),
+		makeNode<Expression>(Identifier{_location, _splitExpressions.at(_depth)}),
 		{}
 	};
 
@@ -314,7 +314,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 		Literal label{_location, LiteralKind::Number, YulString(c.first.str()), m_targetDialect.defaultType};
 		ret.cases.emplace_back(Case{
 			c.second.front().location,
-			make_unique<Literal>(std::move(label)),
+			makeNode<Literal>(std::move(label)),
 			Block{_location, handleSwitchInternal(
 				_location,
 				_splitExpressions,
@@ -332,7 +332,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 				Assignment{
 					_location,
 					{{_location, _runDefaultFlag}},
-					make_unique<Expression>(Literal{_location, LiteralKind::Boolean, "true"_yulstring, m_targetDialect.boolType})
+					makeNode<Expression>(Literal{_location, LiteralKind::Boolean, "true"_yulstring, m_targetDialect.boolType})
 				}
 			)}
 		});
@@ -375,7 +375,7 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 	if (!runDefaultFlag.empty())
 		ret.emplace_back(If{
 			_switch.location,
-			make_unique<Expression>(Identifier{_switch.location, runDefaultFlag}),
+			makeNode<Expression>(Identifier{_switch.location, runDefaultFlag}),
 			std::move(defaultCase.body)
 		});
 	return ret;
@@ -390,14 +390,14 @@ array<YulString, 4> WordSizeTransform::generateU64IdentifierNames(YulString cons
 	return m_variableMapping[_s];
 }
 
-array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e)
+array<NodePointer<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e)
 {
-	array<unique_ptr<Expression>, 4> ret;
+	array<NodePointer<Expression>, 4> ret;
 	if (holds_alternative<Identifier>(_e))
 	{
 		auto const& id = std::get<Identifier>(_e);
 		for (size_t i = 0; i < 4; i++)
-			ret[i] = make_unique<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
+			ret[i] = makeNode<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
 	}
 	else if (holds_alternative<Literal>(_e))
 	{
@@ -408,7 +408,7 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 			size_t exprIndexReverse = 3 - exprIndex;
 			u256 currentVal = val & std::numeric_limits<uint64_t>::max();
 			val >>= 64;
-			ret[exprIndexReverse] = make_unique<Expression>(
+			ret[exprIndexReverse] = makeNode<Expression>(
 				Literal{
 					lit.location,
 					LiteralKind::Number,
@@ -426,7 +426,7 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 vector<Expression> WordSizeTransform::expandValueToVector(Expression const& _e)
 {
 	vector<Expression> ret;
-	for (unique_ptr<Expression>& val: expandValue(_e))
+	for (NodePointer<Expression>& val: expandValue(_e))
 		ret.emplace_back(std::move(*val));
 	return ret;
 }
@@ -23,6 +23,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/NodePool.h>
 
 #include <liblangutil/SourceLocation.h>
 
@@ -95,7 +96,7 @@ private:
 	);
 
 	std::array<YulString, 4> generateU64IdentifierNames(YulString const& _s);
-	std::array<std::unique_ptr<Expression>, 4> expandValue(Expression const& _e);
+	std::array<NodePointer<Expression>, 4> expandValue(Expression const& _e);
 	std::vector<Expression> expandValueToVector(Expression const& _e);
 
 	Dialect const& m_inputDialect;
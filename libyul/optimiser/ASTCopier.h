@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
+#include <libyul/NodePool.h>
 
 #include <libyul/YulString.h>
 
@@ -91,9 +92,9 @@ protected:
 	std::vector<T> translateVector(std::vector<T> const& _values);
 
 	template <typename T>
-	std::unique_ptr<T> translate(std::unique_ptr<T> const& _v)
+	NodePointer<T> translate(NodePointer<T> const& _v)
 	{
-		return _v ? std::make_unique<T>(translate(*_v)) : nullptr;
+		return _v ? makeNode<T>(translate(*_v)) : nullptr;
 	}
 
 	Case translate(Case const& _case);
@@ -112,6 +113,7 @@ template <typename T>
 std::vector<T> ASTCopier::translateVector(std::vector<T> const& _values)
 {
 	std::vector<T> translated;
+	translated.reserve(_values.size());
 	for (auto const& v: _values)
 		translated.emplace_back(translate(v));
 	return translated;
@@ -41,3 +41,8 @@ void BlockFlattener::operator()(Block& _block)
 		}
 	);
 }
+
+LocalStepRunner BlockFlattener::localRunner(OptimiserStepContext&, Block const&)
+{
+	return [](Statement& _statement, NameDispenser&) { BlockFlattener{}.visit(_statement); };
+}
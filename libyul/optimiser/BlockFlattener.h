@@ -28,6 +28,7 @@ class BlockFlattener: public ASTModifier
 public:
 	static constexpr char const* name{"BlockFlattener"};
 	static void run(OptimiserStepContext&, Block& _ast) { BlockFlattener{}(_ast); }
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
@@ -39,14 +39,27 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 {
 	CommonSubexpressionEliminator cse{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		make_shared<map<YulString, SideEffects> const>(
+			SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		)
 	};
 	cse(_ast);
 }
 
+LocalStepRunner CommonSubexpressionEliminator::localRunner(OptimiserStepContext& _context, Block const& _ast)
+{
+	auto functionSideEffects = make_shared<map<YulString, SideEffects> const>(
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	);
+	Dialect const& dialect = _context.dialect;
+	return [functionSideEffects, &dialect](Statement& _statement, NameDispenser&) {
+		CommonSubexpressionEliminator{dialect, functionSideEffects}.visit(_statement);
+	};
+}
+
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
-	map<YulString, SideEffects> _functionSideEffects
+	shared_ptr<map<YulString, SideEffects> const> _functionSideEffects
 ):
 	DataFlowAnalyzer(_dialect, std::move(_functionSideEffects))
 {
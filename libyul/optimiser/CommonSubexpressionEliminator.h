@@ -42,11 +42,12 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 private:
 	CommonSubexpressionEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects
 	);
 
 protected:
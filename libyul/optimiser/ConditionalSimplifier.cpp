@@ -46,7 +46,7 @@ void ConditionalSimplifier::operator()(Switch& _switch)
 				Assignment{
 					_case.body.location,
 					{Identifier{_case.body.location, expr}},
-					make_unique<Expression>(*_case.value)
+					makeNode<Expression>(*_case.value)
 				}
 			);
 		}
@@ -78,7 +78,7 @@ void ConditionalSimplifier::operator()(Block& _block)
 						Assignment{
 							location,
 							{Identifier{location, condition}},
-							make_unique<Expression>(m_dialect.zeroLiteralForType(m_dialect.boolType))
+							makeNode<Expression>(m_dialect.zeroLiteralForType(m_dialect.boolType))
 						}
 					);
 				}
@@ -87,3 +87,8 @@ void ConditionalSimplifier::operator()(Block& _block)
 		}
 	);
 }
+
+LocalStepRunner ConditionalSimplifier::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { ConditionalSimplifier{_context.dialect}.visit(_statement); };
+}
@@ -57,6 +57,7 @@ public:
 	{
 		ConditionalSimplifier{_context.dialect}(_ast);
 	}
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Switch& _switch) override;
@@ -98,3 +98,8 @@ void ConditionalUnsimplifier::operator()(Block& _block)
 		}
 	);
 }
+
+LocalStepRunner ConditionalUnsimplifier::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { ConditionalUnsimplifier{_context.dialect}.visit(_statement); };
+}
@@ -37,6 +37,7 @@ public:
 	{
 		ConditionalUnsimplifier{_context.dialect}(_ast);
 	}
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Switch& _switch) override;
@@ -83,6 +83,15 @@ void ControlFlowSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	ControlFlowSimplifier{_context.dialect, typeInfo}(_ast);
 }
 
+LocalStepRunner ControlFlowSimplifier::localRunner(OptimiserStepContext& _context, Block const& _ast)
+{
+	auto typeInfo = make_shared<TypeInfo>(_context.dialect, _ast);
+	Dialect const& dialect = _context.dialect;
+	return [typeInfo, &dialect](Statement& _statement, NameDispenser&) {
+		ControlFlowSimplifier{dialect, *typeInfo}.visit(_statement);
+	};
+}
+
 void ControlFlowSimplifier::operator()(Block& _block)
 {
 	simplify(_block.statements);
@@ -213,7 +222,7 @@ OptionalStatements ControlFlowSimplifier::reduceSingleCaseSwitch(Switch& _switch
 			return {};
 		return make_vector<Statement>(If{
 			std::move(_switchStmt.location),
-			make_unique<Expression>(FunctionCall{
+			makeNode<Expression>(FunctionCall{
 				loc,
 				Identifier{loc, m_dialect.equalityFunction(type)->name},
 				{std::move(*switchCase.value), std::move(*_switchStmt.expression)}
@@ -53,6 +53,7 @@ class ControlFlowSimplifier: public ASTModifier
 public:
 	static constexpr char const* name{"ControlFlowSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Break&) override { ++m_numBreakStatements; }
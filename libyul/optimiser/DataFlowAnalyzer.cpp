@@ -224,7 +224,7 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 {
 	clearValues(_variables);
 
-	MovableChecker movableChecker{m_dialect, &m_functionSideEffects};
+	MovableChecker movableChecker{m_dialect, m_functionSideEffects.get()};
 	if (_value)
 		movableChecker.visit(*_value);
 	else
@@ -330,7 +330,7 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
-	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
+	SideEffectsCollector sideEffects(m_dialect, _block, m_functionSideEffects.get());
 	if (sideEffects.invalidatesStorage())
 		m_storage.clear();
 	if (sideEffects.invalidatesMemory())
@@ -339,7 +339,7 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
-	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
+	SideEffectsCollector sideEffects(m_dialect, _expr, m_functionSideEffects.get());
 	if (sideEffects.invalidatesStorage())
 		m_storage.clear();
 	if (sideEffects.invalidatesMemory())
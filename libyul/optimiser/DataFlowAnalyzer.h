@@ -35,6 +35,7 @@
 #include <libsolutil/InvertibleMap.h>
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace solidity::yul
@@ -89,6 +90,17 @@ public:
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects = {}
+	):
+		DataFlowAnalyzer(
+			_dialect,
+			std::make_shared<std::map<YulString, SideEffects> const>(std::move(_functionSideEffects))
+		)
+	{}
+	/// Variant that shares @a _functionSideEffects with other analyzers, e.g. with the ones
+	/// that run on other functions of the same AST.
+	DataFlowAnalyzer(
+		Dialect const& _dialect,
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects
 	):
 		m_dialect(_dialect),
 		m_functionSideEffects(std::move(_functionSideEffects)),
@@ -160,7 +172,7 @@ protected:
 	Dialect const& m_dialect;
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
-	std::map<YulString, SideEffects> m_functionSideEffects;
+	std::shared_ptr<std::map<YulString, SideEffects> const> m_functionSideEffects;
 
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
@@ -39,6 +39,11 @@ void DeadCodeEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	DeadCodeEliminator{_context.dialect}(_ast);
 }
 
+LocalStepRunner DeadCodeEliminator::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { DeadCodeEliminator{_context.dialect}.visit(_statement); };
+}
+
 void DeadCodeEliminator::operator()(ForLoop& _for)
 {
 	yulAssert(_for.pre.statements.empty(), "DeadCodeEliminator needs ForLoopInitRewriter as a prerequisite.");
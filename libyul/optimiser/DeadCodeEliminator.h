@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/YulString.h>
 
 #include <map>
@@ -30,7 +31,6 @@
 namespace solidity::yul
 {
 struct Dialect;
-struct OptimiserStepContext;
 
 /**
  * Optimisation stage that removes unreachable code
@@ -51,6 +51,7 @@ class DeadCodeEliminator: public ASTModifier
 public:
 	static constexpr char const* name{"DeadCodeEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _for) override;
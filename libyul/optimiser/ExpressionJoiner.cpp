@@ -37,7 +37,19 @@ using namespace solidity::yul;
 
 void ExpressionJoiner::run(OptimiserStepContext&, Block& _ast)
 {
-	ExpressionJoiner{_ast}(_ast);
+	ExpressionJoiner{ReferencesCounter::countReferences(_ast)}(_ast);
+}
+
+LocalStepRunner ExpressionJoiner::localRunner(OptimiserStepContext&, Block const&)
+{
+	return [](Statement& _statement, NameDispenser&) {
+		auto const* function = get_if<FunctionDefinition>(&_statement);
+		ExpressionJoiner{
+			function ?
+			ReferencesCounter::countReferences(*function) :
+			ReferencesCounter::countReferences(std::get<Block>(_statement))
+		}.visit(_statement);
+	};
 }
 
 
@@ -80,11 +92,6 @@ void ExpressionJoiner::visit(Expression& _e)
 		ASTModifier::visit(_e);
 }
 
-ExpressionJoiner::ExpressionJoiner(Block& _ast)
-{
-	m_references = ReferencesCounter::countReferences(_ast);
-}
-
 void ExpressionJoiner::handleArguments(vector<Expression>& _arguments)
 {
 	// We have to fill from left to right, but we can only
@@ -23,6 +23,7 @@
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 
 #include <map>
 
@@ -30,7 +31,6 @@ namespace solidity::yul
 {
 
 class NameCollector;
-struct OptimiserStepContext;
 
 
 /**
@@ -74,9 +74,10 @@ class ExpressionJoiner: public ASTModifier
 public:
 	static constexpr char const* name{"ExpressionJoiner"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 private:
-	explicit ExpressionJoiner(Block& _ast);
+	explicit ExpressionJoiner(std::map<YulString, size_t> _references): m_references(std::move(_references)) {}
 
 	void operator()(Block& _block) override;
 	void operator()(FunctionCall&) override;
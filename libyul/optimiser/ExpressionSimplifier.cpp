@@ -34,6 +34,11 @@ void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	ExpressionSimplifier{_context.dialect}(_ast);
 }
 
+LocalStepRunner ExpressionSimplifier::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { ExpressionSimplifier{_context.dialect}.visit(_statement); };
+}
+
 void ExpressionSimplifier::visit(Expression& _expression)
 {
 	ASTModifier::visit(_expression);
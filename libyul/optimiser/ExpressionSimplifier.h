@@ -24,11 +24,11 @@
 #include <libyul/AsmDataForward.h>
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
 
 namespace solidity::yul
 {
 struct Dialect;
-struct OptimiserStepContext;
 
 /**
  * Applies simplification rules to all expressions.
@@ -46,8 +46,10 @@ class ExpressionSimplifier: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
+	using ASTModifier::visit;
 	void visit(Expression& _expression) override;
 
 private:
@@ -44,6 +44,15 @@ void ExpressionSplitter::run(OptimiserStepContext& _context, Block& _ast)
 	ExpressionSplitter{_context.dialect, _context.dispenser, typeInfo}(_ast);
 }
 
+LocalStepRunner ExpressionSplitter::localRunner(OptimiserStepContext& _context, Block const& _ast)
+{
+	auto typeInfo = make_shared<TypeInfo>(_context.dialect, _ast);
+	Dialect const& dialect = _context.dialect;
+	return [typeInfo, &dialect](Statement& _statement, NameDispenser& _dispenser) {
+		ExpressionSplitter{dialect, _dispenser, *typeInfo}.visit(_statement);
+	};
+}
+
 void ExpressionSplitter::operator()(FunctionCall& _funCall)
 {
 	BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name);
@@ -107,9 +116,10 @@ void ExpressionSplitter::outlineExpression(Expression& _expr)
 	m_statementsToPrefix.emplace_back(VariableDeclaration{
 		location,
 		{{TypedName{location, var, type}}},
-		make_unique<Expression>(std::move(_expr))
+		makeNode<Expression>(std::move(_expr))
 	});
+	// The new variable is never looked up again while splitting because identifiers are not
+	// outlined, so the type information does not need to be updated.
 	_expr = Identifier{location, var};
-	m_typeInfo.setVariableType(var, type);
 }
 
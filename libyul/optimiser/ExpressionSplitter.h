@@ -25,6 +25,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
 
 #include <vector>
 
@@ -32,7 +33,6 @@ namespace solidity::yul
 {
 
 struct Dialect;
-struct OptimiserStepContext;
 class TypeInfo;
 
 /**
@@ -61,6 +61,7 @@ class ExpressionSplitter: public ASTModifier
 public:
 	static constexpr char const* name{"ExpressionSplitter"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	void operator()(FunctionCall&) override;
 	void operator()(If&) override;
@@ -72,7 +73,7 @@ private:
 	explicit ExpressionSplitter(
 		Dialect const& _dialect,
 		NameDispenser& _nameDispenser,
-		TypeInfo& _typeInfo
+		TypeInfo const& _typeInfo
 	):
 		m_dialect(_dialect),
 		m_nameDispenser(_nameDispenser),
@@ -89,7 +90,7 @@ private:
 	std::vector<Statement> m_statementsToPrefix;
 	Dialect const& m_dialect;
 	NameDispenser& m_nameDispenser;
-	TypeInfo& m_typeInfo;
+	TypeInfo const& m_typeInfo;
 };
 
 }
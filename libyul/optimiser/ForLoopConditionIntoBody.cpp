@@ -30,6 +30,11 @@ void ForLoopConditionIntoBody::run(OptimiserStepContext& _context, Block& _ast)
 	ForLoopConditionIntoBody{_context.dialect}(_ast);
 }
 
+LocalStepRunner ForLoopConditionIntoBody::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { ForLoopConditionIntoBody{_context.dialect}.visit(_statement); };
+}
+
 void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 {
 	if (
@@ -44,7 +49,7 @@ void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 			begin(_forLoop.body.statements),
 			If {
 				loc,
-				make_unique<Expression>(
+				makeNode<Expression>(
 					FunctionCall {
 						loc,
 						{loc, m_dialect.booleanNegationFunction()->name},
@@ -54,7 +59,7 @@ void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 				Block {loc, util::make_vector<Statement>(Break{{}})}
 			}
 		);
-		_forLoop.condition = make_unique<Expression>(
+		_forLoop.condition = makeNode<Expression>(
 			Literal {
 				loc,
 				LiteralKind::Boolean,
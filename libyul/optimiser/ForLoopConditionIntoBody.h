@@ -18,13 +18,12 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Dialect.h>
 
 namespace solidity::yul
 {
 
-struct OptimiserStepContext;
-
 /**
  * Rewrites ForLoop by moving iteration condition into the ForLoop body.
  * For example, `for {} lt(a, b) {} { mstore(1, 2) }` will become
@@ -45,6 +44,7 @@ class ForLoopConditionIntoBody: public ASTModifier
 public:
 	static constexpr char const* name{"ForLoopConditionIntoBody"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _forLoop) override;
@@ -31,6 +31,11 @@ void ForLoopConditionOutOfBody::run(OptimiserStepContext& _context, Block& _ast)
 	ForLoopConditionOutOfBody{_context.dialect}(_ast);
 }
 
+LocalStepRunner ForLoopConditionOutOfBody::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { ForLoopConditionOutOfBody{_context.dialect}.visit(_statement); };
+}
+
 void ForLoopConditionOutOfBody::operator()(ForLoop& _forLoop)
 {
 	ASTModifier::operator()(_forLoop);
@@ -60,9 +65,9 @@ void ForLoopConditionOutOfBody::operator()(ForLoop& _forLoop)
 		holds_alternative<FunctionCall>(*firstStatement.condition) &&
 		std::get<FunctionCall>(*firstStatement.condition).functionName.name == iszero
 	)
-		_forLoop.condition = make_unique<Expression>(std::move(std::get<FunctionCall>(*firstStatement.condition).arguments.front()));
+		_forLoop.condition = makeNode<Expression>(std::move(std::get<FunctionCall>(*firstStatement.condition).arguments.front()));
 	else
-		_forLoop.condition = make_unique<Expression>(FunctionCall{
+		_forLoop.condition = makeNode<Expression>(FunctionCall{
 			location,
 			Identifier{location, iszero},
 			util::make_vector<Expression>(
@@ -60,6 +60,7 @@ class ForLoopConditionOutOfBody: public ASTModifier
 public:
 	static constexpr char const* name{"ForLoopConditionOutOfBody"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _forLoop) override;
@@ -49,3 +49,8 @@ void ForLoopInitRewriter::operator()(Block& _block)
 		}
 	);
 }
+
+LocalStepRunner ForLoopInitRewriter::localRunner(OptimiserStepContext&, Block const&)
+{
+	return [](Statement& _statement, NameDispenser&) { ForLoopInitRewriter{}.visit(_statement); };
+}
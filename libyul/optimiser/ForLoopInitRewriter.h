@@ -36,6 +36,7 @@ public:
 	{
 		ForLoopInitRewriter{}(_ast);
 	}
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
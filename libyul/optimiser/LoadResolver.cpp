@@ -37,11 +37,25 @@ void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		make_shared<map<YulString, SideEffects> const>(
+			SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		),
 		!containsMSize
 	}(_ast);
 }
 
+LocalStepRunner LoadResolver::localRunner(OptimiserStepContext& _context, Block const& _ast)
+{
+	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	auto functionSideEffects = make_shared<map<YulString, SideEffects> const>(
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	);
+	Dialect const& dialect = _context.dialect;
+	return [functionSideEffects, &dialect, containsMSize](Statement& _statement, NameDispenser&) {
+		LoadResolver{dialect, functionSideEffects, !containsMSize}.visit(_statement);
+	};
+}
+
 void LoadResolver::visit(Expression& _e)
 {
 	DataFlowAnalyzer::visit(_e);
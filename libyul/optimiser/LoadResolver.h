@@ -46,11 +46,12 @@ public:
 	static constexpr char const* name{"LoadResolver"};
 	/// Run the load resolver on the given complete AST.
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 private:
 	LoadResolver(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects,
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects,
 		bool _optimizeMLoad
 	):
 		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
@@ -40,6 +40,19 @@ void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
 }
 
+LocalStepRunner LoopInvariantCodeMotion::localRunner(OptimiserStepContext& _context, Block const& _ast)
+{
+	auto functionSideEffects = make_shared<map<YulString, SideEffects>>(
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	);
+	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	auto ssaVars = make_shared<set<YulString>>(SSAValueTracker::ssaVariables(_ast));
+	Dialect const& dialect = _context.dialect;
+	return [=, &dialect](Statement& _statement, NameDispenser&) {
+		LoopInvariantCodeMotion{dialect, *ssaVars, *functionSideEffects, containsMSize}.visit(_statement);
+	};
+}
+
 void LoopInvariantCodeMotion::operator()(Block& _block)
 {
 	util::iterateReplacing(
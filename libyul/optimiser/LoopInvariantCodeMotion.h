@@ -42,6 +42,7 @@ class LoopInvariantCodeMotion: public ASTModifier
 public:
 	static constexpr char const* name{"LoopInvariantCodeMotion"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext& _context, Block const& _ast);
 
 	void operator()(Block& _block) override;
 
@@ -45,8 +45,22 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 {
 }
 
+NameDispenser::NameDispenser(Dialect const& _dialect, size_t _part):
+	m_dialect(_dialect),
+	m_part(_part)
+{
+}
+
 YulString NameDispenser::newName(YulString _nameHint)
 {
+	if (m_part)
+	{
+		// '@' is not allowed in identifiers, so provisional names do not clash with real ones.
+		YulString name{"@" + to_string(*m_part) + "_" + to_string(++m_counter)};
+		m_provisionalNames.emplace_back(name, _nameHint);
+		return name;
+	}
+
 	YulString name = _nameHint;
 	while (illegalName(name))
 	{
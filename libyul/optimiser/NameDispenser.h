@@ -24,7 +24,10 @@
 
 #include <libyul/YulString.h>
 
+#include <optional>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -43,6 +46,11 @@ public:
 	explicit NameDispenser(Dialect const& _dialect, Block const& _ast, std::set<YulString> _reservedNames = {});
 	/// Initialize the name dispenser with the given used names.
 	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames);
+	/// Initialize a name dispenser for the @a _part-th of several functions that are optimised
+	/// concurrently. It hands out provisional names that cannot clash with names in the source
+	/// or with those of other parts and records the hints they were requested for, so that they
+	/// can later be replaced by the names the main dispenser would have returned.
+	NameDispenser(Dialect const& _dialect, size_t _part);
 
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulString newName(YulString _nameHint);
@@ -51,12 +59,17 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
+	/// @returns the provisional names handed out so far, in creation order, together with their hints.
+	std::vector<std::pair<YulString, YulString>> const& provisionalNames() const { return m_provisionalNames; }
+
 private:
 	bool illegalName(YulString _name);
 
 	Dialect const& m_dialect;
 	std::set<YulString> m_usedNames;
 	size_t m_counter = 0;
+	std::optional<size_t> m_part;
+	std::vector<std::pair<YulString, YulString>> m_provisionalNames;
 };
 
 }
@@ -23,7 +23,8 @@
 
 #include <libsolutil/CommonData.h>
 
-#include <regex>
+#include <algorithm>
+#include <string_view>
 
 using namespace solidity::yul;
 using namespace std;
@@ -77,35 +78,166 @@ void NameSimplifier::operator()(FunctionCall& _funCall)
 	ASTModifier::operator()(_funCall);
 }
 
+namespace
+{
+
+bool isDigit(char _c) { return '0' <= _c && _c <= '9'; }
+bool isLowerHexDigit(char _c) { return isDigit(_c) || ('a' <= _c && _c <= 'f'); }
+
+/// Replaces all non-overlapping occurrences of @a _pattern by @a _substitute, scanning from the left.
+string replaceAll(string const& _name, string_view _pattern, string_view _substitute)
+{
+	size_t pos = _name.find(_pattern);
+	if (pos == string::npos)
+		return _name;
+	string result;
+	result.reserve(_name.size());
+	size_t copied = 0;
+	for (; pos != string::npos; pos = _name.find(_pattern, copied))
+	{
+		result.append(_name, copied, pos - copied);
+		result.append(_substitute);
+		copied = pos + _pattern.size();
+	}
+	result.append(_name, copied, string::npos);
+	return result;
+}
+
+/// Removes AST IDs, i.e. "_$" followed by digits.
+string removeASTIDs(string const& _name)
+{
+	string result;
+	result.reserve(_name.size());
+	for (size_t i = 0; i < _name.size(); i++)
+		if (_name[i] == '_' && i + 2 < _name.size() && _name[i + 1] == '$' && isDigit(_name[i + 2]))
+		{
+			i += 2;
+			while (i + 1 < _name.size() && isDigit(_name[i + 1]))
+				i++;
+		}
+		else
+			result.push_back(_name[i]);
+	return result;
+}
+
+/// Removes the last "_to_" and everything after it from ABI functions, i.e. from
+/// the first occurrence of "abi_..code".
+string removeABITargetTypes(string const& _name)
+{
+	for (size_t pos = _name.find("abi_"); pos != string::npos; pos = _name.find("abi_", pos + 1))
+		if (_name.size() >= pos + 10 && _name.compare(pos + 6, 4, "code") == 0)
+		{
+			size_t to = _name.rfind("_to_");
+			if (to == string::npos || to < pos + 10)
+				return _name;
+			return _name.substr(0, to);
+		}
+	return _name;
+}
+
+/// Shortens the hash of string literals to four digits.
+string shortenStringLiterals(string const& _name)
+{
+	static string_view constexpr prefix = "stringliteral_";
+	size_t pos = _name.find(prefix);
+	if (pos == string::npos)
+		return _name;
+	string result;
+	result.reserve(_name.size());
+	size_t copied = 0;
+	for (; pos != string::npos; pos = _name.find(prefix, pos + 1))
+	{
+		size_t hashStart = pos + prefix.size();
+		if (
+			hashStart + 4 > _name.size() ||
+			!all_of(_name.begin() + static_cast<ptrdiff_t>(hashStart), _name.begin() + static_cast<ptrdiff_t>(hashStart + 4), isLowerHexDigit)
+		)
+			continue;
+		size_t hashEnd = hashStart + 4;
+		result.append(_name, copied, hashEnd - copied);
+		while (hashEnd < _name.size() && isLowerHexDigit(_name[hashEnd]))
+			hashEnd++;
+		copied = hashEnd;
+		pos = hashEnd - 1;
+	}
+	result.append(_name, copied, string::npos);
+	return result;
+}
+
+/// Replaces "t_contract$_<name>_" by "<name>_".
+string removeContractTypePrefix(string const& _name)
+{
+	static string_view constexpr prefix = "t_contract$_";
+	size_t pos = _name.find(prefix);
+	if (pos == string::npos)
+		return _name;
+	string result;
+	result.reserve(_name.size());
+	size_t copied = 0;
+	for (; pos != string::npos; pos = _name.find(prefix, pos + 1))
+	{
+		size_t nameStart = pos + prefix.size();
+		size_t nameEnd = _name.find('_', nameStart);
+		if (nameEnd == string::npos)
+			break;
+		result.append(_name, copied, pos - copied);
+		result.append(_name, nameStart, nameEnd + 1 - nameStart);
+		copied = nameEnd + 1;
+		pos = nameEnd;
+	}
+	result.append(_name, copied, string::npos);
+	return result;
+}
+
+/// Removes a trailing underscore together with the digits preceding it.
+string removeTrailingNumber(string const& _name)
+{
+	if (_name.empty() || _name.back() != '_')
+		return _name;
+	size_t end = _name.size() - 1;
+	while (end > 0 && isDigit(_name[end - 1]))
+		end--;
+	return _name.substr(0, end);
+}
+
+}
+
+vector<string(*)(string const&)> const& NameSimplifier::rewrites()
+{
+	static vector<string(*)(string const&)> const rewrites{
+		removeASTIDs,
+		removeABITargetTypes,
+		shortenStringLiterals,
+		[](string const& _name) { return replaceAll(_name, "tuple_t_", ""); },
+		[](string const& _name) { return replaceAll(_name, "_memory_ptr", ""); },
+		[](string const& _name) { return replaceAll(_name, "_calldata_ptr", "_calldata"); },
+		[](string const& _name) { return replaceAll(_name, "_fromStack", ""); },
+		[](string const& _name) { return replaceAll(_name, "_storage_storage", "_storage"); },
+		[](string const& _name) { return replaceAll(_name, "_memory_memory", "_memory"); },
+		removeContractTypePrefix,
+		[](string const& _name) { return replaceAll(_name, "index_access_t_array", "index_access"); },
+		removeTrailingNumber
+	};
+	return rewrites;
+}
+
 void NameSimplifier::findSimplification(YulString _name)
 {
 	if (m_translations.count(_name))
 		return;
 
 	string name = _name.str();
-
-	static auto replacements = vector<pair<regex, string>>{
-		{regex("_\\$\\d+"), ""}, // removes AST IDs
-		{regex("(abi_..code.*)_to_.*"), "$1"}, // removes _to... for abi functions
-		{regex("(stringliteral_[0-9a-f][0-9a-f][0-9a-f][0-9a-f])[0-9a-f]*"), "$1"}, // shorten string literal
-		{regex("tuple_t_"), ""},
-		{regex("_memory_ptr"), ""},
-		{regex("_calldata_ptr"), "_calldata"},
-		{regex("_fromStack"), ""},
-		{regex("_storage_storage"), "_storage"},
-		{regex("_memory_memory"), "_memory"},
-		{regex("t_contract\\$_([^_]*)_"), "$1_"},
-		{regex("index_access_t_array"), "index_access"},
-		{regex("[0-9]*_$"), ""}
-	};
-	for (auto const& [pattern, substitute]: replacements)
+	for (auto const& rewrite: rewrites())
 	{
-		string candidate = regex_replace(name, pattern, substitute);
+		string candidate = rewrite(name);
+		// Rewrites that do not apply leave the name unchanged, which needs no further checks.
+		if (candidate == name)
+			continue;
 		if (
 			!isRestrictedIdentifier(m_context.dialect, YulString(candidate)) &&
 			!m_usedNames.count(YulString(candidate))
 		)
-			name = candidate;
+			name = move(candidate);
 	}
 	if (name != _name.str())
 	{
@@ -26,6 +26,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -56,6 +57,10 @@ public:
 	void operator()(FunctionCall& _funCall) override;
 	void operator()(FunctionDefinition& _funDef) override;
 
+	/// The rewrites applied to each name in turn. The result of a rewrite is only used
+	/// if it does not clash with another name.
+	static std::vector<std::string(*)(std::string const&)> const& rewrites();
+
 private:
 	NameSimplifier(
 		OptimiserStepContext& _context,
@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <libyul/AsmDataForward.h>
 #include <libyul/Exceptions.h>
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <set>
@@ -28,7 +30,6 @@ namespace solidity::yul
 {
 
 struct Dialect;
-struct Block;
 class YulString;
 class NameDispenser;
 
@@ -39,6 +40,15 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 };
 
+/**
+ * Applies an optimiser step to a single top-level statement of a grouped AST, i.e. to the
+ * outermost block or to a function definition. Information about the whole AST that the step
+ * needs is collected when the runner is created, so it has to be created again after other
+ * steps changed the AST. New names are requested from the dispenser that is passed along with
+ * the statement. The runner can be invoked concurrently for different statements.
+ */
+using LocalStepRunner = std::function<void(Statement&, NameDispenser&)>;
+
 
 /**
  * Construction to create dynamically callable objects out of the
@@ -54,6 +64,10 @@ struct OptimiserStep
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
 	virtual std::optional<std::string> invalidInCurrentEnvironment() const = 0;
+	/// @returns a runner that applies the step to top-level statements of @a _ast separately
+	/// or an empty function if the step needs to see the whole AST, for example because it
+	/// changes function signatures or moves code between functions.
+	virtual LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast) const = 0;
 	std::string name;
 };
 
@@ -71,6 +85,19 @@ private:
 	public:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
+	template<typename T>
+	struct HasLocalRunnerMethod
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(
+			U::localRunner(std::declval<OptimiserStepContext&>(), std::declval<Block const&>()),
+			std::true_type()
+		);
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
 
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
@@ -85,6 +112,13 @@ public:
 		else
 			return std::nullopt;
 	};
+	LocalStepRunner localRunner(OptimiserStepContext& _context, Block const& _ast) const override
+	{
+		if constexpr (HasLocalRunnerMethod<Step>::value)
+			return Step::localRunner(_context, _ast);
+		else
+			return {};
+	}
 };
 
 
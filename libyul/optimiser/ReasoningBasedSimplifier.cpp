@@ -81,7 +81,7 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.location = locationOf(*_if.condition);
-		_if.condition = make_unique<yul::Expression>(move(trueCondition));
+		_if.condition = makeNode<yul::Expression>(move(trueCondition));
 	}
 	else
 	{
@@ -93,7 +93,7 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 		{
 			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
 			falseCondition.location = locationOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(move(falseCondition));
+			_if.condition = makeNode<yul::Expression>(move(falseCondition));
 			_if.body = yul::Block{};
 			// Nothing left to be done.
 			return;
@@ -42,6 +42,17 @@ void RedundantAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	remover(_ast);
 }
 
+LocalStepRunner RedundantAssignEliminator::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) {
+		RedundantAssignEliminator rae{_context.dialect};
+		rae.visit(_statement);
+
+		AssignmentRemover remover{rae.m_pendingRemovals};
+		remover.visit(_statement);
+	};
+}
+
 void RedundantAssignEliminator::operator()(Identifier const& _identifier)
 {
 	changeUndecidedTo(_identifier.name, State::Used);
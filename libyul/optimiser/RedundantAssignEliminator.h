@@ -111,6 +111,7 @@ class RedundantAssignEliminator: public ASTWalker
 public:
 	static constexpr char const* name{"RedundantAssignEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	explicit RedundantAssignEliminator(Dialect const& _dialect): m_dialect(&_dialect) {}
 	RedundantAssignEliminator() = delete;
@@ -44,6 +44,17 @@ void Rematerialiser::run(
 	Rematerialiser{_dialect, _function, std::move(_varsToAlwaysRematerialize)}(_function);
 }
 
+LocalStepRunner Rematerialiser::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	// Reference counts are only needed for variables, which are local to the statement.
+	return [&_context](Statement& _statement, NameDispenser&) {
+		if (auto* function = get_if<FunctionDefinition>(&_statement))
+			run(_context.dialect, *function);
+		else
+			run(_context.dialect, std::get<Block>(_statement));
+	};
+}
+
 Rematerialiser::Rematerialiser(
 	Dialect const& _dialect,
 	Block& _ast,
@@ -115,3 +126,8 @@ void LiteralRematerialiser::visit(Expression& _e)
 	}
 	DataFlowAnalyzer::visit(_e);
 }
+
+LocalStepRunner LiteralRematerialiser::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { LiteralRematerialiser{_context.dialect}.visit(_statement); };
+}
@@ -46,6 +46,7 @@ public:
 		OptimiserStepContext& _context,
 		Block& _ast
 	) { run(_context.dialect, _ast); }
+	static LocalStepRunner localRunner(OptimiserStepContext& _context, Block const& _ast);
 
 	static void run(
 		Dialect const& _dialect,
@@ -96,6 +97,7 @@ public:
 		OptimiserStepContext& _context,
 		Block& _ast
 	) { LiteralRematerialiser{_context.dialect}(_ast); }
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
@@ -33,6 +33,15 @@ void SSAReverser::run(OptimiserStepContext&, Block& _block)
 	SSAReverser{assignmentCounter}(_block);
 }
 
+LocalStepRunner SSAReverser::localRunner(OptimiserStepContext&, Block const&)
+{
+	return [](Statement& _statement, NameDispenser&) {
+		AssignmentCounter assignmentCounter;
+		assignmentCounter.visit(_statement);
+		SSAReverser{assignmentCounter}.visit(_statement);
+	};
+}
+
 void SSAReverser::operator()(Block& _block)
 {
 	walkVector(_block.statements);
@@ -73,7 +82,7 @@ void SSAReverser::operator()(Block& _block)
 							VariableDeclaration{
 								std::move(varDecl->location),
 								std::move(varDecl->variables),
-								std::make_unique<Expression>(assignment->variableNames.front())
+								makeNode<Expression>(assignment->variableNames.front())
 							}
 						);
 				}
@@ -96,7 +105,7 @@ void SSAReverser::operator()(Block& _block)
 					)
 				)
 				{
-					auto varIdentifier2 = std::make_unique<Expression>(Identifier{
+					auto varIdentifier2 = makeNode<Expression>(Identifier{
 						varDecl2->variables.front().location,
 						varDecl2->variables.front().name
 					});
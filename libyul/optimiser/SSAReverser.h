@@ -73,6 +73,7 @@ class SSAReverser: public ASTModifier
 public:
 	static constexpr char const* name{"SSAReverser"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext& _context, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
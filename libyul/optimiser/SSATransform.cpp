@@ -48,7 +48,7 @@ public:
 	explicit IntroduceSSA(
 		NameDispenser& _nameDispenser,
 		set<YulString> const& _variablesToReplace,
-		TypeInfo& _typeInfo
+		TypeInfo const& _typeInfo
 	):
 		m_nameDispenser(_nameDispenser),
 		m_variablesToReplace(_variablesToReplace),
@@ -97,7 +97,7 @@ void IntroduceSSA::operator()(Block& _block)
 					statements.emplace_back(VariableDeclaration{
 						loc,
 						{TypedName{loc, oldName, var.type}},
-						make_unique<Expression>(Identifier{loc, newName})
+						makeNode<Expression>(Identifier{loc, newName})
 					});
 				}
 				std::get<VariableDeclaration>(statements.front()).variables = std::move(newVariables);
@@ -128,7 +128,7 @@ void IntroduceSSA::operator()(Block& _block)
 					statements.emplace_back(Assignment{
 						loc,
 						{Identifier{loc, oldName}},
-						make_unique<Expression>(Identifier{loc, newName})
+						makeNode<Expression>(Identifier{loc, newName})
 					});
 				}
 				std::get<VariableDeclaration>(statements.front()).variables = std::move(newVariables);
@@ -240,7 +240,7 @@ void IntroduceControlFlowSSA::operator()(Block& _block)
 				toPrepend.emplace_back(VariableDeclaration{
 					locationOf(_s),
 					{TypedName{locationOf(_s), newName, m_typeInfo.typeOfVariable(toReassign)}},
-					make_unique<Expression>(Identifier{locationOf(_s), toReassign})
+					makeNode<Expression>(Identifier{locationOf(_s), toReassign})
 				});
 				assignedVariables.insert(toReassign);
 			}
@@ -397,4 +397,17 @@ void SSATransform::run(OptimiserStepContext& _context, Block& _ast)
 	PropagateValues{assignments.names()}(_ast);
 }
 
+LocalStepRunner SSATransform::localRunner(OptimiserStepContext& _context, Block const& _ast)
+{
+	auto typeInfo = make_shared<TypeInfo>(_context.dialect, _ast);
+	return [typeInfo](Statement& _statement, NameDispenser& _dispenser) {
+		// Variables are local to the statement, so it is enough to collect their assignments there.
+		Assignments assignments;
+		assignments.visit(_statement);
+		IntroduceSSA{_dispenser, assignments.names(), *typeInfo}.visit(_statement);
+		IntroduceControlFlowSSA{_dispenser, assignments.names(), *typeInfo}.visit(_statement);
+		PropagateValues{assignments.names()}.visit(_statement);
+	};
+}
+
 
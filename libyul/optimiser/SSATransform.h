@@ -93,6 +93,7 @@ class SSATransform: public ASTModifier
 public:
 	static constexpr char const* name{"SSATransform"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext& _context, Block const& _ast);
 };
 
 }
@@ -31,6 +31,8 @@
 
 #include <libevmasm/RuleList.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -47,21 +49,14 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
-
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
 		version = evmDialect->evmVersion();
-
-	if (!evmRules[version])
-		evmRules[version] = std::make_unique<SimplificationRules>(version);
-
-	SimplificationRules& rules = *evmRules[version];
-	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
+	SimplificationRules const& rules = rulesFor(version);
 
 	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
 	{
-		rules.resetMatchGroups();
+		resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -69,6 +64,32 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	return nullptr;
 }
 
+map<unsigned, Expression const*>& SimplificationRules::matchGroups()
+{
+	static thread_local map<unsigned, Expression const*> groups;
+	return groups;
+}
+
+SimplificationRules const& SimplificationRules::rulesFor(std::optional<EVMVersion> _evmVersion)
+{
+	// Each thread remembers the rule lists it has used, so the mutex is only taken once
+	// per thread and EVM version.
+	static thread_local map<std::optional<EVMVersion>, SimplificationRules const*> threadRules;
+	SimplificationRules const*& rules = threadRules[_evmVersion];
+	if (!rules)
+	{
+		static mutex rulesMutex;
+		static map<std::optional<EVMVersion>, unique_ptr<SimplificationRules const>> evmRules;
+		lock_guard<mutex> lock(rulesMutex);
+		unique_ptr<SimplificationRules const>& sharedRules = evmRules[_evmVersion];
+		if (!sharedRules)
+			sharedRules = make_unique<SimplificationRules const>(_evmVersion);
+		rules = sharedRules.get();
+	}
+	assertThrow(rules->isInitialized(), OptimizerException, "Rule list not properly initialized.");
+	return *rules;
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -109,13 +130,13 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
@@ -128,10 +149,9 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group)
 {
 	m_matchGroup = _group;
-	m_matchGroups = &_matchGroups;
 }
 
 bool Pattern::matches(
@@ -202,10 +222,11 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		auto& matchGroups = SimplificationRules::matchGroups();
+		if (matchGroups.count(m_matchGroup))
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
+			Expression const* firstMatch = matchGroups[m_matchGroup];
 			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
 			assertThrow(
 				!holds_alternative<FunctionCall>(_expr) &&
@@ -217,12 +238,12 @@ bool Pattern::matches(
 			return SyntacticallyEqual{}(*firstMatch, _expr);
 		}
 		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
+			matchGroups[m_matchGroup] = &_expr;
 		else
 		{
 			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
 			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			matchGroups[m_matchGroup] = expr;
 		}
 	}
 	return true;
@@ -269,7 +290,7 @@ u256 Pattern::d() const
 Expression const& Pattern::matchGroupValue() const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	auto& matchGroups = SimplificationRules::matchGroups();
+	assertThrow(matchGroups[m_matchGroup], OptimizerException, "");
+	return *matchGroups[m_matchGroup];
 }
@@ -53,7 +53,8 @@ public:
 	explicit SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion = std::nullopt);
 
 	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// groups accordingly. The rule lists are built once per EVM version and shared by all
+	/// threads, the match groups are stored per thread.
 	/// @param _ssaValues values of variables that are assigned exactly once.
 	static Rule const* findFirstMatch(
 		Expression const& _expr,
@@ -68,13 +69,18 @@ public:
 	static std::optional<std::pair<evmasm::Instruction, std::vector<Expression> const*>>
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
+	/// @returns the match groups of the current match on this thread.
+	static std::map<unsigned, Expression const*>& matchGroups();
+
 private:
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	/// @returns the rule list for @a _evmVersion, building it on first use.
+	static SimplificationRules const& rulesFor(std::optional<langutil::EVMVersion> _evmVersion);
+
+	static void resetMatchGroups() { matchGroups().clear(); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
 };
 
@@ -110,7 +116,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -137,7 +143,6 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
 }
@@ -155,7 +155,7 @@ void StackToMemoryMover::operator()(Block& _block)
 			else
 				variableAssignments.emplace_back(StatementType{
 					loc, {move(var)},
-					make_unique<Expression>(Identifier{loc, tempVarName})
+					makeNode<Expression>(Identifier{loc, tempVarName})
 				});
 		}
 		std::vector<Statement> result;
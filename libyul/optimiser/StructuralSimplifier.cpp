@@ -64,6 +64,11 @@ void StructuralSimplifier::run(OptimiserStepContext&, Block& _ast)
 	StructuralSimplifier{}(_ast);
 }
 
+LocalStepRunner StructuralSimplifier::localRunner(OptimiserStepContext&, Block const&)
+{
+	return [](Statement& _statement, NameDispenser&) { StructuralSimplifier{}.visit(_statement); };
+}
+
 void StructuralSimplifier::operator()(Block& _block)
 {
 	simplify(_block.statements);
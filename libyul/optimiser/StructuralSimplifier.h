@@ -43,6 +43,7 @@ class StructuralSimplifier: public ASTModifier
 public:
 	static constexpr char const* name{"StructuralSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
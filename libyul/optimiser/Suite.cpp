@@ -66,16 +66,22 @@
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/Object.h>
+#include <libyul/SideEffects.h>
 
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 #include <libyul/CompilabilityChecker.h>
 
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -86,7 +92,9 @@ void OptimiserSuite::run(
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _threads,
+	bool _skipUnchangedFunctions
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -99,7 +107,7 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _threads, _skipUnchangedFunctions);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -163,45 +171,268 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 	return ret;
 }
 
+/// @returns the name of the function defined by a top-level statement or the empty name
+/// for the outermost block and all other statements.
+YulString topLevelName(Statement const& _statement)
+{
+	if (auto const* function = get_if<FunctionDefinition>(&_statement))
+		return function->name;
+	return {};
+}
+
+/**
+ * Hash of the syntax of a piece of code, including all names, used to find the functions
+ * an optimiser step changed. Other than BlockHasher, it does not abstract away variable names
+ * and works on any AST.
+ */
+class SyntaxHasher: public ASTWalker
+{
+public:
+	static uint64_t hash(Statement const& _statement)
+	{
+		SyntaxHasher hasher;
+		hasher.visit(_statement);
+		return hasher.m_hash;
+	}
+
+	using ASTWalker::operator();
+	void operator()(Literal const& _literal) override
+	{
+		add(Kind::Literal);
+		add(_literal.value.hash());
+		add(_literal.type.hash());
+		add(static_cast<uint64_t>(_literal.kind));
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		add(Kind::Identifier);
+		add(_identifier.name.hash());
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		add(Kind::FunctionCall);
+		add(_funCall.functionName.name.hash());
+		add(_funCall.arguments.size());
+		ASTWalker::operator()(_funCall);
+	}
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		add(Kind::ExpressionStatement);
+		ASTWalker::operator()(_statement);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		add(Kind::Assignment);
+		add(_assignment.variableNames.size());
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		add(Kind::VariableDeclaration);
+		add(_varDecl.variables);
+		add(_varDecl.value ? 1 : 0);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(If const& _if) override
+	{
+		add(Kind::If);
+		ASTWalker::operator()(_if);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		add(Kind::Switch);
+		add(_switch.cases.size());
+		visit(*_switch.expression);
+		for (Case const& _case: _switch.cases)
+		{
+			add(_case.value ? 1 : 0);
+			if (_case.value)
+				(*this)(*_case.value);
+			(*this)(_case.body);
+		}
+	}
+	void operator()(FunctionDefinition const& _funDef) override
+	{
+		add(Kind::FunctionDefinition);
+		add(_funDef.name.hash());
+		add(_funDef.parameters);
+		add(_funDef.returnVariables);
+		ASTWalker::operator()(_funDef);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		add(Kind::ForLoop);
+		ASTWalker::operator()(_loop);
+	}
+	void operator()(Break const&) override { add(Kind::Break); }
+	void operator()(Continue const&) override { add(Kind::Continue); }
+	void operator()(Leave const&) override { add(Kind::Leave); }
+	void operator()(Block const& _block) override
+	{
+		add(Kind::Block);
+		add(_block.statements.size());
+		ASTWalker::operator()(_block);
+	}
+
+private:
+	enum class Kind: uint64_t
+	{
+		Literal = 1, Identifier, FunctionCall, ExpressionStatement, Assignment, VariableDeclaration,
+		If, Switch, FunctionDefinition, ForLoop, Break, Continue, Leave, Block
+	};
+
+	void add(Kind _kind) { add(static_cast<uint64_t>(_kind)); }
+	void add(TypedNameList const& _names)
+	{
+		add(_names.size());
+		for (TypedName const& name: _names)
+		{
+			add(name.name.hash());
+			add(name.type.hash());
+		}
+	}
+	void add(uint64_t _value)
+	{
+		// Round function of XXH64, which mixes all bits of the value into the hash.
+		m_hash += _value * 14029467366897019727u;
+		m_hash = (m_hash << 31) | (m_hash >> 33);
+		m_hash *= 11400714785074694791u;
+	}
+
+	uint64_t m_hash = 0;
+};
+
+/// @returns hashes of the top-level statements, indexed by topLevelName. The hash of the empty
+/// name covers all statements that are not function definitions.
+map<YulString, uint64_t> topLevelHashes(Block const& _ast)
+{
+	map<YulString, uint64_t> hashes;
+	for (Statement const& statement: _ast.statements)
+	{
+		uint64_t& hash = hashes[topLevelName(statement)];
+		hash = hash * 31 + SyntaxHasher::hash(statement);
+	}
+	return hashes;
+}
+
+/// Replaces the provisional names handed out while optimising functions concurrently.
+class ProvisionalNameReplacer: public ASTModifier
+{
+public:
+	explicit ProvisionalNameReplacer(map<YulString, YulString> const& _translations):
+		m_translations(_translations)
+	{}
+
+	using ASTModifier::operator();
+	void operator()(Identifier& _identifier) override { replace(_identifier.name); }
+	void operator()(FunctionCall& _funCall) override
+	{
+		replace(_funCall.functionName.name);
+		ASTModifier::operator()(_funCall);
+	}
+	void operator()(VariableDeclaration& _varDecl) override
+	{
+		for (TypedName& variable: _varDecl.variables)
+			replace(variable.name);
+		ASTModifier::operator()(_varDecl);
+	}
+	void operator()(FunctionDefinition& _funDef) override
+	{
+		replace(_funDef.name);
+		for (TypedName& parameter: _funDef.parameters)
+			replace(parameter.name);
+		for (TypedName& returnVariable: _funDef.returnVariables)
+			replace(returnVariable.name);
+		ASTModifier::operator()(_funDef);
+	}
+
+private:
+	void replace(YulString& _name) const
+	{
+		if (auto it = m_translations.find(_name); it != m_translations.end())
+			_name = it->second;
+	}
+
+	map<YulString, YulString> const& m_translations;
+};
+
+/// Adds the names to @a _changed that are missing in @a _before or whose hash differs.
+void addChanged(map<YulString, uint64_t> const& _before, map<YulString, uint64_t> const& _after, set<YulString>& _changed)
+{
+	for (auto const& [name, hash]: _after)
+		if (!_before.count(name) || _before.at(name) != hash)
+			_changed.insert(name);
+}
+
+}
+
+set<YulString> ChangedFunctionTracker::nextRound(Block const& _ast)
+{
+	map<YulString, uint64_t> hashes = topLevelHashes(_ast);
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	map<YulString, SideEffects> sideEffects = SideEffectsPropagator::sideEffects(m_dialect, callGraph);
+	bool containsMSize = MSizeFinder::containsMSize(m_dialect, _ast);
+
+	set<YulString> functions;
+	if (m_firstRound || containsMSize != m_containsMSize)
+		functions = util::keys(hashes);
+	else
+	{
+		addChanged(m_hashes, hashes, functions);
+		set<YulString> changedSideEffects;
+		for (auto const& [name, effects]: sideEffects)
+			if (!m_sideEffects.count(name) || !(m_sideEffects.at(name) == effects))
+				changedSideEffects.insert(name);
+		for (auto const& [caller, callees]: callGraph.functionCalls)
+			for (YulString callee: callees)
+				if (changedSideEffects.count(callee))
+				{
+					functions.insert(caller);
+					break;
+				}
+	}
+	m_firstRound = false;
+	m_hashes = std::move(hashes);
+	m_sideEffects = std::move(sideEffects);
+	m_containsMSize = containsMSize;
+	return functions;
 }
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			NameSimplifier,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		NameSimplifier,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	return instance;
 }
@@ -342,7 +573,9 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
+		util::Profiler::Phase phase{"yulOptimizer/", step};
 		allSteps().at(step)->run(m_context, _ast);
+		phase.stop();
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -364,6 +597,11 @@ void OptimiserSuite::runSequenceUntilStable(
 	size_t maxRounds
 )
 {
+	// Steps can only be applied to single functions if the AST is grouped. Grouping does not
+	// change the semantics and is done at the end of the optimisation in any case.
+	FunctionGrouper::run(m_context, _ast);
+
+	ChangedFunctionTracker tracker(m_context.dialect);
 	size_t codeSize = 0;
 	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
 	{
@@ -372,6 +610,82 @@ void OptimiserSuite::runSequenceUntilStable(
 			break;
 		codeSize = newSize;
 
-		runSequence(_steps, _ast);
+		set<YulString> functions =
+			m_skipUnchangedFunctions ?
+			tracker.nextRound(_ast) :
+			util::keys(topLevelHashes(_ast));
+		runSequenceOnFunctions(_steps, _ast, functions);
+	}
+}
+
+void OptimiserSuite::runSequenceOnFunctions(
+	vector<string> const& _steps,
+	Block& _ast,
+	set<YulString>& _functions
+)
+{
+	for (string const& step: _steps)
+	{
+		if (m_debug == Debug::PrintStep)
+			cout << "Running " << step << endl;
+		OptimiserStep const& optimiserStep = *allSteps().at(step);
+		util::Profiler::Phase phase{"yulOptimizer/", step};
+		LocalStepRunner runner;
+		if (FunctionGrouper::alreadyGrouped(_ast))
+			runner = optimiserStep.localRunner(m_context, _ast);
+		if (runner)
+		{
+			vector<Statement*> statements;
+			for (Statement& statement: _ast.statements)
+				if (_functions.count(topLevelName(statement)))
+					statements.push_back(&statement);
+			// Even a sequential run uses provisional names, so that the optimisers see the
+			// same names (and iterate over them in the same order) for any number of threads.
+			phase.addCPUTime(runConcurrently(runner, statements));
+		}
+		else
+		{
+			map<YulString, uint64_t> hashes = topLevelHashes(_ast);
+			optimiserStep.run(m_context, _ast);
+			addChanged(hashes, topLevelHashes(_ast), _functions);
+		}
+	}
+}
+
+double OptimiserSuite::runConcurrently(LocalStepRunner const& _runner, vector<Statement*> const& _statements)
+{
+	vector<NameDispenser> dispensers;
+	dispensers.reserve(_statements.size());
+	for (size_t i = 0; i < _statements.size(); ++i)
+		dispensers.emplace_back(m_context.dialect, i);
+
+	bool const profiling = util::Profiler::active();
+	thread::id const callingThread = this_thread::get_id();
+	mutex helperCPUTimeMutex;
+	double helperCPUTime = 0;
+	YulStringRepository& repository = YulStringRepository::instance();
+	util::parallelFor(_statements.size(), m_threads, [&](size_t _index) {
+		YulStringRepository::Scope repositoryScope{repository};
+		double const cpuStart = profiling ? util::Profiler::threadCPUTime() : 0;
+		_runner(*_statements[_index], dispensers[_index]);
+		if (profiling && this_thread::get_id() != callingThread)
+		{
+			lock_guard<mutex> lock(helperCPUTimeMutex);
+			helperCPUTime += util::Profiler::threadCPUTime() - cpuStart;
+		}
+	});
+
+	// A sequential run would have requested the names in this order, so handing them out now
+	// yields the same names independently of how the statements were scheduled.
+	for (size_t i = 0; i < _statements.size(); ++i)
+	{
+		map<YulString, YulString> translations;
+		for (auto const& [provisionalName, hint]: dispensers[i].provisionalNames())
+			translations[provisionalName] = m_dispenser.newName(
+				translations.count(hint) ? translations.at(hint) : hint
+			);
+		if (!translations.empty())
+			ProvisionalNameReplacer{translations}.visit(*_statements[i]);
 	}
+	return helperCPUTime;
 }
@@ -22,14 +22,17 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
+#include <libyul/SideEffects.h>
 #include <libyul/YulString.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -39,6 +42,34 @@ struct Dialect;
 class GasMeter;
 struct Object;
 
+/**
+ * Determines the top-level statements of a grouped AST that OptimiserSuite::runSequenceUntilStable()
+ * applies the steps to in each round. They are named by the function they define or by the empty
+ * name for the outermost block.
+ * Running the steps again on a function that did not change since the start of the previous round
+ * can only have an effect if something it depends on changed. Apart from the function itself, this
+ * is the side effects of the functions it calls and whether msize is used anywhere.
+ * Functions are compared including the names of their variables, because the steps can make
+ * different decisions for differently named variables.
+ */
+class ChangedFunctionTracker
+{
+public:
+	explicit ChangedFunctionTracker(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	/// @returns the names of the top-level statements of @a _ast to optimise in the next round:
+	/// all of them in the first round and if the use of msize changed, otherwise the ones that
+	/// changed since the previous call and the callers of functions whose side effects changed.
+	std::set<YulString> nextRound(Block const& _ast);
+
+private:
+	Dialect const& m_dialect;
+	bool m_firstRound = true;
+	std::map<YulString, uint64_t> m_hashes;
+	std::map<YulString, SideEffects> m_sideEffects;
+	bool m_containsMSize = false;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
@@ -64,7 +95,9 @@ public:
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _threads = 1,
+		bool _skipUnchangedFunctions = true
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -73,6 +106,10 @@ public:
 
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
 	void runSequence(std::string const& _stepAbbreviations, Block& _ast);
+	/// Repeats @a _steps until the code size does not change any more or @a maxRounds is reached.
+	/// After the first round, steps that work on single functions are only applied to the functions
+	/// that changed in the previous round and to the callers of functions whose side effects changed,
+	/// unless skipping unchanged functions was disabled, see ChangedFunctionTracker.
 	void runSequenceUntilStable(
 		std::vector<std::string> const& _steps,
 		Block& _ast,
@@ -84,20 +121,46 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Runs @a _steps on the grouped AST @a _ast. Steps that provide a local runner are only applied
+	/// to the functions in @a _functions, where the empty name stands for the statements of the
+	/// outermost block. Other steps are run on the whole AST and the functions (or outermost
+	/// statements) they change are added to @a _functions.
+	void runSequenceOnFunctions(
+		std::vector<std::string> const& _steps,
+		Block& _ast,
+		std::set<YulString>& _functions
+	);
+	/// Applies @a _runner to @a _statements on up to m_threads threads. The runner gets provisional
+	/// names, which only depend on the position of the statement, and the final names are handed
+	/// out afterwards in statement order. This is done for any number of threads, so the result
+	/// does not depend on it.
+	/// @returns the CPU time in milliseconds spent by threads other than the calling one, if a
+	/// profiler is active, and zero otherwise.
+	double runConcurrently(LocalStepRunner const& _runner, std::vector<Statement*> const& _statements);
+
 	OptimiserSuite(
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		size_t _threads = 1,
+		bool _skipUnchangedFunctions = true
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
 		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_debug(_debug),
+		m_threads(_threads),
+		m_skipUnchangedFunctions(_skipUnchangedFunctions)
 	{}
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Maximal number of threads used to run steps on different functions concurrently.
+	size_t m_threads = 1;
+	/// Whether runSequenceUntilStable() only optimises the functions that changed, otherwise all
+	/// functions are optimised in every round, which yields the same code.
+	bool m_skipUnchangedFunctions = true;
 };
 
 }
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
+#include <libyul/NodePool.h>
 #include <libyul/YulString.h>
 
 #include <map>
@@ -75,7 +76,7 @@ private:
 	}
 
 	template<typename T, bool (SyntacticallyEqual::*CompareMember)(T const&, T const&)>
-	bool compareUniquePtr(std::unique_ptr<T> const& _lhs, std::unique_ptr<T> const& _rhs)
+	bool compareUniquePtr(NodePointer<T> const& _lhs, NodePointer<T> const& _rhs)
 	{
 		return (_lhs == _rhs) || (_lhs && _rhs && (this->*CompareMember)(*_lhs, *_rhs));
 	}
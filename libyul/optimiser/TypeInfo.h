@@ -40,8 +40,6 @@ class TypeInfo
 public:
 	TypeInfo(Dialect const& _dialect, Block const& _ast);
 
-	void setVariableType(YulString _name, YulString _type) { m_variableTypes[_name] = _type; }
-
 	/// @returns the type of an expression that is assumed to return exactly one value.
 	YulString typeOf(Expression const& _expression) const;
 
@@ -93,7 +93,7 @@ FunctionDefinition createLinkingFunction(
 		linkingFunction.body.statements.emplace_back(ExpressionStatement{loc, std::move(call)});
 	else
 	{
-		assignment.value = std::make_unique<Expression>(std::move(call));
+		assignment.value = makeNode<Expression>(std::move(call));
 		linkingFunction.body.statements.emplace_back(std::move(assignment));
 	}
 
@@ -41,7 +41,7 @@ void VarDeclInitializer::operator()(Block& _block)
 
 			if (_varDecl.variables.size() == 1)
 			{
-				_varDecl.value = make_unique<Expression>(m_dialect.zeroLiteralForType(_varDecl.variables.front().type));
+				_varDecl.value = makeNode<Expression>(m_dialect.zeroLiteralForType(_varDecl.variables.front().type));
 				return {};
 			}
 			else
@@ -50,7 +50,7 @@ void VarDeclInitializer::operator()(Block& _block)
 				langutil::SourceLocation loc{std::move(_varDecl.location)};
 				for (auto& var: _varDecl.variables)
 				{
-					unique_ptr<Expression> expr = make_unique<Expression >(m_dialect.zeroLiteralForType(var.type));
+					NodePointer<Expression> expr = makeNode<Expression>(m_dialect.zeroLiteralForType(var.type));
 					ret->emplace_back(VariableDeclaration{loc, {std::move(var)}, std::move(expr)});
 				}
 				return ret;
@@ -60,3 +60,8 @@ void VarDeclInitializer::operator()(Block& _block)
 
 	util::iterateReplacing(_block.statements, [&](auto&& _statement) { return std::visit(visitor, _statement); });
 }
+
+LocalStepRunner VarDeclInitializer::localRunner(OptimiserStepContext& _context, Block const&)
+{
+	return [&_context](Statement& _statement, NameDispenser&) { VarDeclInitializer{_context.dialect}.visit(_statement); };
+}
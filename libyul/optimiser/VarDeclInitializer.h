@@ -36,6 +36,7 @@ class VarDeclInitializer: public ASTModifier
 public:
 	static constexpr char const* name{"VarDeclInitializer"};
 	static void run(OptimiserStepContext& _ctx, Block& _ast) { VarDeclInitializer{_ctx.dialect}(_ast); }
+	static LocalStepRunner localRunner(OptimiserStepContext&, Block const& _ast);
 
 	void operator()(Block& _block) override;
 
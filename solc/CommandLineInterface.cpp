@@ -28,6 +28,7 @@
 
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
+#include <libsolidity/ast/ASTBinaryFormat.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
@@ -54,6 +55,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <memory>
 
@@ -62,6 +64,8 @@
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 
 #ifdef _WIN32 // windows
 	#include <io.h>
@@ -117,8 +121,11 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strCacheSize = "cache-size";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -161,8 +168,12 @@ static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
+static string const g_strServer = "server";
+static string const g_strServerSocket = "server-socket";
 static string const g_strStorageLayout = "storage-layout";
 static string const g_strStopAfter = "stop-after";
+static string const g_strThreads = "threads";
+static string const g_strTimeReport = "time-report";
 static string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -198,6 +209,7 @@ static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
 static string const g_argAstCompactJson = g_strAstCompactJson;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
@@ -303,6 +315,62 @@ static void license()
 	exit(0);
 }
 
+/// Reads a message that is preceded by header lines, which are ended by an empty line and have to
+/// include "Content-Length: <size of the message in bytes>".
+/// @returns nullopt at the end of the input.
+/// @throws std::exception if the message is not framed correctly.
+static optional<string> readFramedMessage(istream& _input)
+{
+	string line;
+	bool headerFound = false;
+	optional<size_t> length;
+	while (getline(_input, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+		{
+			if (headerFound)
+				break;
+			// Empty lines between messages are ignored.
+			continue;
+		}
+		headerFound = true;
+		static string const contentLength = "Content-Length:";
+		if (boost::istarts_with(line, contentLength))
+			length = stoul(line.substr(contentLength.size()));
+	}
+	if (!headerFound)
+		return nullopt;
+	if (!length)
+		throw runtime_error("Missing Content-Length header.");
+	string message(*length, '\0');
+	if (!_input.read(message.data(), static_cast<streamsize>(*length)))
+		throw runtime_error("Unexpected end of input.");
+	return message;
+}
+
+/// Compiles the standard JSON inputs read from @a _input and writes each output to @a _output,
+/// both framed as described for readFramedMessage().
+/// @returns false if the input is not framed correctly.
+static bool serveStandardJson(StandardCompiler& _compiler, istream& _input, ostream& _output)
+{
+	try
+	{
+		while (optional<string> input = readFramedMessage(_input))
+		{
+			string const output = _compiler.compile(*input);
+			_output << "Content-Length: " << output.size() << "\r\n\r\n" << output << flush;
+		}
+	}
+	catch (std::exception const& _exception)
+	{
+		serr() << "Invalid request: " << _exception.what() << endl;
+		return false;
+	}
+	return true;
+}
+
 static bool needsHumanTargetedStdout(po::variables_map const& _args)
 {
 	if (_args.count(g_argGas))
@@ -841,6 +909,31 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Use up to n threads to parse source files and to process independent contracts, functions "
+			"and sub-assemblies concurrently. "
+			"The output does not depend on this setting."
+		)
+		(
+			g_strTimeReport.c_str(),
+			"Print the wall time, the CPU time and the growth of the peak memory usage of each compilation phase, "
+			"for the whole compilation and for each contract, to stderr."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store the output of --" + g_argStandardJSON + " compilations in the subdirectory "
+			"solc-compilation-cache of the given directory and reuse it for later compilations with the same "
+			"input and compiler version. The directory can be shared by several compiler processes.").c_str()
+		)
+		(
+			g_strCacheSize.c_str(),
+			po::value<unsigned>()->value_name("MiB")->default_value(1024),
+			("Maximal total size of the entries in the directory given by --" + g_strCacheDir + ". "
+			"The least recently used entries are removed first.").c_str()
+		)
 	;
 	desc.add(outputOptions);
 
@@ -851,6 +944,20 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to server mode: Read Standard JSON inputs from standard input and write each output to "
+			"standard output, both preceded by a \"Content-Length: <bytes>\" header line and an empty line, "
+			"until the input ends. Sources that did not change since the previous input with the same settings "
+			"are not parsed and analysed again. Ignores all options apart from --" + g_argBasePath + ", --" +
+			g_argAllowPaths + " and --" + g_strServerSocket + ".").c_str()
+		)
+		(
+			g_strServerSocket.c_str(),
+			po::value<string>()->value_name("path"),
+			("Used with --" + g_strServer + ". Listen on a Unix domain socket created at the given path instead "
+			"and serve its connections one after another.").c_str()
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -878,7 +985,7 @@ General Information)").c_str(),
 			g_argImportAst.c_str(),
 			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
 			"Supported Inputs is the output of the --" + g_argStandardJSON + " or the one produced by "
-			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON).c_str()
+			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON + ", or a single file written by --" + g_argAstBinary + ".").c_str()
 		)
 	;
 	desc.add(alternativeInputModes);
@@ -939,6 +1046,11 @@ General Information)").c_str(),
 	outputComponents.add_options()
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(
+			g_argAstBinary.c_str(),
+			("AST and text of all source files in a compact binary format that can be read by --" + g_argImportAst + ". "
+			"Written to combined.astb, requires --" + g_argOutputDir + ".").c_str()
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -1218,6 +1330,7 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_strServer,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
@@ -1231,6 +1344,12 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_argAstBinary) && !m_args.count(g_argOutputDir))
+	{
+		serr() << "Option --" << g_argAstBinary << " requires --" << g_argOutputDir << "." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1259,11 +1378,26 @@ bool CommandLineInterface::processInput()
 				return false;
 			}
 		}
-		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
+		shared_ptr<CompilationCache const> cache;
+		if (m_args.count(g_strCacheDir))
+			cache = make_shared<CompilationCache const>(
+				m_args[g_strCacheDir].as<string>(),
+				uint64_t(m_args[g_strCacheSize].as<unsigned>()) << 20
+			);
+		StandardCompiler compiler(fileReader, move(cache));
+		compiler.compile(input, sout());
+		sout() << endl;
 		return true;
 	}
 
+	if (m_args.count(g_strServer))
+		return serve(fileReader);
+	else if (m_args.count(g_strServerSocket))
+	{
+		serr() << "--" << g_strServerSocket << " can only be used with --" << g_strServer << "." << endl;
+		return false;
+	}
+
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
 
@@ -1464,6 +1598,13 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argExperimentalViaIR))
 			m_compiler->setViaIR(true);
+		m_compiler->setThreads(m_args[g_strThreads].as<unsigned>());
+		shared_ptr<util::Profiler> profiler;
+		if (m_args.count(g_strTimeReport))
+		{
+			profiler = make_shared<util::Profiler>();
+			m_compiler->setProfiler(profiler);
+		}
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
 		// TODO: Perhaps we should not compile unless requested
@@ -1502,7 +1643,16 @@ bool CommandLineInterface::processInput()
 		{
 			try
 			{
-				m_compiler->importASTs(parseAstFromInput());
+				if (m_sourceCodes.size() == 1 && ASTBinaryFormat::isBinaryAST(m_sourceCodes.begin()->second))
+				{
+					m_compiler->importBinaryAST(m_sourceCodes.begin()->second);
+					// The binary AST contains the sources it was created from.
+					m_sourceCodes.clear();
+					for (string const& name: m_compiler->sourceNames())
+						m_sourceCodes[name] = m_compiler->scanner(name).source();
+				}
+				else
+					m_compiler->importASTs(parseAstFromInput());
 
 				if (!m_compiler->analyze())
 				{
@@ -1532,6 +1682,9 @@ bool CommandLineInterface::processInput()
 			formatter->printErrorInformation(*error);
 		}
 
+		if (profiler)
+			serr() << profiler->toString();
+
 		if (!successful)
 		{
 			if (m_args.count(g_argErrorRecovery))
@@ -1732,7 +1885,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_strServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1742,6 +1895,40 @@ bool CommandLineInterface::actOnInput()
 	return !m_error;
 }
 
+bool CommandLineInterface::serve(ReadCallback::Callback const& _fileReader)
+{
+	StandardCompiler compiler(_fileReader);
+	compiler.enableAnalysisReuse();
+	if (!m_args.count(g_strServerSocket))
+		return serveStandardJson(compiler, cin, sout());
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	try
+	{
+		boost::asio::io_context context;
+		boost::asio::local::stream_protocol::acceptor acceptor(
+			context,
+			boost::asio::local::stream_protocol::endpoint(m_args[g_strServerSocket].as<string>())
+		);
+		while (true)
+		{
+			boost::asio::local::stream_protocol::iostream connection;
+			acceptor.accept(connection.socket());
+			// A connection that sends invalid data is closed, but the server keeps running.
+			serveStandardJson(compiler, connection, connection);
+		}
+	}
+	catch (boost::system::system_error const& _error)
+	{
+		serr() << "Error serving socket \"" << m_args[g_strServerSocket].as<string>() << "\": " << _error.what() << endl;
+		return false;
+	}
+#else
+	serr() << "--" << g_strServerSocket << " is not supported on this platform." << endl;
+	return false;
+#endif
+}
+
 bool CommandLineInterface::link()
 {
 	// Map from how the libraries will be named inside the bytecode to their addresses.
@@ -1846,6 +2033,7 @@ bool CommandLineInterface::assemble(
 		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
 		if (_yulOptimiserSteps.has_value())
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+		settings.yulOptimiserThreads = max<unsigned>(m_args[g_strThreads].as<unsigned>(), 1);
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
 		try
@@ -1987,6 +2175,8 @@ void CommandLineInterface::outputCompilationResults()
 	// do we need AST output?
 	handleAst(g_argAstJson);
 	handleAst(g_argAstCompactJson);
+	if (m_args.count(g_argAstBinary))
+		createFile("combined.astb", m_compiler->binaryAST());
 
 	if (
 		!m_compiler->compilationSuccessful() &&
@@ -50,6 +50,10 @@ public:
 	bool actOnInput();
 
 private:
+	/// Compiles Standard JSON inputs read from standard input or a socket until the input ends
+	/// (or forever in case of a socket), keeping the analysed sources between compilations.
+	/// @returns false on invalid input or if the socket cannot be used.
+	bool serve(ReadCallback::Callback const& _fileReader);
 	bool link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -449,6 +449,20 @@ SOLTMPDIR=$(mktemp -d)
     fi
 )
 
+printTask "Testing server mode..."
+(
+    set -e
+    request='{"language": "Solidity", "sources": {"A.sol": {"content": "contract A {}"}}, "settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}}'
+    frame="Content-Length: ${#request}\r\n\r\n${request}"
+    output=$(printf "${frame}${frame}" | "$SOLC" --server)
+    if [[ $(grep -o "Content-Length: " <<< "$output" | wc -l) != 2 || $(grep -o '"object":"[0-9a-f]' <<< "$output" | wc -l) != 2 ]]
+    then
+        printError "Incorrect output of server mode: $output"
+        exit 1
+    fi
+    ! printf "Content-Length: 100\r\n\r\n{}" | "$SOLC" --server &>/dev/null
+)
+
 printTask "Testing AST import..."
 SOLTMPDIR=$(mktemp -d)
 (
@@ -462,6 +476,23 @@ SOLTMPDIR=$(mktemp -d)
 )
 rm -rf "$SOLTMPDIR"
 
+printTask "Testing binary AST import..."
+SOLTMPDIR=$(mktemp -d)
+(
+    set -e
+    cd "$SOLTMPDIR"
+    echo 'pragma solidity >=0.0; contract C { string s = "1:2:3"; function f() public pure returns (int) { return -1; } }' > c.sol
+    "$SOLC" --ast-binary -o . c.sol
+    "$SOLC" --combined-json ast,compact-format --pretty-json c.sol > expected.json
+    "$SOLC" --import-ast --combined-json ast,compact-format --pretty-json combined.astb > obtained.json
+    diff expected.json obtained.json
+    "$SOLC" --bin --metadata c.sol > expected.txt
+    "$SOLC" --import-ast --bin --metadata combined.astb > obtained.txt
+    diff expected.txt obtained.txt
+    ! "$SOLC" --ast-binary c.sol &>/dev/null
+)
+rm -rf "$SOLTMPDIR"
+
 printTask "Testing AST export with stop-after=parsing..."
 "$REPO_ROOT/test/stopAfterParseTests.sh"
 
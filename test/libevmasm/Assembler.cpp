@@ -273,6 +273,28 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(item_data)
+{
+	u256 const small = u256(numeric_limits<uint64_t>::max());
+	u256 const large = small + 1;
+	AssemblyItem smallPush(small);
+	AssemblyItem largePush(large);
+	BOOST_CHECK_EQUAL(smallPush.data(), small);
+	BOOST_CHECK_EQUAL(largePush.data(), large);
+	BOOST_CHECK(smallPush < largePush);
+	BOOST_CHECK(!(largePush < smallPush));
+	BOOST_CHECK(smallPush != largePush);
+	BOOST_CHECK(AssemblyItem(large) == largePush);
+
+	AssemblyItem copy = largePush;
+	copy.setData(small);
+	BOOST_CHECK(copy == smallPush);
+	BOOST_CHECK_EQUAL(largePush.data(), large);
+	copy.setData(u256(-1));
+	BOOST_CHECK_EQUAL(copy.data(), u256(-1));
+	BOOST_CHECK(largePush < copy);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -35,6 +35,8 @@
 #include <string>
 #include <tuple>
 #include <memory>
+#include <set>
+#include <vector>
 
 using namespace std;
 using namespace solidity::langutil;
@@ -733,6 +735,73 @@ BOOST_AUTO_TEST_CASE(cse_access_previous_sequence)
 	// 0, SLOAD, 1, ADD, SSTORE, 0 SLOAD
 }
 
+BOOST_AUTO_TEST_CASE(cse_expression_index_collisions)
+{
+	// Constants that only differ above the lowest 64 bits have the same hash.
+	ExpressionClasses classes;
+	vector<ExpressionClasses::Id> ids;
+	for (unsigned i = 0; i < 100; ++i)
+		ids.push_back(classes.find(AssemblyItem(u256(7) + (u256(i) << 64))));
+	BOOST_CHECK_EQUAL(set<ExpressionClasses::Id>(ids.begin(), ids.end()).size(), ids.size());
+	ExpressionClasses::Id const caller = classes.find(Instruction::CALLER);
+	for (unsigned i = 0; i < 100; ++i)
+	{
+		BOOST_CHECK_EQUAL(classes.find(AssemblyItem(u256(7) + (u256(i) << 64))), ids[i]);
+		// Expressions with the same item and differing arguments are distinct.
+		ExpressionClasses::Id const sum = classes.find(Instruction::ADD, {ids[i], caller});
+		BOOST_CHECK_EQUAL(classes.find(Instruction::ADD, {caller, ids[i]}), sum);
+		BOOST_CHECK(i == 0 || sum != classes.find(Instruction::ADD, {ids[i - 1], caller}));
+	}
+	// Storage operations are only equal for the same sequence number.
+	ExpressionClasses::Id const load = classes.find(Instruction::SLOAD, {caller}, true, 1);
+	BOOST_CHECK_EQUAL(classes.find(Instruction::SLOAD, {caller}, true, 1), load);
+	BOOST_CHECK(classes.find(Instruction::SLOAD, {caller}, true, 2) != load);
+}
+
+BOOST_AUTO_TEST_CASE(cse_expression_index_growth)
+{
+	ExpressionClasses classes;
+	ExpressionClasses::Id const first = classes.find(Instruction::CALLER);
+	vector<ExpressionClasses::Id> ids;
+	for (unsigned i = 0; i < 5000; ++i)
+		ids.push_back(classes.find(Instruction::XOR, {first, classes.find(AssemblyItem(u256(i) + 1))}));
+	ExpressionClasses::Id const size = classes.size();
+	// Existing expressions are still found after the table has grown.
+	BOOST_CHECK_EQUAL(classes.find(Instruction::CALLER), first);
+	for (unsigned i = 0; i < 5000; ++i)
+		BOOST_CHECK_EQUAL(classes.find(Instruction::XOR, {first, classes.find(AssemblyItem(u256(i) + 1))}), ids[i]);
+	BOOST_CHECK_EQUAL(classes.size(), size);
+}
+
+BOOST_AUTO_TEST_CASE(known_state_copy_on_write)
+{
+	KnownState state;
+	for (AssemblyItem const& item: AssemblyItems{u256(1), u256(0), Instruction::SSTORE, u256(2), Instruction::CALLER})
+		state.feedItem(item, true);
+	KnownState copy = state;
+	// The copy shares the knowledge until it is modified.
+	BOOST_CHECK(&copy.storageContent() == &state.storageContent());
+	BOOST_CHECK(&copy.stackElements() == &state.stackElements());
+	BOOST_CHECK(copy == state);
+
+	for (AssemblyItem const& item: AssemblyItems{u256(1), Instruction::SSTORE})
+		copy.feedItem(item, true);
+	BOOST_CHECK(&copy.storageContent() != &state.storageContent());
+	BOOST_CHECK_EQUAL(state.storageContent().size(), 1);
+	BOOST_CHECK_EQUAL(copy.storageContent().size(), 2);
+	BOOST_CHECK_EQUAL(state.stackHeight(), 2);
+	BOOST_CHECK_EQUAL(copy.stackHeight(), 1);
+	BOOST_CHECK_EQUAL(state.relativeStackElement(0), state.expressionClasses().find(Instruction::CALLER));
+
+	// Knowledge that is not modified stays shared.
+	KnownState other = state;
+	other.resetMemory();
+	BOOST_CHECK(&other.storageContent() == &state.storageContent());
+	other.resetStorage();
+	BOOST_CHECK(other.storageContent().empty());
+	BOOST_CHECK_EQUAL(state.storageContent().size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(cse_optimise_return)
 {
 	checkCSE(
@@ -1000,9 +1069,54 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK((peepOpt.appliedRules() == map<string, size_t>{{"OpPop", 2}, {"PushPop", 1}}));
+}
+
+BOOST_AUTO_TEST_CASE(peephole_swap_pop)
+{
+	AssemblyItems items{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(2),
+		u256(3),
+		Instruction::SWAP2,
+		Instruction::POP,
+		Instruction::POP,
+		Instruction::POP,
+		u256(4),
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::DUP3,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::DUP1,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::POP,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	// All SWAPs and pushed values are removed, which leaves the two POPs removing the elements
+	// that were on the stack before.
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		Instruction::POP,
+		Instruction::POP,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!peepOpt.optimise());
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1255,6 +1369,90 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_subassemblies)
+{
+	// Optimising independent sub-assemblies concurrently and sub-assemblies sharing
+	// an assembly in order must give the same result as optimising all of them in order.
+	auto fill = [](Assembly& _assembly, unsigned _value) {
+		_assembly.append(u256(_value));
+		auto t1 = _assembly.newTag();
+		_assembly.append(t1);
+		_assembly.append(u256(2));
+		_assembly.append(Instruction::JUMP);
+		auto t2 = _assembly.newTag();
+		_assembly.append(t2); // Identical to t1, will be unified
+		_assembly.append(u256(2));
+		_assembly.append(Instruction::JUMP);
+		_assembly.append(_assembly.newTag()); // Unused, will be removed
+		_assembly.append(u256(_value + 1));
+		_assembly.append(Instruction::DUP1);
+		_assembly.append(Instruction::POP);
+		return t2;
+	};
+	auto build = [&]() {
+		auto main = make_shared<Assembly>();
+		AssemblyPointer shared = make_shared<Assembly>();
+		fill(*shared, 100);
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			AssemblyPointer sub = make_shared<Assembly>();
+			AssemblyItem tag = fill(*sub, i);
+			if (i >= 2)
+				sub->appendSubroutine(shared);
+			size_t subId = static_cast<size_t>(main->appendSubroutine(sub).data());
+			main->append(tag.toSubAssemblyTag(subId).pushTag());
+		}
+		return main;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	auto sequential = build();
+	sequential->optimise(settings);
+	settings.threads = 4;
+	auto concurrent = build();
+	concurrent->optimise(settings);
+
+	BOOST_CHECK_EQUAL(concurrent->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK(concurrent->assemble().bytecode == sequential->assemble().bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(cse_repeated_chunks)
+{
+	// Chunks with the same items but different source locations must not share
+	// the result of the common subexpression elimination.
+	auto source = make_shared<langutil::CharStream>("lorem ipsum", "source");
+	langutil::SourceLocation const first{0, 5, source};
+	langutil::SourceLocation const second{6, 11, source};
+
+	Assembly assembly;
+	for (auto const& location: {first, second, first})
+	{
+		assembly.setSourceLocation(location);
+		assembly.append(u256(2));
+		assembly.append(u256(3));
+		assembly.append(Instruction::ADD);
+		assembly.append(u256(0));
+		assembly.append(Instruction::MSTORE);
+		// Ends the chunk without ending the control flow.
+		assembly.append(Instruction::GAS);
+	}
+	size_t const originalSize = assembly.items().size();
+	assembly.optimise(true, solidity::test::CommonOptions::get().evmVersion(), false, 200);
+
+	AssemblyItems const& items = assembly.items();
+	BOOST_REQUIRE(items.size() < originalSize);
+	BOOST_REQUIRE(items.size() % 3 == 0);
+	for (size_t i = 0; i < items.size(); ++i)
+		BOOST_CHECK(items[i].location() == (i / (items.size() / 3) == 1 ? second : first));
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
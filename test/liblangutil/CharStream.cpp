@@ -28,6 +28,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 namespace solidity::langutil::test
 {
 
@@ -48,6 +51,37 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	std::string const text = "ab\n\ncd\r\nefg\n";
+	CharStream const source(text, "source");
+
+	std::vector<int> positions;
+	std::vector<std::tuple<int, int>> expectation;
+	for (int position = 0; position <= static_cast<int>(text.size()); ++position)
+	{
+		auto const before = text.begin() + position;
+		int line = static_cast<int>(std::count(text.begin(), before, '\n'));
+		int lineStart = static_cast<int>(std::find(std::make_reverse_iterator(before), text.rend(), '\n').base() - text.begin());
+		positions.push_back(position);
+		expectation.emplace_back(line, position - lineStart);
+		BOOST_CHECK(source.translatePositionToLineColumn(position) == expectation.back());
+	}
+	BOOST_CHECK(source.translatePositionsToLineColumns(positions) == expectation);
+	BOOST_CHECK(source.translatePositionToLineColumn(100) == std::make_tuple(4, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(-1) == std::make_tuple(4, 0));
+
+	BOOST_CHECK_EQUAL(source.lineAtPosition(0), "ab");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(2), "ab");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(3), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(5), "cd");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(7), "cd");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(8), "efg");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(11), "efg");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(12), "");
+	BOOST_CHECK_EQUAL(CharStream("\nx", "").lineAtPosition(0), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
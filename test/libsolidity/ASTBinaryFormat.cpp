@@ -0,0 +1,227 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary AST format.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTBinaryFormat.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+StringMap const sources{
+	{"A.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		pragma experimental ABIEncoderV2;
+		/// @title A library
+		library L {
+			struct S { uint a; bytes b; mapping(uint => S[]) children; }
+			enum E { One, Two, Three }
+			function sum(uint[] memory _values) internal pure returns (uint s) {
+				for (uint i = 0; i < _values.length; ++i)
+					s += _values[i];
+			}
+		}
+		interface I { function f(uint) external returns (uint, bool); }
+		abstract contract A is I {
+			using L for uint[];
+			event Log(address indexed sender, string message) anonymous;
+			uint constant x = 2 ether + 3 days;
+			uint immutable y;
+			function(uint) external returns (uint, bool) g;
+			constructor(uint _y) { y = _y; }
+			modifier only(address _a) { require(msg.sender == _a, "not allowed"); _; }
+			function f(uint) public virtual override returns (uint, bool);
+			receive() external payable {}
+			fallback() external {}
+		}
+	)"},
+	{"B.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "A.sol" as AA;
+		import {L as Lib, A} from "A.sol";
+		contract B is A(1) {
+			Lib.E e = Lib.E.Two;
+			function f(uint _a) public override only(address(this)) returns (uint r, bool ok) {
+				uint[] memory values = new uint[](_a);
+				(r, ok) = (Lib.sum(values), !ok);
+				r = _a > 1 ? r << 2 : uint(-(-int(r)));
+				bytes memory data = msg.data;
+				data[0] = data.length > 4 ? msg.data[1:4][0] : bytes1(0);
+				while (r > 10) { r /= 2; if (r == 7) break; else continue; }
+				do { r++; } while (false);
+				try this.f{gas: 1000}(r) returns (uint s, bool) { r = s; }
+				catch Error(string memory m) { emit Log(msg.sender, m); }
+				catch (bytes memory) { revert("failed"); }
+				assembly {
+					function twice(v) -> w { w := mul(v, 2) leave }
+					let z := 0
+					let t := "abc"
+					for { let i := 0 } lt(i, 4) { i := add(i, 1) } {
+						if eq(i, 2) { continue }
+						switch twice(i) case 0 { z := 1 } case 6 { break } default { z := twice(z) }
+					}
+					r := add(r, z)
+				}
+				return (r, type(uint8).max > 3 && ok);
+			}
+		}
+	)"}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTBinaryFormatTest)
+
+BOOST_AUTO_TEST_CASE(import_compiler_stack)
+{
+	string binaryAST;
+	map<string, Json::Value> jsonASTs;
+	map<string, string> bytecode;
+	map<string, string> metadata;
+	{
+		CompilerStack compiler;
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler.setSources(sources);
+		BOOST_REQUIRE(compiler.compile());
+		binaryAST = compiler.binaryAST();
+		for (string const& name: compiler.sourceNames())
+			jsonASTs[name] = ASTJsonConverter(false, compiler.state(), compiler.sourceIndices()).toJson(compiler.ast(name));
+		for (string const& name: compiler.contractNames())
+		{
+			bytecode[name] = compiler.object(name).toHex();
+			metadata[name] = compiler.metadata(name);
+		}
+	}
+	BOOST_CHECK(ASTBinaryFormat::isBinaryAST(binaryAST));
+	BOOST_CHECK(!ASTBinaryFormat::isBinaryAST(sources.at("A.sol")));
+	BOOST_CHECK(!ASTBinaryFormat::isBinaryAST(util::jsonCompactPrint(jsonASTs.at("A.sol"))));
+
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.importBinaryAST(binaryAST);
+	BOOST_CHECK(compiler.sourceNames() == vector<string>({"A.sol", "B.sol"}));
+	for (string const& name: compiler.sourceNames())
+		BOOST_CHECK_EQUAL(compiler.scanner(name).source(), sources.at(name));
+	BOOST_CHECK_EQUAL(compiler.binaryAST(), binaryAST);
+
+	BOOST_REQUIRE(compiler.analyze());
+	BOOST_REQUIRE(compiler.compile());
+	for (string const& name: compiler.sourceNames())
+		BOOST_CHECK_EQUAL(
+			util::jsonPrettyPrint(ASTJsonConverter(false, compiler.state(), compiler.sourceIndices()).toJson(compiler.ast(name))),
+			util::jsonPrettyPrint(jsonASTs.at(name))
+		);
+	BOOST_CHECK(compiler.contractNames().size() == bytecode.size());
+	for (string const& name: compiler.contractNames())
+	{
+		BOOST_CHECK_EQUAL(compiler.object(name).toHex(), bytecode.at(name));
+		BOOST_CHECK_EQUAL(compiler.metadata(name), metadata.at(name));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(shared_strings)
+{
+	CompilerStack compiler;
+	compiler.setSources({{"a.sol", "contract C { uint x; function f(uint x) public {} function g() public { x; } }"}});
+	BOOST_REQUIRE(compiler.parse());
+
+	vector<ASTBinaryFormat::Source> decoded = ASTBinaryFormat::decode(compiler.binaryAST(), EVMVersion{});
+	BOOST_REQUIRE_EQUAL(decoded.size(), 1);
+	BOOST_CHECK_EQUAL(decoded[0].charStream->name(), "a.sol");
+	BOOST_CHECK_EQUAL(*decoded[0].ast->annotation().path, "a.sol");
+
+	// All occurrences of a name refer to the same entry of the string table.
+	auto contract = dynamic_cast<ContractDefinition const*>(decoded[0].ast->nodes().at(0).get());
+	BOOST_REQUIRE(contract);
+	BOOST_CHECK(&contract->stateVariables().at(0)->name() == &contract->definedFunctions().at(0)->parameters().at(0)->name());
+}
+
+BOOST_AUTO_TEST_CASE(malformed_input)
+{
+	CompilerStack compiler;
+	compiler.setSources({{"a.sol", "pragma solidity >=0.0; pragma solidity >=0.0;"}, {"b.sol", "contract C {}"}});
+	BOOST_REQUIRE(compiler.parse());
+	string encoded = compiler.binaryAST();
+	BOOST_REQUIRE_NO_THROW(ASTBinaryFormat::decode(encoded, EVMVersion{}));
+
+	for (size_t length = 0; length < encoded.size(); ++length)
+		BOOST_CHECK_THROW(ASTBinaryFormat::decode(encoded.substr(0, length), EVMVersion{}), InvalidAstError);
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(encoded + '\0', EVMVersion{}), InvalidAstError);
+
+	string otherVersion = encoded;
+	otherVersion[7] = static_cast<char>(ASTBinaryFormat::version + 1);
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(otherVersion, EVMVersion{}), InvalidAstError);
+
+	// Corrupted data is either decoded into some AST or rejected.
+	for (size_t position = 8; position < encoded.size(); ++position)
+		for (char bit: {'\x01', '\x40', '\x80'})
+		{
+			string corrupted = encoded;
+			corrupted[position] ^= bit;
+			try
+			{
+				ASTBinaryFormat::decode(corrupted, EVMVersion{});
+			}
+			catch (InvalidAstError const&)
+			{
+			}
+		}
+}
+
+BOOST_AUTO_TEST_CASE(invalid_node_references)
+{
+	// The source unit is the last node of a source and ends with the references to its two pragmas.
+	CompilerStack compiler;
+	compiler.setSources({{"a.sol", "pragma solidity >=0.0; pragma solidity >=0.0;"}});
+	BOOST_REQUIRE(compiler.parse());
+	string encoded = compiler.binaryAST();
+	BOOST_REQUIRE_EQUAL(encoded.substr(encoded.size() - 3), string("\x02\x01\x02"));
+	string const prefix = encoded.substr(0, encoded.size() - 3);
+
+	BOOST_CHECK_NO_THROW(ASTBinaryFormat::decode(prefix + "\x02\x02\x01", EVMVersion{}));
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(prefix + "\x02\x01\x01", EVMVersion{}), InvalidAstError);
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(prefix + string("\x01\x01", 2), EVMVersion{}), InvalidAstError);
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(prefix + string("\x02\x01\x00", 3), EVMVersion{}), InvalidAstError);
+	// References have to point to earlier nodes.
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(prefix + "\x02\x01\x03", EVMVersion{}), InvalidAstError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -90,6 +90,7 @@ evmasm::AssemblyItems compileContract(std::shared_ptr<CharStream> _sourceCode)
 				solidity::test::CommonOptions::get().optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal()
 			);
 			compiler.compileContract(*contract, map<ContractDefinition const*, shared_ptr<Compiler const>>{}, bytes());
+			compiler.optimise();
 
 			return compiler.runtimeAssemblyItems();
 		}
@@ -180,9 +181,7 @@ BOOST_AUTO_TEST_CASE(location_test)
 		locations =
 			vector<SourceLocation>(hasShifts ? 31 : 32, SourceLocation{2, 82, sourceCode}) +
 			vector<SourceLocation>(24, SourceLocation{20, 79, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{49, 58, sourceCode}) +
 			vector<SourceLocation>(1, SourceLocation{72, 74, sourceCode}) +
-			vector<SourceLocation>(2, SourceLocation{65, 74, sourceCode}) +
 			vector<SourceLocation>(2, SourceLocation{20, 79, sourceCode});
 	checkAssemblyLocations(items, locations);
 }
@@ -0,0 +1,319 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the re-analysis of updated sources by the compiler stack.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/AST.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+struct Result
+{
+	vector<string> diagnostics;
+	map<string, string> bytecode;
+};
+
+void configure(CompilerStack& _compiler)
+{
+	_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	_compiler.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+}
+
+/// @returns the diagnostics in a canonical order (kept sources are reported first after an update)
+/// and the bytecode of all contracts.
+Result result(CompilerStack const& _compiler)
+{
+	Result result;
+	for (auto const& error: _compiler.errors())
+	{
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+		result.diagnostics.emplace_back(
+			error->typeName() + " " +
+			(location && location->source ? location->source->name() : "") + ":" +
+			(location ? to_string(location->start) + "-" + to_string(location->end) : "") + " " +
+			*error->comment()
+		);
+	}
+	sort(result.diagnostics.begin(), result.diagnostics.end());
+	if (_compiler.state() >= CompilerStack::CompilationSuccessful)
+		for (string const& name: _compiler.contractNames())
+			result.bytecode[name] = _compiler.object(name).toHex();
+	return result;
+}
+
+Result compileFromScratch(StringMap const& _sources, ReadCallback::Callback const& _readFile = {})
+{
+	CompilerStack compiler(_readFile);
+	configure(compiler);
+	compiler.setSources(_sources);
+	compiler.compile();
+	return result(compiler);
+}
+
+void checkEqual(Result const& _incremental, Result const& _fromScratch)
+{
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		_incremental.diagnostics.begin(), _incremental.diagnostics.end(),
+		_fromScratch.diagnostics.begin(), _fromScratch.diagnostics.end()
+	);
+	BOOST_CHECK(_incremental.bytecode == _fromScratch.bytecode);
+}
+
+StringMap const c_project{
+	{"base.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		abstract contract Base {
+			uint x;
+			function f(uint a) public virtual returns (uint) { uint unused; return a + x; }
+			function g() public view returns (uint) { return x; }
+		}
+	)"},
+	{"lib.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "base.sol";
+		library L { function twice(uint a) internal pure returns (uint) { return 2 * a; } }
+		contract Middle is Base {
+			function f(uint a) public virtual override returns (uint) { return L.twice(a) + Base.f(a); }
+		}
+	)"},
+	{"main.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "lib.sol";
+		contract Main is Middle {
+			function f(uint x) public override returns (uint) { return super.f(x) + 1; }
+		}
+	)"},
+	{"other.sol", R"(
+		pragma solidity >=0.0;
+		contract Other { function h() public returns (uint) { uint gasleft; return gasleft; } }
+	)"}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysis)
+
+BOOST_AUTO_TEST_CASE(edit_leaf)
+{
+	StringMap edited = c_project;
+	edited["main.sol"] += "contract Another is Main { function k() public pure { uint y; } }\n";
+	Result const expectation = compileFromScratch(edited);
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(c_project);
+	BOOST_REQUIRE(compiler.compile());
+	SourceUnit const* base = &compiler.ast("base.sol");
+	SourceUnit const* other = &compiler.ast("other.sol");
+	SourceUnit const* main = &compiler.ast("main.sol");
+
+	compiler.updateSources(edited);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(&compiler.ast("base.sol") == base);
+	BOOST_CHECK(&compiler.ast("other.sol") == other);
+	BOOST_CHECK(&compiler.ast("main.sol") != main);
+	checkEqual(result(compiler), expectation);
+
+	// Updating without changes does not re-analyse anything.
+	compiler.updateSources(edited);
+	BOOST_REQUIRE(compiler.compile());
+	checkEqual(result(compiler), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(edit_imported_source)
+{
+	StringMap edited = c_project;
+	edited["base.sol"] = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		abstract contract Base {
+			uint x;
+			uint z;
+			function f(uint a) public virtual returns (uint) { return a + x + z; }
+			function g() public view returns (uint) { return x; }
+		}
+	)";
+	Result const expectation = compileFromScratch(edited);
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(c_project);
+	BOOST_REQUIRE(compiler.compile());
+	SourceUnit const* other = &compiler.ast("other.sol");
+	SourceUnit const* lib = &compiler.ast("lib.sol");
+
+	compiler.updateSources(edited);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(&compiler.ast("other.sol") == other);
+	BOOST_CHECK(&compiler.ast("lib.sol") != lib);
+	checkEqual(result(compiler), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(add_and_remove_sources)
+{
+	StringMap edited = c_project;
+	edited.erase("other.sol");
+	edited["new.sol"] = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "lib.sol";
+		contract New is Middle { function n() public pure returns (uint) { return L.twice(3); } }
+	)";
+	Result const expectation = compileFromScratch(edited);
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(c_project);
+	BOOST_REQUIRE(compiler.compile());
+
+	compiler.updateSources(edited);
+	BOOST_REQUIRE(compiler.compile());
+	checkEqual(result(compiler), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(recover_from_error)
+{
+	StringMap broken = c_project;
+	broken["lib.sol"] += "contract Broken { function b() public { undefined(); } }\n";
+	Result const brokenExpectation = compileFromScratch(broken);
+	Result const expectation = compileFromScratch(c_project);
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(c_project);
+	BOOST_REQUIRE(compiler.compile());
+
+	compiler.updateSources(broken);
+	BOOST_CHECK(!compiler.compile());
+	checkEqual(result(compiler), brokenExpectation);
+
+	compiler.updateSources(c_project);
+	BOOST_REQUIRE(compiler.compile());
+	checkEqual(result(compiler), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(keep_sources_loaded_by_callback)
+{
+	map<string, string> files = c_project;
+	ReadCallback::Callback readFile = [&](string const&, string const& _path) {
+		if (!files.count(_path))
+			return ReadCallback::Result{false, "not found"};
+		return ReadCallback::Result{true, files.at(_path)};
+	};
+	StringMap const initial{{"main.sol", c_project.at("main.sol")}};
+	StringMap edited{{"main.sol", c_project.at("main.sol") + "contract Another is Main {}\n"}};
+	StringMap const unrelated{{"other.sol", c_project.at("other.sol")}};
+
+	// Only one compiler stack can exist at a time, so the expectations are computed first.
+	Result const editedExpectation = compileFromScratch(edited, readFile);
+	files["base.sol"] += "contract Extra {}\n";
+	Result const changedExpectation = compileFromScratch(edited, readFile);
+	Result const unrelatedExpectation = compileFromScratch(unrelated, readFile);
+	files = c_project;
+
+	CompilerStack compiler(readFile);
+	configure(compiler);
+	compiler.setSources(initial);
+	BOOST_REQUIRE(compiler.compile());
+	SourceUnit const* base = &compiler.ast("base.sol");
+	SourceUnit const* lib = &compiler.ast("lib.sol");
+
+	// Unchanged loaded sources are kept after asking the callback for their current content.
+	BOOST_CHECK(compiler.updateSources(edited));
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(&compiler.ast("base.sol") == base);
+	BOOST_CHECK(&compiler.ast("lib.sol") == lib);
+	checkEqual(result(compiler), editedExpectation);
+
+	// Changed loaded sources are parsed again, as are the sources importing them.
+	files["base.sol"] += "contract Extra {}\n";
+	BOOST_CHECK(compiler.updateSources(edited));
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(&compiler.ast("base.sol") != base);
+	BOOST_CHECK(&compiler.ast("lib.sol") != lib);
+	checkEqual(result(compiler), changedExpectation);
+
+	// Loaded sources that are no longer imported are dropped.
+	BOOST_CHECK(compiler.updateSources(unrelated));
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(compiler.sourceNames() == vector<string>{"other.sol"});
+	checkEqual(result(compiler), unrelatedExpectation);
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_matches_compilation_from_scratch)
+{
+	// The new node shifts the AST IDs of all sources after base.sol in a compilation from scratch.
+	StringMap edited = c_project;
+	edited["base.sol"] += "contract Extra { function e() public pure returns (uint) { return 7; } }\n";
+	auto configureViaIR = [](CompilerStack& _compiler) {
+		configure(_compiler);
+		_compiler.setViaIR(true);
+		_compiler.enableIRGeneration(true);
+	};
+	auto optimizedIR = [](CompilerStack const& _compiler) {
+		map<string, string> ir;
+		for (string const& name: _compiler.contractNames())
+			ir[name] = _compiler.yulIROptimized(name);
+		return ir;
+	};
+
+	Result expectation;
+	map<string, string> expectedIR;
+	{
+		CompilerStack compiler;
+		configureViaIR(compiler);
+		compiler.setSources(edited);
+		BOOST_REQUIRE(compiler.compile());
+		expectation = result(compiler);
+		expectedIR = optimizedIR(compiler);
+	}
+
+	CompilerStack compiler;
+	configureViaIR(compiler);
+	compiler.setSources(c_project);
+	BOOST_REQUIRE(compiler.compile());
+
+	compiler.updateSources(edited);
+	BOOST_REQUIRE(compiler.compile());
+	checkEqual(result(compiler), expectation);
+	BOOST_CHECK(optimizedIR(compiler) == expectedIR);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sharing parsed inline assembly snippets between the contracts of a compilation.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(InlineAssemblyCacheTest)
+
+BOOST_AUTO_TEST_CASE(cached_snippets_generate_identical_code)
+{
+	string const sourceCode = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		pragma abicoder v2;
+		contract A {
+			function f(uint a, bytes memory b) public pure returns (uint, bytes memory) {
+				require(a > 1, "too small");
+				return (a + 1, b);
+			}
+		}
+		contract B {
+			function g(uint a, bytes memory b) public pure returns (bytes memory, uint) {
+				require(a > 2, "too small");
+				require(a < 100, "too large");
+				return (b, a + 2);
+			}
+		}
+	)";
+	for (OptimiserSettings const& settings: {OptimiserSettings::minimal(), OptimiserSettings::standard()})
+	{
+		CompilerStack compiler;
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler.setRevertStringBehaviour(RevertStrings::Debug);
+		compiler.setSources({{"a.sol", sourceCode}});
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+		vector<ContractDefinition const*> contracts = ASTNode::filteredNodes<ContractDefinition>(compiler.ast("a.sol").nodes());
+		BOOST_REQUIRE(contracts.size() == 2);
+
+		auto compile = [&](ContractDefinition const* _contract, shared_ptr<InlineAssemblyCache> const& _cache) {
+			Compiler contractCompiler(
+				solidity::test::CommonOptions::get().evmVersion(),
+				RevertStrings::Debug,
+				settings,
+				_cache
+			);
+			contractCompiler.compileContract(*_contract, {}, bytes());
+			contractCompiler.optimise();
+			return
+				contractCompiler.assemblyString({{"a.sol", sourceCode}}) +
+				toHex(contractCompiler.assembledObject().bytecode);
+		};
+
+		auto cache = make_shared<InlineAssemblyCache>();
+		BOOST_CHECK_EQUAL(compile(contracts[0], cache), compile(contracts[0], nullptr));
+		size_t const hits = cache->hits();
+		BOOST_CHECK_EQUAL(compile(contracts[1], cache), compile(contracts[1], nullptr));
+		BOOST_CHECK(cache->hits() > hits);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,150 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sharing multi-use Yul functions between the contracts of a compilation.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+#include <libsolidity/codegen/YulUtilFunctions.h>
+#include <libsolidity/codegen/ir/IRGenerator.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string requestUtilityFunctions(MultiUseYulFunctionCollector& _collector)
+{
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	YulUtilFunctions utils(evmVersion, RevertStrings::Default, _collector);
+	utils.overflowCheckedIntAddFunction(*TypeProvider::uint256());
+	ABIFunctions abi(evmVersion, RevertStrings::Default, _collector);
+	abi.tupleEncoder(
+		{TypeProvider::uint256(), TypeProvider::bytesMemory()},
+		{TypeProvider::uint256(), TypeProvider::bytesMemory()}
+	);
+	return _collector.requestedFunctions();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(MultiUseYulFunctionCollectorTest)
+
+BOOST_AUTO_TEST_CASE(cached_functions_are_identical)
+{
+	MultiUseYulFunctionCollector uncached;
+	string const expectation = requestUtilityFunctions(uncached);
+
+	auto cache = make_shared<MultiUseYulFunctionCache>();
+	MultiUseYulFunctionCollector first(cache);
+	BOOST_CHECK_EQUAL(requestUtilityFunctions(first), expectation);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+
+	// The functions requested by cached functions are added without calling their creators.
+	MultiUseYulFunctionCollector second(cache);
+	BOOST_CHECK_EQUAL(requestUtilityFunctions(second), expectation);
+	BOOST_CHECK_EQUAL(cache->hits(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(functions_depending_on_unshared_functions_are_not_cached)
+{
+	auto cache = make_shared<MultiUseYulFunctionCache>();
+	size_t created = 0;
+	auto request = [&](MultiUseYulFunctionCollector& _collector) {
+		return _collector.createSharedFunction("f", [&]() {
+			++created;
+			_collector.createFunction("g", [&]() { return "function g() {}\n"; });
+			return "function f() { g() }\n";
+		});
+	};
+
+	MultiUseYulFunctionCollector first(cache);
+	request(first);
+	MultiUseYulFunctionCollector second(cache);
+	request(second);
+	BOOST_CHECK_EQUAL(created, 2);
+	BOOST_CHECK_EQUAL(cache->hits(), 0);
+	BOOST_CHECK_EQUAL(first.requestedFunctions(), second.requestedFunctions());
+}
+
+BOOST_AUTO_TEST_CASE(ir_with_shared_functions)
+{
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	CompilerStack compiler;
+	compiler.setEVMVersion(evmVersion);
+	compiler.setSources({{"a.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		pragma abicoder v2;
+		contract A { function f(uint a, bytes memory b) public pure returns (uint, bytes memory) { return (a + 1, b); } }
+		contract B { function g(uint a, bytes memory b) public pure returns (bytes memory, uint) { return (b, a + 2); } }
+	)"}});
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+	vector<ContractDefinition const*> contracts = ASTNode::filteredNodes<ContractDefinition>(compiler.ast("a.sol").nodes());
+	BOOST_REQUIRE(contracts.size() == 2);
+
+	auto generate = [&](ContractDefinition const* _contract, shared_ptr<MultiUseYulFunctionCache> _cache) {
+		IRGenerator generator(
+			evmVersion,
+			RevertStrings::Default,
+			OptimiserSettings::minimal(),
+			move(_cache)
+		);
+		return generator.runUnoptimized(*_contract, {});
+	};
+
+	auto cache = make_shared<MultiUseYulFunctionCache>();
+	BOOST_CHECK_EQUAL(generate(contracts[0], cache), generate(contracts[0], nullptr));
+	size_t const hits = cache->hits();
+	BOOST_CHECK_EQUAL(generate(contracts[1], cache), generate(contracts[1], nullptr));
+	BOOST_CHECK(cache->hits() > hits);
+}
+
+BOOST_AUTO_TEST_CASE(compiler_stack_shares_functions)
+{
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setSources({{"a.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		pragma abicoder v2;
+		contract A { function f(uint a, bytes memory b) public pure returns (uint, bytes memory) { return (a + 1, b); } }
+		contract B { function g(uint a, bytes memory b) public pure returns (bytes memory, uint) { return (b, a + 2); } }
+	)"}});
+	compiler.enableIRGeneration();
+	BOOST_REQUIRE(compiler.compile());
+
+	BOOST_REQUIRE(compiler.yulFunctionCache());
+	BOOST_CHECK(compiler.yulFunctionCache()->hits() > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -22,15 +22,23 @@
 
 #include <string>
 #include <boost/test/unit_test.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/filesystem.hpp>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/StandardOutputSink.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
+#include <fstream>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -1595,6 +1603,659 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(threads_invalid_value)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"threads": 0,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.threads\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(threads_output_identical)
+{
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint x; function f(uint a) public returns (uint) { x += a; return x; } } contract B { function g() public returns (address) { return address(new A()); } } contract C { constructor() { new B(); } function h(uint[] memory a) public pure returns (uint) { return a.length; } }"
+			},
+			"D.sol": {
+				"content": "import \"A.sol\"; contract D is A { function k() public view returns (bytes32) { return keccak256(abi.encode(msg.sender)); } }"
+			}
+		},
+		"settings": {
+			"threads": <threads>,
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": {
+					"*": ["ir", "irOptimized", "evm.bytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value sequential = compile(boost::replace_all_copy(inputTemplate, "<threads>", "1"));
+	Json::Value concurrent = compile(boost::replace_all_copy(inputTemplate, "<threads>", "4"));
+	BOOST_REQUIRE(sequential["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].isString());
+	BOOST_REQUIRE(sequential["contracts"]["D.sol"]["D"]["irOptimized"].isString());
+	BOOST_CHECK(sequential == concurrent);
+}
+
+BOOST_AUTO_TEST_CASE(threads_output_identical_legacy)
+{
+	// A is created by B and E, which share its assembly, and B by C.
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint x; function f(uint a) public returns (uint) { x += a; return x; } } contract B { function g() public returns (address) { return address(new A()); } } contract C { constructor() { new B(); } function h(uint[] memory a) public pure returns (uint) { return a.length; } }"
+			},
+			"E.sol": {
+				"content": "import \"A.sol\"; contract E { A a = new A(); function k() public returns (A) { return new A(); } } contract F { function l(uint a) public pure returns (uint) { return a * 7; } }"
+			}
+		},
+		"settings": {
+			"threads": <threads>,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": {
+					"*": ["evm.assembly", "evm.bytecode.object", "evm.deployedBytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value sequential = compile(boost::replace_all_copy(inputTemplate, "<threads>", "1"));
+	Json::Value concurrent = compile(boost::replace_all_copy(inputTemplate, "<threads>", "4"));
+	BOOST_REQUIRE(sequential["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].isString());
+	BOOST_REQUIRE(sequential["contracts"]["E.sol"]["E"]["evm"]["assembly"].isString());
+	BOOST_CHECK(sequential == concurrent);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_output_identical)
+{
+	// Each source imports the next two, most of which are only provided by the read callback.
+	auto source = [](size_t _index) {
+		return
+			"import \"S" + to_string(_index + 1) + ".sol\"; import \"S" + to_string(_index + 2) + ".sol\"; " +
+			"contract C" + to_string(_index) + " { function f(uint a) public pure returns (uint) { assembly { a := add(a, " +
+			to_string(_index) + ") } return a; } }";
+	};
+	ReadCallback::Callback readCallback = [&](string const&, string const& _path) {
+		if (_path == "Missing.sol")
+			return ReadCallback::Result{false, "not found"};
+		size_t const index = stoul(_path.substr(1, _path.size() - 5));
+		if (index >= 30)
+			return ReadCallback::Result{true, "contract Last" + to_string(index) + " {}"};
+		return ReadCallback::Result{true, source(index)};
+	};
+	auto escape = [](string const& _source) { return boost::replace_all_copy(_source, "\"", "\\\""); };
+	auto compileWithThreads = [&](string const& _additionalSource, size_t _threads) {
+		string const input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"S0.sol": { "content": ")" + escape(source(0)) + R"(" },
+				"S5.sol": { "content": ")" + escape(source(5)) + R"(" },
+				"X.sol": { "content": ")" + escape(_additionalSource) + R"(" }
+			},
+			"settings": {
+				"threads": )" + to_string(_threads) + R"(,
+				"outputSelection": { "*": { "": ["ast"] } }
+			}
+		}
+		)";
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(frontend::StandardCompiler(readCallback).compile(input), result));
+		return result;
+	};
+
+	// The AST IDs do not depend on the number of threads.
+	Json::Value sequential = compileWithThreads("contract X {}", 1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	BOOST_CHECK_EQUAL(sequential["sources"].size(), 33);
+	BOOST_CHECK(sequential == compileWithThreads("contract X {}", 8));
+
+	// Neither do the errors of parsing and loading sources.
+	string const invalidSource = "import \"Missing.sol\"; import \"S3.sol\"; contract X { function }";
+	sequential = compileWithThreads(invalidSource, 1);
+	BOOST_REQUIRE(sequential["errors"].size() >= 2);
+	BOOST_CHECK(sequential == compileWithThreads(invalidSource, 8));
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_bytecode_independent_of_ir_output)
+{
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint x; function f(uint a) public returns (uint) { x += a; return x; } } contract B { function g() public returns (address) { return address(new A()); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": [<outputs>] } }
+		}
+	}
+	)";
+
+	Json::Value withoutIR = compile(boost::replace_all_copy(inputTemplate, "<outputs>", "\"evm.bytecode.object\""));
+	Json::Value withIR = compile(boost::replace_all_copy(inputTemplate, "<outputs>", "\"irOptimized\", \"evm.bytecode.object\""));
+	BOOST_REQUIRE(containsAtMostWarnings(withoutIR));
+	Json::Value contract = getContractResult(withoutIR, "A.sol", "B");
+	BOOST_REQUIRE(contract["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(!contract.isMember("irOptimized"));
+	BOOST_REQUIRE(getContractResult(withIR, "A.sol", "B")["irOptimized"].isString());
+	BOOST_CHECK_EQUAL(
+		contract["evm"]["bytecode"]["object"].asString(),
+		getContractResult(withIR, "A.sol", "B")["evm"]["bytecode"]["object"].asString()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_created_contracts_embedded_consistently)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { uint public x = 7; } contract D { function f() public returns (address) { return address(new C()); } } contract E { constructor() { new D(); new C(); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": ["ir", "irOptimized", "evm.bytecode.object", "evm.deployedBytecode.object"] } }
+		}
+	}
+	)";
+
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	auto output = [&](string const& _name, vector<string> const& _path) {
+		Json::Value value = getContractResult(result, "A.sol", _name);
+		for (string const& key: _path)
+			value = value[key];
+		BOOST_REQUIRE(value.isString());
+		return value.asString();
+	};
+	// @returns all creation objects of C in @a _ir without their indentation.
+	auto objectsOfC = [](string const& _ir) {
+		vector<string> objects;
+		for (size_t start = _ir.find("object \"C_"); start != string::npos; start = _ir.find("object \"C_", start + 1))
+		{
+			size_t const nameEnd = _ir.find('"', start + 8);
+			if (boost::ends_with(_ir.substr(start, nameEnd - start), "_deployed"))
+				continue;
+			size_t end = _ir.find('{', start);
+			for (int depth = 0; end < _ir.size(); ++end)
+				if (_ir[end] == '{')
+					++depth;
+				else if (_ir[end] == '}' && --depth == 0)
+					break;
+			string object = _ir.substr(start, end - start + 1);
+			boost::replace_all(object, " ", "");
+			objects.emplace_back(move(object));
+		}
+		return objects;
+	};
+
+	// The complete code of created contracts is part of the IR output.
+	BOOST_CHECK(!objectsOfC(output("D", {"ir"})).empty());
+	BOOST_CHECK(output("D", {"ir"}).find("code { }") == string::npos);
+
+	// Created contracts are optimized once and embedded in the same form into all contracts creating them.
+	vector<string> objects = objectsOfC(output("D", {"irOptimized"}));
+	BOOST_REQUIRE(!objects.empty());
+	vector<string> objectsInE = objectsOfC(output("E", {"irOptimized"}));
+	// E creates C directly and as part of D.
+	BOOST_REQUIRE(objectsInE.size() >= 2);
+	objects += objectsInE;
+	for (string const& object: objects)
+		BOOST_CHECK_EQUAL(object, objects.front());
+	BOOST_CHECK(output("D", {"evm", "bytecode", "object"}).find(output("C", {"evm", "deployedBytecode", "object"})) != string::npos);
+	BOOST_CHECK(output("E", {"evm", "bytecode", "object"}).find(output("C", {"evm", "deployedBytecode", "object"})) != string::npos);
+	BOOST_CHECK(output("E", {"evm", "bytecode", "object"}).find(output("D", {"evm", "deployedBytecode", "object"})) != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_contracts_created_by_bases_and_constructors)
+{
+	// D only creates C through its base B, F only creates C in its constructor.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { uint public x = 7; } contract B { function f() public returns (address) { return address(new C()); } } contract D is B { } contract F { constructor() { new C(); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": ["ir", "irOptimized", "evm.bytecode.object", "evm.deployedBytecode.object"] } }
+		}
+	}
+	)";
+
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	auto output = [&](string const& _name, vector<string> const& _path) {
+		Json::Value value = getContractResult(result, "A.sol", _name);
+		for (string const& key: _path)
+			value = value[key];
+		BOOST_REQUIRE(value.isString());
+		return value.asString();
+	};
+
+	string const runtimeOfC = output("C", {"evm", "deployedBytecode", "object"});
+	for (string const contract: {"D", "F"})
+	{
+		// No placeholder of C is left in the output.
+		BOOST_CHECK(output(contract, {"ir"}).find("code { }") == string::npos);
+		BOOST_CHECK(output(contract, {"irOptimized"}).find("code { }") == string::npos);
+		BOOST_CHECK(output(contract, {"evm", "bytecode", "object"}).find(runtimeOfC) != string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streaming_output_identical)
+{
+	// "a.sol:A" sorts before "a:B", but the source "a" comes first in the output.
+	vector<string> const inputs{
+		R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"a": { "content": "contract B { function f() public {} }" },
+				"a.sol": { "content": "import \"a\"; contract A is B { uint x; function g(uint y) public { x = y; } } contract C { function h() public pure {} }" }
+			},
+			"settings": {
+				"outputSelection": {
+					"*": {
+						"": ["ast"],
+						"*": ["abi", "metadata", "evm.bytecode", "evm.deployedBytecode.object", "evm.methodIdentifiers"]
+					}
+				}
+			}
+		}
+		)",
+		R"(
+		{
+			"language": "Solidity",
+			"sources": { "a.sol": { "content": "contract A { function f() public { uint x; } }" } },
+			"settings": { "outputSelection": { "*": { "*": ["abi"] } } }
+		}
+		)",
+		R"(
+		{
+			"language": "Solidity",
+			"sources": { "a.sol": { "content": "contract A { function f() public { x = 1; } }" } }
+		}
+		)",
+		R"({ "language": "Solidity", "sources": {} })",
+		R"({ "language": "INVALID", "sources": {} })",
+		"{ invalid JSON"
+	};
+
+	for (string const& input: inputs)
+	{
+		solidity::frontend::StandardCompiler compiler;
+		string streamed = compiler.compile(input);
+		Json::Value output;
+		BOOST_REQUIRE(util::jsonParseStrict(streamed, output));
+		Json::Value parsedInput;
+		if (util::jsonParseStrict(input, parsedInput))
+			BOOST_CHECK_EQUAL(streamed, util::jsonCompactPrint(compiler.compile(parsedInput)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streaming_output_fatal_error)
+{
+	auto fatalError = [](string const& _message) {
+		Json::Value error;
+		error["message"] = _message;
+		Json::Value output;
+		output["errors"].append(error);
+		return output;
+	};
+	auto parse = [](string const& _output) {
+		Json::Value output;
+		BOOST_REQUIRE(util::jsonParseStrict(_output, output));
+		return output;
+	};
+
+	// A failure after the errors have been set, but before they have been written.
+	ostringstream stream;
+	StreamingOutputSink sink(stream);
+	sink.set({"contracts", "A", "C"}, Json::objectValue);
+	sink.set({"contracts", "A", "D"}, Json::Value("D"));
+	sink.set({"errors"}, fatalError("warning")["errors"]);
+	sink.fail(fatalError("fatal"));
+	// The errors are written exactly once.
+	string const serialised = stream.str();
+	BOOST_CHECK(serialised.find("\"errors\"") == serialised.rfind("\"errors\""));
+	Json::Value output = parse(serialised);
+	BOOST_CHECK_EQUAL(output["contracts"]["A"]["D"].asString(), "D");
+	BOOST_REQUIRE_EQUAL(output["errors"].size(), 2);
+	BOOST_CHECK_EQUAL(output["errors"][0]["message"].asString(), "warning");
+	BOOST_CHECK_EQUAL(output["errors"][1]["message"].asString(), "fatal");
+
+	// A failure while preparing the members following the errors, e.g. while converting an AST,
+	// happens before the errors have been set and is reported in them.
+	ostringstream preparedStream;
+	StreamingOutputSink preparedSink(preparedStream);
+	preparedSink.set({"contracts", "A", "C"}, Json::objectValue);
+	OutputSink::Prepared source = preparedSink.prepare(Json::Value("A"));
+	BOOST_CHECK(get<string>(source) == "\"A\"");
+	preparedSink.fail(fatalError("fatal"));
+	output = parse(preparedStream.str());
+	BOOST_CHECK(!output.isMember("sources"));
+	BOOST_REQUIRE_EQUAL(output["errors"].size(), 1);
+	BOOST_CHECK_EQUAL(output["errors"][0]["message"].asString(), "fatal");
+
+	// A failure after the errors have been written leaves the output incomplete instead of
+	// writing the errors a second time.
+	ostringstream lateStream;
+	StreamingOutputSink lateSink(lateStream);
+	lateSink.set({"errors"}, fatalError("warning")["errors"]);
+	lateSink.setPrepared({"sources", "A"}, lateSink.prepare(Json::Value("A")));
+	lateSink.fail(fatalError("fatal"));
+	lateSink.finish();
+	BOOST_CHECK_EQUAL(lateStream.str(), "{\"errors\":[{\"message\":\"warning\"}],\"sources\":{\"A\":\"A\"");
+	BOOST_CHECK(!util::jsonParseStrict(lateStream.str(), output));
+
+	// A failure inside of an open object before any errors have been set.
+	ostringstream nestedStream;
+	StreamingOutputSink nestedSink(nestedStream);
+	nestedSink.set({"contracts", "A", "C"}, Json::objectValue);
+	nestedSink.fail(fatalError("fatal"));
+	output = parse(nestedStream.str());
+	BOOST_CHECK(output["contracts"]["A"]["C"].isObject());
+	BOOST_REQUIRE_EQUAL(output["errors"].size(), 1);
+	BOOST_CHECK_EQUAL(output["errors"][0]["message"].asString(), "fatal");
+
+	// A failure before anything has been written.
+	ostringstream emptyStream;
+	StreamingOutputSink emptySink(emptyStream);
+	emptySink.fail(fatalError("fatal"));
+	BOOST_CHECK_EQUAL(emptyStream.str(), util::jsonCompactPrint(fatalError("fatal")));
+}
+
+BOOST_AUTO_TEST_CASE(profile_output)
+{
+	string const inputTemplate = R"({
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A { function f() public pure {} } contract B { function g() public returns (address) { return address(new A()); } }" } },
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"debug": { "profile": PROFILE },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	})";
+	Json::Value result = compile(boost::replace_all_copy(inputTemplate, "PROFILE", "true"));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result.isMember("profile"));
+	Json::Value const& profile = result["profile"];
+	for (string const phase: {"parsing", "analysis/typeChecker"})
+		BOOST_CHECK(profile["phases"].isMember(phase));
+	for (string const contract: {"A", "B"})
+	{
+		Json::Value const& phases = profile["contracts"]["A.sol"][contract];
+		for (string const phase: {"irGeneration", "irParsing", "yulOptimizer", "yulOptimizer/ExpressionSimplifier", "evmCodeGeneration"})
+			BOOST_CHECK_MESSAGE(phases.isMember(phase), contract + " lacks " + phase);
+		BOOST_CHECK(phases["yulOptimizer/ExpressionSimplifier"]["count"].asUInt() > 1);
+		for (auto const& measurement: phases)
+		{
+			BOOST_CHECK(measurement["wallTime"].asDouble() >= 0);
+			BOOST_CHECK(measurement["cpuTime"].asDouble() >= 0);
+			BOOST_CHECK(measurement["count"].asUInt() >= 1);
+		}
+	}
+
+	Json::Value unprofiled = compile(boost::replace_all_copy(inputTemplate, "PROFILE", "false"));
+	BOOST_CHECK(!unprofiled.isMember("profile"));
+	result.removeMember("profile");
+	BOOST_CHECK(result == unprofiled);
+
+	Json::Value invalid = compile(boost::replace_all_copy(inputTemplate, "PROFILE", "1"));
+	BOOST_CHECK(!containsAtMostWarnings(invalid));
+	BOOST_CHECK_EQUAL(invalid["errors"][0]["message"].asString(), "settings.debug.profile must be a Boolean.");
+}
+
+BOOST_AUTO_TEST_CASE(analysis_reuse)
+{
+	auto input = [](string const& _main, bool _optimize) {
+		return R"({
+			"language": "Solidity",
+			"sources": {
+				"lib.sol": { "content": "library L { function f(uint a) internal pure returns (uint r) { assembly { r := mul(a, 7) } } }" },
+				"main.sol": { "content": ")" + _main + R"(" }
+			},
+			"settings": {
+				"optimizer": { "enabled": )" + (_optimize ? "true" : "false") + R"( },
+				"outputSelection": { "*": { "*": ["abi", "evm.bytecode.object"] } }
+			}
+		})";
+	};
+	string const main = "import \\\"lib.sol\\\"; contract C { function g(uint a) public pure returns (uint) { return L.f(a); } }";
+	string const editedMain = "import \\\"lib.sol\\\"; contract C { function g(uint a) public pure returns (uint) { return L.f(a) + 1; } }";
+	vector<string> const inputs{
+		input(main, false),
+		input(editedMain, false),
+		input(editedMain, false),
+		input(editedMain, true),
+		input("contract C { function g() public {} }", true),
+		input(main, true)
+	};
+	// Only one compiler stack can exist at a time, so the expectations are computed first.
+	vector<Json::Value> expectations;
+	for (string const& in: inputs)
+	{
+		expectations.emplace_back(compile(in));
+		BOOST_REQUIRE(containsAtMostWarnings(expectations.back()));
+	}
+
+	frontend::StandardCompiler compiler;
+	compiler.enableAnalysisReuse();
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(inputs[i]), result));
+		BOOST_CHECK_MESSAGE(result == expectations[i], "Output of compilation " + to_string(i) + " differs.");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(analysis_reuse_node_ids)
+{
+	auto input = [](string const& _a) {
+		return R"({
+			"language": "Solidity",
+			"sources": {
+				"a.sol": { "content": ")" + _a + R"(" },
+				"b.sol": { "content": "contract B { uint x; function f() public view returns (uint) { return x; } }" }
+			},
+			"settings": { "outputSelection": { "*": { "": ["ast"], "*": ["storageLayout"] } } }
+		})";
+	};
+	// The edited source has more nodes, so the IDs of the nodes of b.sol are shifted in a
+	// compilation from scratch.
+	vector<string> const inputs{
+		input("contract A { uint y; }"),
+		input("contract A { uint y; uint z; function g() public {} }")
+	};
+	vector<Json::Value> expectations;
+	for (string const& in: inputs)
+	{
+		expectations.emplace_back(compile(in));
+		BOOST_REQUIRE(containsAtMostWarnings(expectations.back()));
+	}
+	BOOST_REQUIRE(expectations[0]["sources"]["b.sol"]["ast"]["id"] != expectations[1]["sources"]["b.sol"]["ast"]["id"]);
+
+	frontend::StandardCompiler compiler;
+	compiler.enableAnalysisReuse();
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(inputs[i]), result));
+		BOOST_CHECK_MESSAGE(result == expectations[i], "Output of compilation " + to_string(i) + " differs.");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	namespace fs = boost::filesystem;
+	fs::path const directory = fs::temp_directory_path() / fs::unique_path("solc-cache-test-%%%%-%%%%-%%%%");
+	solidity::ScopeGuard removeDirectory([&]() { fs::remove_all(directory); });
+	auto cache = make_shared<CompilationCache const>(directory);
+	fs::path const entries = cache->entryDirectory();
+	auto entryCount = [&]() { return distance(fs::directory_iterator(entries), fs::directory_iterator()); };
+
+	string const input = R"({
+		"language": "Solidity",
+		"sources": { "A": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings": { "threads": 1, "outputSelection": { "*": { "C": ["evm.bytecode.object"] } } }
+	})";
+	frontend::StandardCompiler compiler(ReadCallback::Callback(), cache);
+	string const output = compiler.compile(input);
+	BOOST_CHECK_EQUAL(entryCount(), 1);
+	BOOST_CHECK_EQUAL(output, frontend::StandardCompiler().compile(input));
+	// The streamed output is stored as it was written.
+	fs::path const entry = fs::directory_iterator(entries)->path();
+	ifstream entryFile(entry.string());
+	BOOST_CHECK_EQUAL(string(istreambuf_iterator<char>(entryFile), istreambuf_iterator<char>()), output);
+	entryFile.close();
+
+	// The entry is also used for inputs that only differ in formatting or in the number of threads.
+	ofstream(entry.string(), ofstream::trunc) << "{\"cached\":true}";
+	string const equivalentInput = boost::replace_all_copy(input, "\"threads\": 1", "\"threads\":  4");
+	BOOST_CHECK_EQUAL(compiler.compile(equivalentInput), "{\"cached\":true}");
+	BOOST_CHECK_EQUAL(entryCount(), 1);
+
+	// Outputs that depend on files provided by the read callback are not stored.
+	frontend::StandardCompiler compilerWithCallback(
+		[](string const&, string const&) { return ReadCallback::Result{true, "contract B {}"}; },
+		cache
+	);
+	string const importingInput = R"({
+		"language": "Solidity",
+		"sources": { "A": { "content": "import \"B\"; contract C is B {}" } },
+		"settings": { "outputSelection": { "*": { "C": ["evm.bytecode.object"] } } }
+	})";
+	BOOST_CHECK(!containsAtMostWarnings(compile(importingInput)));
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compilerWithCallback.compile(importingInput), result));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(entryCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_eviction)
+{
+	namespace fs = boost::filesystem;
+	fs::path const directory = fs::temp_directory_path() / fs::unique_path("solc-cache-test-%%%%-%%%%-%%%%");
+	solidity::ScopeGuard removeDirectory([&]() { fs::remove_all(directory); });
+	CompilationCache cache(directory, 20);
+	fs::path const entries = cache.entryDirectory();
+
+	util::h256 const first = util::keccak256("first");
+	util::h256 const second = util::keccak256("second");
+	util::h256 const third = util::keccak256("third");
+	cache.store(first, "first entry");
+	cache.store(second, "second");
+	BOOST_CHECK(cache.load(first) == string("first entry"));
+	BOOST_CHECK(cache.load(second) == string("second"));
+
+	// Make the first entry the most recently used one.
+	for (fs::directory_iterator it(entries), end; it != end; ++it)
+		fs::last_write_time(it->path(), time(nullptr) - 100);
+	BOOST_CHECK(cache.load(first) == string("first entry"));
+	cache.store(third, "third");
+	BOOST_CHECK(cache.load(first) == string("first entry"));
+	BOOST_CHECK(!cache.load(second).has_value());
+	BOOST_CHECK(cache.load(third) == string("third"));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_size_limit)
+{
+	namespace fs = boost::filesystem;
+	fs::path const directory = fs::temp_directory_path() / fs::unique_path("solc-cache-test-%%%%-%%%%-%%%%");
+	solidity::ScopeGuard removeDirectory([&]() { fs::remove_all(directory); });
+	CompilationCache cache(directory, 100);
+	fs::path const entries = cache.entryDirectory();
+
+	auto totalSize = [&]() {
+		uint64_t size = 0;
+		for (fs::directory_iterator it(entries), end; it != end; ++it)
+			size += fs::file_size(it->path());
+		return size;
+	};
+	for (size_t i = 0; i < 50; ++i)
+	{
+		cache.store(util::keccak256(to_string(i)), string(10, 'a'));
+		BOOST_CHECK(totalSize() <= 100);
+		BOOST_CHECK(cache.load(util::keccak256(to_string(i))) == string(10, 'a'));
+	}
+	// Replacing an entry does not count its old size, so it does not cause evictions.
+	cache.store(util::keccak256("replaced"), string(10, 'b'));
+	auto const entryCount = distance(fs::directory_iterator(entries), fs::directory_iterator());
+	for (size_t i = 0; i < 20; ++i)
+		cache.store(util::keccak256("replaced"), string(10, 'b'));
+	BOOST_CHECK_EQUAL(distance(fs::directory_iterator(entries), fs::directory_iterator()), entryCount);
+	BOOST_CHECK(totalSize() <= 100);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_keeps_other_files)
+{
+	namespace fs = boost::filesystem;
+	fs::path const directory = fs::temp_directory_path() / fs::unique_path("solc-cache-test-%%%%-%%%%-%%%%");
+	solidity::ScopeGuard removeDirectory([&]() { fs::remove_all(directory); });
+	CompilationCache cache(directory, 20);
+	fs::path const entries = cache.entryDirectory();
+
+	// Files that were not written by the cache, even if they look similar, are never removed.
+	vector<fs::path> const otherFiles{
+		directory / "foo.json",
+		entries / "foo.json",
+		entries / (util::keccak256("other").hex() + ".json.bak"),
+		entries / "foo.tmp"
+	};
+	for (fs::path const& path: otherFiles)
+	{
+		ofstream(path.string()) << string(100, 'x');
+		fs::last_write_time(path, time(nullptr) - 2 * 60 * 60);
+	}
+	fs::path const staleTemporary = entries / "0123-4567-89ab-cdef.tmp";
+	ofstream(staleTemporary.string()) << "partial";
+	fs::last_write_time(staleTemporary, time(nullptr) - 2 * 60 * 60);
+
+	for (size_t i = 0; i < 10; ++i)
+		cache.store(util::keccak256(to_string(i)), string(10, 'a'));
+	BOOST_CHECK(cache.load(util::keccak256("9")) == string(10, 'a'));
+	BOOST_CHECK(!cache.load(util::keccak256("0")).has_value());
+	for (fs::path const& path: otherFiles)
+		BOOST_CHECK_MESSAGE(fs::exists(path), path.string() + " was removed.");
+	BOOST_CHECK(!fs::exists(staleTemporary));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -14,11 +14,11 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 1107400
-//   executionCost: 1154
-//   totalCost: 1108554
+//   codeDepositCost: 1100600
+//   executionCost: 1140
+//   totalCost: 1101740
 // external:
-//   a(): 1130
+//   a(): 1122
 //   b(uint256): infinite
 //   f1(uint256): infinite
 //   f2(uint256[],string[],uint16,address): infinite
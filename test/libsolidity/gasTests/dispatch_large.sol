@@ -24,29 +24,29 @@ contract Large {
 }
 // ----
 // creation:
-//   codeDepositCost: 637600
-//   executionCost: 670
-//   totalCost: 638270
+//   codeDepositCost: 629200
+//   executionCost: 664
+//   totalCost: 629864
 // external:
 //   a(): 1051
-//   b(uint256): 2046
-//   f0(uint256): 427
-//   f1(uint256): 41352
-//   f2(uint256): 21293
-//   f3(uint256): 21381
-//   f4(uint256): 21359
-//   f5(uint256): 21337
-//   f6(uint256): 21360
-//   f7(uint256): 21272
-//   f8(uint256): 21272
-//   f9(uint256): 21294
-//   g0(uint256): 313
-//   g1(uint256): 41307
-//   g2(uint256): 21270
-//   g3(uint256): 21358
-//   g4(uint256): 21336
-//   g5(uint256): 21292
-//   g6(uint256): 21315
-//   g7(uint256): 21314
-//   g8(uint256): 21292
-//   g9(uint256): 21249
+//   b(uint256): 2040
+//   f0(uint256): 421
+//   f1(uint256): 41346
+//   f2(uint256): 21287
+//   f3(uint256): 21375
+//   f4(uint256): 21353
+//   f5(uint256): 21331
+//   f6(uint256): 21354
+//   f7(uint256): 21266
+//   f8(uint256): 21266
+//   f9(uint256): 21288
+//   g0(uint256): 307
+//   g1(uint256): 41301
+//   g2(uint256): 21264
+//   g3(uint256): 21352
+//   g4(uint256): 21330
+//   g5(uint256): 21286
+//   g6(uint256): 21309
+//   g7(uint256): 21308
+//   g8(uint256): 21286
+//   g9(uint256): 21243
@@ -11,16 +11,16 @@ contract Medium {
 }
 // ----
 // creation:
-//   codeDepositCost: 253800
+//   codeDepositCost: 250600
 //   executionCost: 294
-//   totalCost: 254094
+//   totalCost: 250894
 // external:
 //   a(): 1028
-//   b(uint256): 2046
-//   f1(uint256): 41263
-//   f2(uint256): 21293
-//   f3(uint256): 21337
-//   g0(uint256): 313
-//   g7(uint256): 21292
-//   g8(uint256): 21270
-//   g9(uint256): 21226
+//   b(uint256): 2040
+//   f1(uint256): 41257
+//   f2(uint256): 21287
+//   f3(uint256): 21331
+//   g0(uint256): 307
+//   g7(uint256): 21286
+//   g8(uint256): 21264
+//   g9(uint256): 21220
@@ -6,11 +6,11 @@ contract Small {
 }
 // ----
 // creation:
-//   codeDepositCost: 85400
+//   codeDepositCost: 84600
 //   executionCost: 135
-//   totalCost: 85535
+//   totalCost: 84735
 // external:
 //   fallback: 129
 //   a(): 983
-//   b(uint256): 2002
-//   f1(uint256): 41263
+//   b(uint256): 1996
+//   f1(uint256): 41257
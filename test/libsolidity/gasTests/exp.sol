@@ -19,11 +19,11 @@ contract C {
 // optimize-yul: false
 // ----
 // creation:
-//   codeDepositCost: 119800
+//   codeDepositCost: 118200
 //   executionCost: 165
-//   totalCost: 119965
+//   totalCost: 118365
 // external:
-//   exp_neg_one(uint256): 2259
+//   exp_neg_one(uint256): 2243
 //   exp_one(uint256): infinite
 //   exp_two(uint256): infinite
 //   exp_zero(uint256): infinite
@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the parallelFor helper.
+ */
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(calls_every_index_once)
+{
+	for (size_t threads: vector<size_t>{0, 1, 2, 8})
+	{
+		vector<atomic<unsigned>> calls(100);
+		parallelFor(calls.size(), threads, [&](size_t _index) { ++calls[_index]; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count.load(), 1u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls)
+{
+	vector<atomic<unsigned>> calls(64);
+	parallelFor(8, 4, [&](size_t _outer) {
+		parallelFor(8, 4, [&](size_t _inner) { ++calls[_outer * 8 + _inner]; });
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(reuses_threads)
+{
+	// Counts the threads that run a job for the first time. Thread IDs could be reused
+	// by the system after a thread has finished, thread-local flags cannot.
+	atomic<size_t> newThreads{0};
+	for (size_t i = 0; i < 100; ++i)
+		parallelFor(16, 4, [&](size_t) {
+			static thread_local bool seen = false;
+			if (!seen)
+			{
+				seen = true;
+				++newThreads;
+			}
+		});
+	BOOST_CHECK(newThreads.load() < 32);
+}
+
+BOOST_AUTO_TEST_CASE(empty_range)
+{
+	parallelFor(0, 4, [](size_t) { BOOST_FAIL("Should not be called."); });
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_smallest_index)
+{
+	for (size_t threads: vector<size_t>{1, 4})
+	{
+		size_t thrownIndex = 0;
+		try
+		{
+			parallelFor(50, threads, [](size_t _index) {
+				if (_index % 10 == 7)
+					throw runtime_error(to_string(_index));
+			});
+		}
+		catch (runtime_error const& _error)
+		{
+			thrownIndex = stoul(_error.what());
+		}
+		BOOST_CHECK_EQUAL(thrownIndex, 7u);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -208,6 +208,33 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unterminated_tags_rendered)
+{
+	string templ = "<#l>x<?c>y<!c>z<?+a><a>";
+	Whiskers m(templ);
+	m("a", "A")("c", true)("l", vector<map<string, string>>{});
+	BOOST_CHECK_EQUAL(m.render(), "<#l>x<?c>y<!c>z<?+a>A");
+}
+
+BOOST_AUTO_TEST_CASE(else_without_end_ignored)
+{
+	string templ = "<?c>a<!c>b</c><!c>c";
+	Whiskers m(templ);
+	m("c", false);
+	BOOST_CHECK_EQUAL(m.render(), "b<!c>c");
+}
+
+BOOST_AUTO_TEST_CASE(template_reused)
+{
+	string templ = "<?c><a><!c>-</c><#l><b></l>";
+	vector<map<string, string>> list(2);
+	list[0]["b"] = "1";
+	list[1]["b"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "X")("c", true)("l", list).render(), "X12");
+	list.pop_back();
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "Y")("c", false)("l", list).render(), "-1");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
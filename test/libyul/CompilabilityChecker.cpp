@@ -155,7 +155,7 @@ BOOST_AUTO_TEST_CASE(multiple_functions)
 			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
 		}
 	})");
-	BOOST_CHECK_EQUAL(out, "h: 9 g: 5 f: 5 ");
+	BOOST_CHECK_EQUAL(out, "h: 9 f: 5 g: 5 ");
 }
 
 BOOST_AUTO_TEST_CASE(nested)
@@ -187,7 +187,7 @@ BOOST_AUTO_TEST_CASE(nested)
 			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
 		}
 	})");
-	BOOST_CHECK_EQUAL(out, "h: 9 g: 5 f: 5 ");
+	BOOST_CHECK_EQUAL(out, "h: 9 f: 5 g: 5 ");
 }
 
 BOOST_AUTO_TEST_CASE(also_in_outer_block)
@@ -216,7 +216,7 @@ BOOST_AUTO_TEST_CASE(also_in_outer_block)
 			function g(s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15, s16, s17, s18, s19) -> w, v {
 			}
 	})");
-	BOOST_CHECK_EQUAL(out, "g: 5 : 9 ");
+	BOOST_CHECK_EQUAL(out, ": 9 g: 5 ");
 }
 
 BOOST_AUTO_TEST_SUITE_END()
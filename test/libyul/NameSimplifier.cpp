@@ -0,0 +1,159 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the name rewrites of the NameSimplifier.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/optimiser/NameSimplifier.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <regex>
+#include <set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// The regular expressions the rewrites of the NameSimplifier were originally defined by.
+vector<pair<regex, string>> const& referenceRewrites()
+{
+	static vector<pair<regex, string>> const rewrites{
+		{regex("_\\$\\d+"), ""},
+		{regex("(abi_..code.*)_to_.*"), "$1"},
+		{regex("(stringliteral_[0-9a-f]{4})[0-9a-f]*"), "$1"},
+		{regex("tuple_t_"), ""},
+		{regex("_memory_ptr"), ""},
+		{regex("_calldata_ptr"), "_calldata"},
+		{regex("_fromStack"), ""},
+		{regex("_storage_storage"), "_storage"},
+		{regex("_memory_memory"), "_memory"},
+		{regex("t_contract\\$_([^_]*)_"), "$1_"},
+		{regex("index_access_t_array"), "index_access"},
+		{regex("[0-9]*_$"), ""}
+	};
+	return rewrites;
+}
+
+/// @returns all identifier-like words of the Yul test corpora.
+set<string> corpusNames()
+{
+	regex const identifier("[a-zA-Z_$][a-zA-Z0-9_$.]*");
+	set<string> names;
+	for (string directory: {"libyul/yulOptimizerTests", "cmdlineTests"})
+		for (
+			auto it = boost::filesystem::recursive_directory_iterator(solidity::test::CommonOptions::get().testPath / directory);
+			it != boost::filesystem::recursive_directory_iterator();
+			++it
+		)
+		{
+			if (!boost::filesystem::is_regular_file(it->path()))
+				continue;
+			string content = util::readFileAsString(it->path().string());
+			for (auto match = sregex_iterator(content.begin(), content.end(), identifier); match != sregex_iterator(); ++match)
+				names.insert(match->str());
+		}
+	return names;
+}
+
+}
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(NameSimplifierTest)
+
+BOOST_AUTO_TEST_CASE(rewrites_match_regular_expressions)
+{
+	auto const& rewrites = NameSimplifier::rewrites();
+	BOOST_REQUIRE_EQUAL(rewrites.size(), referenceRewrites().size());
+
+	set<string> names = corpusNames();
+	BOOST_REQUIRE(names.size() > 1000);
+	names += set<string>{
+		"",
+		"_",
+		"_$",
+		"_$_",
+		"a_$12_$3b",
+		"_$1_$",
+		"abi_code_to_x",
+		"abi_decode_to_",
+		"abi_decode_to",
+		"abi_encode_t_uint256_to_t_uint256_fromStack",
+		"abi_encode_tuple_t_uint256_to_t_uint256__to_t_uint256_",
+		"abi_abi_decode_x_to_y",
+		"xabi_xxcode_to_abi_decode_to_z",
+		"abi_xxcodeabi_decode_to_",
+		"abi_decode_",
+		"abi_deco",
+		"xabi_",
+		"stringliteral_",
+		"stringliteral_abc",
+		"stringliteral_abcdef0123",
+		"stringliteral_abcdeF0123",
+		"stringliteral_stringliteral_0123456",
+		"stringliteral_0123stringliteral_4567ff",
+		"tuple_t_tuple_t_",
+		"tuple_tuple_t_t_",
+		"_memory_memory_memory",
+		"_storage_storage_storage_ptr",
+		"t_contract$_",
+		"t_contract$_C",
+		"t_contract$_C_",
+		"t_contract$_C_$12_t_contract$__x",
+		"t_contract$_t_contract$_C_D_",
+		"index_access_t_array_index_access_t_array",
+		"123_",
+		"x_123_",
+		"x_12_3_",
+		"x__",
+		"x_"
+	};
+
+	for (string const& name: names)
+	{
+		// Feed the result of each step into the next one to also cover inputs that only arise
+		// after earlier rewrites.
+		string current = name;
+		for (size_t step = 0; step < rewrites.size(); ++step)
+		{
+			auto const& [expression, substitute] = referenceRewrites()[step];
+			string expected = regex_replace(current, expression, substitute);
+			string actual = rewrites[step](current);
+			BOOST_CHECK_MESSAGE(
+				actual == expected,
+				"Rewrite " + to_string(step) + " of \"" + current + "\": expected \"" + expected + "\", got \"" + actual + "\""
+			);
+			current = expected;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
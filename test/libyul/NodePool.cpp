@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the memory pool of Yul AST nodes.
+ */
+
+#include <libyul/NodePool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+using SmallNode = array<size_t, 4>;
+using LargeNode = array<size_t, 12>;
+}
+
+BOOST_AUTO_TEST_SUITE(NodePoolTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(releases_free_chunks)
+{
+	NodePool::releaseUnusedMemory();
+	size_t const baseline = NodePool::reservedBytes();
+
+	vector<NodePointer<SmallNode>> smallNodes;
+	vector<NodePointer<LargeNode>> largeNodes;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		smallNodes.emplace_back(makeNode<SmallNode>());
+		largeNodes.emplace_back(makeNode<LargeNode>());
+	}
+	BOOST_CHECK(NodePool::reservedBytes() > baseline);
+
+	// Free half of the nodes on a thread that finishes before the pool is trimmed.
+	thread([&]() {
+		smallNodes.resize(smallNodes.size() / 2);
+		largeNodes.resize(largeNodes.size() / 2);
+	}).join();
+	// Nodes that are still alive keep their chunks.
+	NodePool::releaseUnusedMemory();
+	BOOST_CHECK(NodePool::reservedBytes() > baseline);
+
+	smallNodes.clear();
+	largeNodes.clear();
+	NodePool::releaseUnusedMemory();
+	BOOST_CHECK(NodePool::reservedBytes() <= baseline);
+}
+
+BOOST_AUTO_TEST_CASE(reuses_memory_across_size_classes)
+{
+	NodePool::releaseUnusedMemory();
+	size_t const baseline = NodePool::reservedBytes();
+
+	vector<NodePointer<SmallNode>> smallNodes;
+	for (size_t i = 0; i < 20000; ++i)
+		smallNodes.emplace_back(makeNode<SmallNode>());
+	size_t const peak = NodePool::reservedBytes();
+	smallNodes.clear();
+	NodePool::releaseUnusedMemory();
+
+	// The chunks of the small nodes are reused for nodes of another size.
+	vector<NodePointer<LargeNode>> largeNodes;
+	for (size_t i = 0; i < 6000; ++i)
+		largeNodes.emplace_back(makeNode<LargeNode>());
+	BOOST_CHECK(NodePool::reservedBytes() <= peak);
+	largeNodes.clear();
+	NodePool::releaseUnusedMemory();
+	BOOST_CHECK(NodePool::reservedBytes() <= baseline);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
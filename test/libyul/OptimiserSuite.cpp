@@ -0,0 +1,189 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the optimiser suite.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns the optimised code or nullopt if @a _source is not valid for the EVM version.
+optional<string> tryOptimise(string const& _source, size_t _threads, bool _skipUnchangedFunctions = true)
+{
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.yulOptimiserThreads = _threads;
+	settings.yulOptimiserSkipUnchangedFunctions = _skipUnchangedFunctions;
+	AssemblyStack stack(solidity::test::CommonOptions::get().evmVersion(), AssemblyStack::Language::StrictAssembly, settings);
+	if (!stack.parseAndAnalyze("", _source))
+		return nullopt;
+	stack.optimize();
+	return stack.print();
+}
+
+string optimise(string const& _source, size_t _threads, bool _skipUnchangedFunctions = true)
+{
+	optional<string> result = tryOptimise(_source, _threads, _skipUnchangedFunctions);
+	BOOST_REQUIRE(result);
+	return *result;
+}
+
+/// @returns the names of the top-level statements of @a _source that @a _tracker selects for the next round.
+set<YulString> nextRound(ChangedFunctionTracker& _tracker, string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	return _tracker.nextRound(*ast);
+}
+
+/// Functions that are too large to be inlined and in which the expression splitter and
+/// the SSA transform introduce new variables.
+string largeFunctions()
+{
+	string source = "{\n";
+	for (size_t i = 0; i < 16; ++i)
+	{
+		string const name = "f" + to_string(i);
+		source +=
+			"function " + name + "(a, b) -> r {\n"
+			"	for { let i := 0 } lt(i, a) { i := add(i, 1) } {\n"
+			"		b := add(mul(b, " + to_string(i + 3) + "), calldataload(mul(i, 32)))\n"
+			"		if gt(b, sload(i)) { r := add(r, keccak256(mload(b), and(r, 0xff))) }\n"
+			"		switch mod(b, 3)\n"
+			"		case 0 { sstore(r, b) }\n"
+			"		default { r := xor(r, sload(add(b, r))) }\n"
+			"	}\n"
+			"	mstore(r, add(b, " + (i > 0 ? "f" + to_string(i - 1) + "(b, r)" : "r") + "))\n"
+			"}\n";
+	}
+	source += "sstore(0, f15(calldataload(0), calldataload(32)))\n}\n";
+	return source;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(concurrent_optimisation_output_identical)
+{
+	string const source = largeFunctions();
+	string const sequential = optimise(source, 1);
+	BOOST_CHECK_EQUAL(optimise(source, 4), sequential);
+	BOOST_CHECK_EQUAL(optimise(source, 16), sequential);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_optimisation_full_suite_tests)
+{
+	boost::filesystem::path const directory =
+		solidity::test::CommonOptions::get().testPath / "libyul" / "yulOptimizerTests" / "fullSuite";
+	for (auto const& entry: boost::filesystem::directory_iterator(directory))
+	{
+		string source = util::readFileAsString(entry.path().string());
+		source = source.substr(0, source.find("// ----"));
+		optional<string> const sequential = tryOptimise(source, 1);
+		// Tests for a newer EVM version.
+		if (!sequential)
+			continue;
+		for (size_t threads: vector<size_t>{2, 4, 16})
+			BOOST_CHECK_MESSAGE(
+				tryOptimise(source, threads) == sequential,
+				entry.path().filename().string() + " differs with " + to_string(threads) + " threads."
+			);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_functions_skipped)
+{
+	ChangedFunctionTracker tracker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()));
+	YulString const outermost;
+	YulString const f("f");
+	YulString const g("g");
+	YulString const h("h");
+
+	string const source = "{ f() function f() { sstore(0, g()) } function g() -> r { r := 1 } function h() {} }";
+	BOOST_CHECK(nextRound(tracker, source) == set<YulString>({outermost, f, g, h}));
+	BOOST_CHECK(nextRound(tracker, source).empty());
+	// Only the changed function is optimised again, its callers are not affected.
+	BOOST_CHECK(nextRound(tracker, "{ f() function f() { sstore(0, g()) } function g() -> r { r := 2 } function h() {} }") == set<YulString>{g});
+	BOOST_CHECK(nextRound(tracker, "{ f() function f() { sstore(0, g()) } function g() -> r { r := 2 } function h() {} }").empty());
+}
+
+BOOST_AUTO_TEST_CASE(callers_of_functions_with_changed_side_effects_reactivated)
+{
+	ChangedFunctionTracker tracker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()));
+	YulString const outermost;
+	YulString const f("f");
+	YulString const g("g");
+
+	nextRound(tracker, "{ sstore(0, f()) function f() -> x { x := g() } function g() -> r { r := 1 } function h() {} }");
+	// g reads from storage now, which changes the side effects of f, so that the outermost block,
+	// which calls f, is re-activated although neither it nor f itself changed.
+	BOOST_CHECK(nextRound(tracker, "{ sstore(0, f()) function f() -> x { x := g() } function g() -> r { r := sload(1) } function h() {} }") == set<YulString>({outermost, f, g}));
+}
+
+BOOST_AUTO_TEST_CASE(all_functions_reactivated_if_msize_use_changes)
+{
+	ChangedFunctionTracker tracker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()));
+	set<YulString> const all{YulString{}, YulString("f"), YulString("g"), YulString("h")};
+
+	nextRound(tracker, "{ f() function f() { sstore(0, g()) } function g() -> r { r := 1 } function h() {} }");
+	BOOST_CHECK(nextRound(tracker, "{ f() function f() { sstore(0, g()) } function g() -> r { r := 1 } function h() { pop(msize()) } }") == all);
+	BOOST_CHECK(nextRound(tracker, "{ f() function f() { sstore(0, g()) } function g() -> r { r := 1 } function h() {} }") == all);
+}
+
+BOOST_AUTO_TEST_CASE(skipping_unchanged_functions_output_identical)
+{
+	string const generated = largeFunctions();
+	BOOST_CHECK_EQUAL(optimise(generated, 1), optimise(generated, 1, false));
+
+	boost::filesystem::path const directory =
+		solidity::test::CommonOptions::get().testPath / "libyul" / "yulOptimizerTests" / "fullSuite";
+	for (auto const& entry: boost::filesystem::directory_iterator(directory))
+	{
+		string source = util::readFileAsString(entry.path().string());
+		source = source.substr(0, source.find("// ----"));
+		BOOST_CHECK_MESSAGE(
+			tryOptimise(source, 1) == tryOptimise(source, 1, false),
+			entry.path().filename().string() + " differs when optimising all functions in every round."
+		);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
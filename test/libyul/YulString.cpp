@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(scoped_strings)
+{
+	YulString global{"yulStringTestGlobal"};
+	{
+		YulStringRepository::Scope scope;
+		YulString scoped{"yulStringTestScoped"};
+		YulString lookedUp{"yulStringTestGlobal"};
+		BOOST_CHECK(lookedUp == global);
+		BOOST_CHECK(scoped != global);
+		BOOST_CHECK_EQUAL(scoped.str(), "yulStringTestScoped");
+		BOOST_CHECK_EQUAL(lookedUp.str(), "yulStringTestGlobal");
+		BOOST_CHECK(YulString{} == YulString{""});
+		BOOST_CHECK(YulString{""}.empty());
+	}
+	BOOST_CHECK_EQUAL(global.str(), "yulStringTestGlobal");
+}
+
+BOOST_AUTO_TEST_CASE(access_under_foreign_scope)
+{
+	YulString scoped;
+	{
+		YulStringRepository::Scope scope;
+		scoped = YulString{"yulStringTestForeign"};
+	}
+	// Without a scope.
+	BOOST_CHECK_THROW(scoped.str(), out_of_range);
+	{
+		// A different scope, which assigns the same index to its first string.
+		YulStringRepository::Scope otherScope;
+		YulString other{"yulStringTestOther"};
+		BOOST_CHECK_THROW(scoped.str(), out_of_range);
+		BOOST_CHECK_EQUAL(other.str(), "yulStringTestOther");
+	}
+	// On a thread without a scope.
+	bool threw = false;
+	thread([&]() {
+		try
+		{
+			scoped.str();
+		}
+		catch (out_of_range const&)
+		{
+			threw = true;
+		}
+	}).join();
+	BOOST_CHECK(threw);
+}
+
+BOOST_AUTO_TEST_CASE(string_added_to_global_later)
+{
+	YulStringRepository::Scope scope;
+	YulString scoped{"yulStringTestAddedLater"};
+	YulString global;
+	{
+		YulStringRepository::Scope globalScope{YulStringRepository::global()};
+		global = YulString{"yulStringTestAddedLater"};
+	}
+	BOOST_CHECK(scoped == global);
+	BOOST_CHECK(!(scoped < global));
+	BOOST_CHECK(!(global < scoped));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_insertions)
+{
+	YulStringRepository::Scope scope;
+	YulStringRepository& repository = scope.repository();
+	size_t const threadCount = 4;
+	size_t const stringCount = 1000;
+	vector<vector<YulString>> strings(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			YulStringRepository::Scope threadScope{repository};
+			for (size_t i = 0; i < stringCount; ++i)
+				strings[t].emplace_back("s" + to_string(i));
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (size_t t = 1; t < threadCount; ++t)
+		BOOST_CHECK(strings[t] == strings[0]);
+	for (size_t i = 0; i < stringCount; ++i)
+		BOOST_CHECK_EQUAL(strings[0][i].str(), "s" + to_string(i));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
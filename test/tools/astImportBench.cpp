@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for importing ASTs compared to parsing their sources.
+ */
+
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+string fileName(size_t _index)
+{
+	return "file" + to_string(_index) + ".sol";
+}
+
+/// @returns a source that imports the previous source and contains Solidity and inline assembly code.
+string generateSource(size_t _index, size_t _functions)
+{
+	string source = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n";
+	if (_index > 0)
+		source += "import \"" + fileName(_index - 1) + "\";\n";
+	source += "contract C" + to_string(_index) + " {\n";
+	source += "\tmapping(address => uint[]) entries;\n";
+	source += "\tevent E(address indexed sender, uint value);\n";
+	for (size_t i = 0; i < _functions; ++i)
+		source +=
+			"\tfunction f" + to_string(i) + "(uint a, bytes memory b) public returns (uint r) {\n"
+			"\t\tuint[] storage values = entries[msg.sender];\n"
+			"\t\tfor (uint i = 0; i < a && i < values.length; i++)\n"
+			"\t\t\tr += values[i] * " + to_string(i + 1) + " + uint8(b[i % b.length]);\n"
+			"\t\tassembly { let x := mload(add(b, 0x20)) if gt(x, r) { r := sub(x, r) } }\n"
+			"\t\trequire(r > 0, \"zero\");\n"
+			"\t\temit E(msg.sender, r);\n"
+			"\t}\n";
+	source += "}\n";
+	return source;
+}
+
+double secondsSince(chrono::steady_clock::time_point _start)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(astImportBench, benchmark for importing ASTs.
+Usage: astImportBench [Options] [input files]
+Measures the time until the ASTs of the given or of generated source files are available,
+when parsing the sources, when importing their compact JSON ASTs (including parsing the JSON)
+and when importing their binary AST.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("files", po::value<size_t>()->default_value(200), "Number of generated source files.")
+		("functions", po::value<size_t>()->default_value(10), "Number of functions per generated source file.")
+		("repetitions", po::value<unsigned>()->default_value(10), "Number of repetitions.")
+		("input-file", po::value<vector<string>>(), "Source files to use instead of generated ones.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	unsigned const repetitions = max(arguments["repetitions"].as<unsigned>(), 1u);
+
+	StringMap sources;
+	if (arguments.count("input-file"))
+		for (string const& path: arguments["input-file"].as<vector<string>>())
+			sources[path] = util::readFileAsString(path);
+	else
+		for (size_t i = 0; i < arguments["files"].as<size_t>(); ++i)
+			sources[fileName(i)] = generateSource(i, arguments["functions"].as<size_t>());
+
+	map<string, string> jsonASTs;
+	string binaryAST;
+	size_t sourceBytes = 0;
+	size_t jsonBytes = 0;
+	{
+		CompilerStack compiler;
+		compiler.setSources(sources);
+		if (!compiler.parse())
+		{
+			cerr << "Parsing failed." << endl;
+			return 1;
+		}
+		for (string const& name: compiler.sourceNames())
+		{
+			sourceBytes += compiler.scanner(name).source().size();
+			jsonASTs[name] = util::jsonCompactPrint(
+				ASTJsonConverter(false, compiler.state(), compiler.sourceIndices()).toJson(compiler.ast(name))
+			);
+			jsonBytes += jsonASTs[name].size();
+		}
+		binaryAST = compiler.binaryAST();
+	}
+	cout << sources.size() << " files, " << sourceBytes << " bytes of source, ";
+	cout << jsonBytes << " bytes of JSON AST, " << binaryAST.size() << " bytes of binary AST" << endl;
+
+	// Every variant is measured in a separate loop, so that the memory left behind by one of them
+	// does not influence the measurements of the others.
+	auto measure = [&](auto _import) {
+		double seconds = 0;
+		for (unsigned i = 0; i < repetitions; ++i)
+		{
+			CompilerStack compiler;
+			auto start = chrono::steady_clock::now();
+			_import(compiler);
+			seconds += secondsSince(start);
+		}
+		return seconds;
+	};
+	double parsing = measure([&](CompilerStack& _compiler) {
+		_compiler.setSources(sources);
+		if (!_compiler.parse())
+		{
+			cerr << "Parsing failed." << endl;
+			exit(1);
+		}
+	});
+	double binaryImport = measure([&](CompilerStack& _compiler) {
+		_compiler.importBinaryAST(binaryAST);
+	});
+	double jsonImport = measure([&](CompilerStack& _compiler) {
+		map<string, Json::Value> asts;
+		for (auto const& [name, json]: jsonASTs)
+			util::jsonParseStrict(json, asts[name]);
+		_compiler.importASTs(asts);
+	});
+
+	auto report = [&](string const& _name, double _seconds) {
+		cout << setw(14) << left << _name << setw(10) << right << fixed << setprecision(2) << _seconds * 1000 / repetitions << " ms" << endl;
+	};
+	report("parsing", parsing);
+	report("binary import", binaryImport);
+	report("JSON import", jsonImport);
+
+	return 0;
+}
@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for the common subexpression eliminator and the knowledge propagation of the
+ * control flow graph on randomly generated EVM assembly.
+ */
+
+#include <libevmasm/CommonSubexpressionEliminator.h>
+#include <libevmasm/ControlFlowGraph.h>
+#include <libevmasm/Exceptions.h>
+#include <libevmasm/KnownState.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// @returns @a _blocks basic blocks of random arithmetic, storage and memory operations, which
+/// end in jumps to random other blocks.
+AssemblyItems randomCode(size_t _blocks, size_t _blockSize, unsigned _seed)
+{
+	mt19937 random(_seed);
+	auto below = [&](size_t _bound) { return uniform_int_distribution<size_t>(0, _bound - 1)(random); };
+	vector<Instruction> const binaryOperations{
+		Instruction::ADD, Instruction::MUL, Instruction::SUB, Instruction::DIV, Instruction::AND,
+		Instruction::OR, Instruction::XOR, Instruction::LT, Instruction::GT, Instruction::EQ
+	};
+	vector<Instruction> const unaryOperations{
+		Instruction::ISZERO, Instruction::NOT, Instruction::SLOAD, Instruction::MLOAD, Instruction::CALLDATALOAD
+	};
+
+	AssemblyItems items;
+	for (size_t block = 0; block < _blocks; ++block)
+	{
+		items.emplace_back(Tag, block + 1);
+		size_t height = 0;
+		for (size_t i = 0; i < _blockSize; ++i)
+		{
+			size_t const choice = below(10);
+			if (height < 2 || (choice < 3 && height < 16))
+			{
+				if (below(4) == 0)
+					items.emplace_back(below(2) ? Instruction::CALLER : Instruction::CALLVALUE);
+				else
+					items.emplace_back(u256(below(3) == 0 ? 0x20 * below(8) : below(16)));
+				height++;
+			}
+			else if (choice < 5)
+			{
+				items.emplace_back(dupInstruction(static_cast<unsigned>(1 + below(min<size_t>(height, 16)))));
+				height++;
+			}
+			else if (choice == 5)
+				items.emplace_back(swapInstruction(static_cast<unsigned>(1 + below(min<size_t>(height - 1, 16)))));
+			else if (choice < 8)
+			{
+				items.emplace_back(binaryOperations[below(binaryOperations.size())]);
+				height--;
+			}
+			else if (choice == 8)
+				items.emplace_back(unaryOperations[below(unaryOperations.size())]);
+			else
+			{
+				items.emplace_back(below(2) ? Instruction::SSTORE : Instruction::MSTORE);
+				height -= 2;
+			}
+		}
+		for (; height > 1; height--)
+			items.emplace_back(Instruction::POP);
+		if (height == 0)
+			items.emplace_back(Instruction::CALLVALUE);
+		items.emplace_back(PushTag, below(_blocks) + 1);
+		items.emplace_back(Instruction::JUMPI);
+	}
+	items.emplace_back(Instruction::STOP);
+	return items;
+}
+
+/// Runs the common subexpression eliminator on each analysis block of @a _items, like
+/// Assembly::optimise does.
+/// @returns the number of items after the optimisation.
+size_t eliminateCommonSubexpressions(AssemblyItems const& _items)
+{
+	size_t optimisedSize = 0;
+	for (auto iter = _items.begin(); iter != _items.end();)
+	{
+		KnownState emptyState;
+		CommonSubexpressionEliminator eliminator{emptyState};
+		auto blockEnd = eliminator.feedItems(iter, _items.end(), false);
+		size_t size = static_cast<size_t>(blockEnd - iter);
+		try
+		{
+			size = min(size, eliminator.getOptimizedItems().size());
+		}
+		catch (StackTooDeepException const&)
+		{
+		}
+		catch (ItemNotAvailableException const&)
+		{
+		}
+		optimisedSize += size;
+		iter = blockEnd;
+	}
+	return optimisedSize;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(cseBench, benchmark for the common subexpression eliminator.
+Usage: cseBench [Options]
+Generates random EVM assembly and reports the time needed to run the common subexpression
+eliminator on its blocks and to propagate the knowledge about the state through its control
+flow graph.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("blocks", po::value<size_t>()->default_value(2000), "Number of basic blocks.")
+		("block-size", po::value<size_t>()->default_value(60), "Number of operations in each basic block.")
+		("seed", po::value<unsigned>()->default_value(1), "Seed of the random generator.")
+		("repetitions", po::value<unsigned>()->default_value(5), "Number of passes over the code.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	AssemblyItems const items = randomCode(
+		max<size_t>(arguments["blocks"].as<size_t>(), 1),
+		arguments["block-size"].as<size_t>(),
+		arguments["seed"].as<unsigned>()
+	);
+	unsigned const repetitions = max(arguments["repetitions"].as<unsigned>(), 1u);
+
+	size_t optimisedSize = 0;
+	auto start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < repetitions; ++i)
+		optimisedSize = eliminateCommonSubexpressions(items);
+	chrono::duration<double> cseSeconds = chrono::steady_clock::now() - start;
+
+	size_t blocks = 0;
+	start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < repetitions; ++i)
+		blocks = ControlFlowGraph(items).optimisedBlocks().size();
+	chrono::duration<double> controlFlowSeconds = chrono::steady_clock::now() - start;
+
+	cout << items.size() << " items, " << optimisedSize << " after CSE, " << blocks << " blocks, " << repetitions << " repetitions" << endl;
+	cout << setw(16) << left << "CSE" << setw(10) << right << fixed << setprecision(1) << cseSeconds.count() * 1000 / repetitions << " ms per pass" << endl;
+	cout << setw(16) << left << "control flow" << setw(10) << right << fixed << setprecision(1) << controlFlowSeconds.count() * 1000 / repetitions << " ms per pass" << endl;
+
+	return 0;
+}
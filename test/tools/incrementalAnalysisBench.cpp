@@ -0,0 +1,168 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for the latency from an edit to the diagnostics in a long-lived compiler stack.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+string fileName(size_t _index)
+{
+	return "file" + to_string(_index) + ".sol";
+}
+
+/// @returns a source that imports two of the previous sources and uses their contracts.
+string generateSource(size_t _index, size_t _functions)
+{
+	string source = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n";
+	size_t const first = _index > 0 ? _index - 1 : 0;
+	size_t const second = _index / 2;
+	if (_index > 0)
+		source += "import \"" + fileName(first) + "\";\nimport \"" + fileName(second) + "\";\n";
+	string const name = "C" + to_string(_index);
+	source += "struct S" + to_string(_index) + " { uint a; bytes32 b; }\n";
+	source += "contract " + name + " {\n";
+	if (_index > 0)
+		source += "\tC" + to_string(first) + " first;\n\tC" + to_string(second) + " second;\n";
+	source += "\tmapping(address => S" + to_string(_index) + ") entries;\n";
+	for (size_t i = 0; i < _functions; ++i)
+	{
+		string const call = _index > 0 ? "first.f0(a) + second.f0(a + " + to_string(i) + ")" : to_string(i);
+		source +=
+			"\tfunction f" + to_string(i) + "(uint a) public view returns (uint r) {\n"
+			"\t\tS" + to_string(_index) + " memory s = entries[msg.sender];\n"
+			"\t\tfor (uint i = 0; i < a; i++)\n"
+			"\t\t\tr += s.a * i + uint(keccak256(abi.encode(s.b, i)));\n"
+			"\t\trequire(r > 0, \"zero\");\n"
+			"\t\treturn r + " + call + ";\n"
+			"\t}\n";
+	}
+	source += "}\n";
+	return source;
+}
+
+double secondsSince(chrono::steady_clock::time_point _start)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(incrementalAnalysisBench, benchmark for the incremental re-analysis of updated sources.
+Usage: incrementalAnalysisBench [Options]
+Generates a project of interdependent source files, repeatedly edits the source no other
+source imports and measures the time until the diagnostics are available, both when
+analysing from scratch and when updating the sources of a long-lived compiler stack.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("files", po::value<size_t>()->default_value(200), "Number of source files.")
+		("functions", po::value<size_t>()->default_value(10), "Number of functions per source file.")
+		("repetitions", po::value<unsigned>()->default_value(10), "Number of edits.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	size_t const files = max<size_t>(arguments["files"].as<size_t>(), 1);
+	size_t const functions = arguments["functions"].as<size_t>();
+	unsigned const repetitions = arguments["repetitions"].as<unsigned>();
+
+	StringMap sources;
+	size_t bytes = 0;
+	for (size_t i = 0; i < files; ++i)
+	{
+		sources[fileName(i)] = generateSource(i, functions);
+		bytes += sources[fileName(i)].size();
+	}
+	string const edited = fileName(files - 1);
+	string const original = sources[edited];
+	cout << files << " files, " << bytes << " bytes, " << repetitions << " edits of " << edited << endl;
+
+	CompilerStack compiler;
+	double fromScratch = 0;
+	double incremental = 0;
+	for (unsigned i = 0; i < repetitions; ++i)
+	{
+		sources[edited] = original + "// edit " + to_string(i) + "\n";
+
+		auto start = chrono::steady_clock::now();
+		compiler.reset(true);
+		compiler.setSources(sources);
+		if (!compiler.parseAndAnalyze())
+		{
+			cerr << "Analysis failed." << endl;
+			return 1;
+		}
+		fromScratch += secondsSince(start);
+
+		sources[edited] = original + "// edit " + to_string(i) + "'\n";
+
+		start = chrono::steady_clock::now();
+		compiler.updateSources(sources);
+		if (!compiler.parseAndAnalyze())
+		{
+			cerr << "Analysis failed." << endl;
+			return 1;
+		}
+		incremental += secondsSince(start);
+	}
+
+	auto report = [&](string const& _name, double _seconds) {
+		cout << setw(14) << left << _name << setw(10) << right << fixed << setprecision(2) << _seconds * 1000 / repetitions << " ms/edit" << endl;
+	};
+	report("from scratch", fromScratch);
+	report("incremental", incremental);
+
+	return 0;
+}
@@ -0,0 +1,189 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for the heap allocations and the time needed to parse and optimise Yul code.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/NodePool.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+atomic<size_t> g_allocations{0};
+atomic<size_t> g_allocatedBytes{0};
+
+}
+
+void* operator new(size_t _size)
+{
+	++g_allocations;
+	g_allocatedBytes += _size;
+	if (void* memory = malloc(_size ? _size : 1))
+		return memory;
+	throw bad_alloc();
+}
+
+void operator delete(void* _memory) noexcept
+{
+	free(_memory);
+}
+
+void operator delete(void* _memory, size_t) noexcept
+{
+	free(_memory);
+}
+
+namespace
+{
+
+/// @returns the Yul code of all test files below @a _directory, without the expectations.
+vector<pair<string, string>> testSources(fs::path const& _directory)
+{
+	vector<pair<string, string>> sources;
+	for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_directory))
+		if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".yul")
+		{
+			string source = readFileAsString(entry.path().string());
+			// Only the EVM dialect is optimised here.
+			if (source.find("// dialect:") != string::npos)
+				continue;
+			if (size_t end = source.find("// ----"); end != string::npos)
+				source.resize(end);
+			sources.emplace_back(entry.path().string(), move(source));
+		}
+	sort(sources.begin(), sources.end());
+	return sources;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulAllocationBench, benchmark for the allocations of the Yul optimiser.
+Usage: yulAllocationBench [Options] [input files]
+Parses and optimises the given Yul files or all files of the Yul optimiser test corpus and
+reports the number of heap allocations and the time needed.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("testpath", po::value<string>()->default_value("test"), "Path to the test directory.")
+		("repetitions", po::value<unsigned>()->default_value(3), "Number of passes over the corpus.")
+		("optimise-all-functions", "Optimise all functions in every round of the repeated parts of the optimiser sequence.")
+		("input-file", po::value<vector<string>>(), "Yul files to optimise instead of the test corpus.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<pair<string, string>> sources;
+	if (arguments.count("input-file"))
+		for (string const& path: arguments["input-file"].as<vector<string>>())
+			sources.emplace_back(path, readFileAsString(path));
+	else
+	{
+		fs::path const corpus = fs::path(arguments["testpath"].as<string>()) / "libyul" / "yulOptimizerTests";
+		if (!fs::is_directory(corpus))
+		{
+			cerr << "Directory not found: " << corpus.string() << endl;
+			return 1;
+		}
+		sources = testSources(corpus);
+	}
+	unsigned const repetitions = arguments["repetitions"].as<unsigned>();
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+	settings.yulOptimiserSkipUnchangedFunctions = !arguments.count("optimise-all-functions");
+
+	size_t optimised = 0;
+	size_t const allocationsBefore = g_allocations;
+	size_t const bytesBefore = g_allocatedBytes;
+	auto start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < repetitions; ++i)
+		for (auto const& [name, source]: sources)
+		{
+			AssemblyStack stack(
+				langutil::EVMVersion{},
+				AssemblyStack::Language::StrictAssembly,
+				settings
+			);
+			try
+			{
+				if (!stack.parseAndAnalyze(name, source))
+					continue;
+				stack.optimize();
+				++optimised;
+			}
+			catch (...)
+			{
+				// Some tests deliberately contain code the optimiser cannot handle.
+			}
+		}
+	chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+
+	cout << sources.size() << " files, " << optimised / max(repetitions, 1u) << " optimised, " << repetitions << " repetitions" << endl;
+	cout << setw(16) << left << "allocations" << setw(14) << right << (g_allocations - allocationsBefore) / max(repetitions, 1u) << " per pass" << endl;
+	cout << setw(16) << left << "allocated" << setw(14) << right << (g_allocatedBytes - bytesBefore) / max(repetitions, 1u) / 1024 << " KiB per pass" << endl;
+	cout << setw(16) << left << "node pool" << setw(14) << right << NodePool::reservedBytes() / 1024 << " KiB reserved" << endl;
+	cout << setw(16) << left << "time" << setw(14) << right << fixed << setprecision(1) << seconds.count() * 1000 / max(repetitions, 1u) << " ms per pass" << endl;
+
+	return 0;
+}
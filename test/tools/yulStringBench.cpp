@@ -0,0 +1,173 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Micro-benchmark for hashing and interning of YulStrings.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <cctype>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// The byte-at-a-time FNV-1a hash previously used by the repository, for comparison.
+uint64_t fnvHash(string const& _string)
+{
+	uint64_t hash = YulStringRepository::emptyHash();
+	for (char c: _string)
+	{
+		hash *= 1099511628211u;
+		hash ^= static_cast<uint64_t>(c);
+	}
+	return hash;
+}
+
+vector<string> identifiers(string const& _source)
+{
+	auto isIdentifierStart = [](char c) { return isalpha(static_cast<unsigned char>(c)) || c == '_' || c == '$'; };
+	auto isIdentifierPart = [&](char c) { return isIdentifierStart(c) || isdigit(static_cast<unsigned char>(c)) || c == '.'; };
+
+	vector<string> result;
+	for (size_t i = 0; i < _source.size();)
+		if (isIdentifierStart(_source[i]))
+		{
+			size_t start = i;
+			while (i < _source.size() && isIdentifierPart(_source[i]))
+				++i;
+			result.emplace_back(_source.substr(start, i - start));
+		}
+		else
+			++i;
+	return result;
+}
+
+template <typename F>
+void measure(string const& _name, vector<string> const& _identifiers, size_t _bytes, unsigned _repetitions, F const& _job)
+{
+	auto start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < _repetitions; ++i)
+		_job();
+	chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+	double count = double(_identifiers.size()) * _repetitions;
+	cout <<
+		setw(12) << left << _name <<
+		setw(10) << right << fixed << setprecision(2) << seconds.count() * 1e9 / count << " ns/identifier" <<
+		setw(12) << fixed << setprecision(1) << double(_bytes) * _repetitions / seconds.count() / 1e6 << " MB/s" <<
+		endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulStringBench, micro-benchmark for the YulString repository.
+Usage: yulStringBench [Options] < input
+Extracts all identifiers from the input (e.g. the output of solc --ir) and measures
+the time needed to hash them and to intern them into a fresh repository.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<unsigned>()->default_value(20), "Number of passes over the input.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	string input;
+	if (arguments.count("input-file"))
+		for (string path: arguments["input-file"].as<vector<string>>())
+		{
+			try
+			{
+				input += readFileAsString(path);
+			}
+			catch (FileNotFound const&)
+			{
+				cerr << "File not found: " << path << endl;
+				return 1;
+			}
+		}
+	else
+		input = readStandardInput();
+
+	vector<string> names = identifiers(input);
+	size_t bytes = 0;
+	for (string const& name: names)
+		bytes += name.size();
+	unsigned repetitions = arguments["repetitions"].as<unsigned>();
+	cout << names.size() << " identifiers, " << bytes << " bytes, " << repetitions << " repetitions" << endl;
+
+	// Prevents the compiler from optimising the hashing away.
+	uint64_t checksum = 0;
+	measure("FNV-1a", names, bytes, repetitions, [&]() {
+		for (string const& name: names)
+			checksum ^= fnvHash(name);
+	});
+	measure("hash", names, bytes, repetitions, [&]() {
+		for (string const& name: names)
+			checksum ^= YulStringRepository::hash(name);
+	});
+	measure("intern", names, bytes, repetitions, [&]() {
+		YulStringRepository::Scope scope;
+		for (string const& name: names)
+			checksum ^= YulString{name}.hash();
+	});
+	cout << "(checksum " << checksum << ")" << endl;
+
+	return 0;
+}